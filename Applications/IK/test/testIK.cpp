@@ -23,11 +23,13 @@
 
 
 // INCLUDES
+#include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/Storage.h>
 #include "OpenSim/Common/STOFileAdapter.h"
 #include "OpenSim/Common/TRCFileAdapter.h"
 #include <OpenSim/Common/Reporter.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Simulation/OrientationsReference.h>
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 #include <OpenSim/Tools/InverseKinematicsTool.h>
@@ -42,6 +44,7 @@ void checkMarkersReferenceConsistencyFromTool(InverseKinematicsTool& ik);
 
 void testInverseKinematicsSolverWithOrientations();
 void testInverseKinematicsSolverWithEulerAnglesFromFile();
+void testReferencesFromFilesInTimeRange();
 
 int main()
 {
@@ -65,6 +68,15 @@ int main()
         failures.push_back("testInverseKinematicsSolverWithEulerAnglesFromFile");
     }
 
+    try {
+        ++itc;
+        testReferencesFromFilesInTimeRange();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testReferencesFromFilesInTimeRange");
+    }
+
     try {
         ++itc;
         testMarkerWeightAssignments("subject01_Setup_InverseKinematics.xml");
@@ -489,3 +501,73 @@ void testInverseKinematicsSolverWithEulerAnglesFromFile()
     const TimeSeriesTable standard("std_subject01_walk1_ik.mot");
     compareMotionTables(report, standard);
 }
+
+// The tool reads only the rows of .sto coordinate and marker files that are
+// within its time range (plus some padding). Use files with more rows than
+// are read in a single block.
+void testReferencesFromFilesInTimeRange()
+{
+    Model model;
+    auto* body = new Body("body", 1.0, SimTK::Vec3(0), SimTK::Inertia(1));
+    auto* joint = new PinJoint("joint", model.getGround(), *body);
+    joint->updCoordinate().setName("q");
+    model.addBody(body);
+    model.addJoint(joint);
+    model.addMarker(new Marker("m", *body, SimTK::Vec3(1, 0, 0)));
+    SimTK::State& state = model.initSystem();
+
+    const int numRows = 25000;
+    const auto angle = [](double time) { return 30 * std::sin(time); };
+    TimeSeriesTable coordinates;
+    coordinates.setColumnLabels({"q"});
+    coordinates.addTableMetaData("inDegrees", std::string("yes"));
+    TimeSeriesTableVec3 markers;
+    markers.setColumnLabels({"m"});
+    for (int i = 0; i < numRows; ++i) {
+        const double time = 0.001 * i;
+        coordinates.appendRow(time, {angle(time)});
+        markers.appendRow(time, {SimTK::Vec3(time, 1, 0)});
+    }
+    STOFileAdapter::write(coordinates, "testIK_coordinates.sto");
+    STOFileAdapterVec3::write(markers, "testIK_markers.sto");
+
+    InverseKinematicsTool ik;
+    ik.setModel(model);
+    ik.setCoordinateFileName("testIK_coordinates.sto");
+    ik.setMarkerDataFileName("testIK_markers.sto");
+    ik.setStartTime(12.0005);
+    ik.setEndTime(18.0005);
+    auto* coordTask = new IKCoordinateTask();
+    coordTask->setName("q");
+    coordTask->setValueType(IKCoordinateTask::FromFile);
+    ik.upd_IKTaskSet().adoptAndAppend(coordTask);
+    auto* markerTask = new IKMarkerTask();
+    markerTask->setName("m");
+    ik.upd_IKTaskSet().adoptAndAppend(markerTask);
+
+    MarkersReference markersReference;
+    SimTK::Array_<CoordinateReference> coordinateReferences;
+    ik.populateReferences(markersReference, coordinateReferences);
+
+    // The marker rows within the time range and 30 rows on either side.
+    const auto& markerTable = markersReference.getMarkerTable();
+    ASSERT(markerTable.getNumRows() == 6000 + 2 * 30);
+    ASSERT_EQUAL(11.971, markerTable.getIndependentColumn().front(), 1e-9);
+    ASSERT_EQUAL(18.030, markerTable.getIndependentColumn().back(), 1e-9);
+    for (size_t i = 0; i < markerTable.getNumRows(); ++i) {
+        ASSERT_EQUAL(markerTable.getIndependentColumn()[i],
+                markerTable.getRowAtIndex(i)[0][0], 1e-12);
+    }
+
+    // The coordinate spline matches the one fit to the entire file.
+    for (int i = 0; i < numRows; ++i) {
+        coordinates.updMatrix()(i, 0) *= SimTK_DEGREE_TO_RADIAN;
+    }
+    const GCVSplineSet fullSplines(coordinates);
+    ASSERT(coordinateReferences.size() == 1);
+    for (double time = 12.0; time <= 18.0; time += 0.0137) {
+        state.setTime(time);
+        ASSERT_EQUAL(fullSplines.get("q").calcValue(time),
+                coordinateReferences[0].getValue(state), 1e-8);
+    }
+}
@@ -80,12 +80,16 @@ void ActiveForceLengthCurve::constructProperties()
     constructProperty_max_norm_active_fiber_length(1.8123);
     constructProperty_shallow_ascending_slope(0.8616);
     constructProperty_minimum_value(0.1);
+    constructProperty_use_lookup_table(false);
 }
 
 void ActiveForceLengthCurve::buildCurve()
 {
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
+    if(get_use_lookup_table()) {
+        m_curve.setUseLookupTable(true);
+    }
     delete f;
     setObjectIsUpToDateWithProperties();
 }
@@ -148,6 +152,15 @@ void ActiveForceLengthCurve::setMinValue(double minimumValue)
     ensureCurveUpToDate();
 }
 
+void ActiveForceLengthCurve::setUseLookupTable(bool useLookupTable)
+{
+    set_use_lookup_table(useLookupTable);
+    ensureCurveUpToDate();
+}
+
+bool ActiveForceLengthCurve::getUseLookupTable() const
+{   return get_use_lookup_table(); }
+
 //==============================================================================
 // SERVICES
 //==============================================================================
@@ -127,6 +127,8 @@ public:
         "Slope of the shallow ascending limb");
     OpenSim_DECLARE_PROPERTY(minimum_value, double,
         "Minimum value of the active-force-length curve");
+    OpenSim_DECLARE_PROPERTY(use_lookup_table, bool,
+        "Evaluate the curve using a precomputed lookup table");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -199,6 +201,14 @@ public:
     */
     void setMinValue(double minimumValue);
 
+    /** Evaluate the curve and its first two derivatives by interpolating a
+    precomputed table rather than the exact curve (see
+    SmoothSegmentedFunction::setUseLookupTable()). This sets the
+    use_lookup_table property and rebuilds the curve. */
+    void setUseLookupTable(bool useLookupTable);
+    /** @returns The value of the use_lookup_table property. */
+    bool getUseLookupTable() const;
+
     /** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
@@ -207,7 +217,8 @@ public:
 
     /** Evaluates the active-force-length curve at a normalized fiber length of
     'normFiberLength'. */
-    double calcValue(double normFiberLength) const;
+    using Function::calcValue;
+    double calcValue(double normFiberLength) const override;
 
 
     /** Calculates the derivative of the active-force-length multiplier with
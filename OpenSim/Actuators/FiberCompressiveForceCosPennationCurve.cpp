@@ -82,7 +82,7 @@ void FiberCompressiveForceCosPennationCurve::constructProperties()
     constructProperty_engagement_angle_in_degrees(85);
     constructProperty_stiffness_at_perpendicular();
     constructProperty_curviness();
-
+    constructProperty_use_lookup_table(false);
 }
 
 
@@ -97,6 +97,9 @@ void FiberCompressiveForceCosPennationCurve::buildCurve( bool computeIntegral )
                 getName());       
 
     m_curve = *f; 
+    if(get_use_lookup_table()) {
+        m_curve.setUseLookupTable(true);
+    }
     
     delete f;  
        
@@ -221,6 +224,16 @@ bool FiberCompressiveForceCosPennationCurve::isFittedCurveBeingUsed() const
     return m_isFittedCurveBeingUsed;
 }
 
+void FiberCompressiveForceCosPennationCurve::
+    setUseLookupTable(bool useLookupTable)
+{
+    set_use_lookup_table(useLookupTable);
+    ensureCurveUpToDate();
+}
+
+bool FiberCompressiveForceCosPennationCurve::getUseLookupTable() const
+{   return get_use_lookup_table(); }
+
 //=============================================================================
 // SERVICES
 //=============================================================================
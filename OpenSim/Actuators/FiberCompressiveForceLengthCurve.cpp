@@ -72,6 +72,7 @@ void FiberCompressiveForceLengthCurve::constructProperties()
     constructProperty_norm_length_at_zero_force(0.5);
     constructProperty_stiffness_at_zero_length();
     constructProperty_curviness();
+    constructProperty_use_lookup_table(false);
 }
 
 
@@ -86,6 +87,9 @@ void FiberCompressiveForceLengthCurve::buildCurve( bool computeIntegral )
                 getName());            
     
     m_curve = *f;  
+    if(get_use_lookup_table()) {
+        m_curve.setUseLookupTable(true);
+    }
 
     delete f; 
 
@@ -212,6 +216,15 @@ void FiberCompressiveForceLengthCurve::
 }
 
 
+void FiberCompressiveForceLengthCurve::setUseLookupTable(bool useLookupTable)
+{
+    set_use_lookup_table(useLookupTable);
+    ensureCurveUpToDate();
+}
+
+bool FiberCompressiveForceLengthCurve::getUseLookupTable() const
+{   return get_use_lookup_table(); }
+
 //=============================================================================
 // SERVICES
 //=============================================================================
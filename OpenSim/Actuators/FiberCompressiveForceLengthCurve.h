@@ -70,6 +70,8 @@ public:
         "Fiber stiffness at zero length");
     OpenSim_DECLARE_OPTIONAL_PROPERTY(curviness, double, 
         "Fiber curve bend, from linear to maximum bend (0-1)");
+    OpenSim_DECLARE_PROPERTY(use_lookup_table, bool,
+        "Evaluate the curve using a precomputed lookup table");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -229,9 +231,18 @@ public:
     \endverbatim
 
     */
-    double calcValue(double aNormLength) const;
+    using Function::calcValue;
+    double calcValue(double aNormLength) const override;
 
  
+    /** Evaluate the curve and its first two derivatives by interpolating a
+    precomputed table rather than the exact curve (see
+    SmoothSegmentedFunction::setUseLookupTable()). This sets the
+    use_lookup_table property and rebuilds the curve. */
+    void setUseLookupTable(bool useLookupTable);
+    /** @returns The value of the use_lookup_table property. */
+    bool getUseLookupTable() const;
+
     /** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
@@ -77,6 +77,7 @@ void FiberForceLengthCurve::constructProperties()
     constructProperty_stiffness_at_low_force();
     constructProperty_stiffness_at_one_norm_force();
     constructProperty_curviness();
+    constructProperty_use_lookup_table(false);
 }
 
 void FiberForceLengthCurve::buildCurve(bool computeIntegral)
@@ -92,6 +93,9 @@ void FiberForceLengthCurve::buildCurve(bool computeIntegral)
             getName());
 
     m_curve = *f;
+    if(get_use_lookup_table()) {
+        m_curve.setUseLookupTable(true);
+    }
     delete f;
 
     setObjectIsUpToDateWithProperties();
@@ -209,6 +213,15 @@ void FiberForceLengthCurve::setOptionalProperties(double aStiffnessAtLowForce,
     ensureCurveUpToDate();
 }
 
+void FiberForceLengthCurve::setUseLookupTable(bool useLookupTable)
+{
+    set_use_lookup_table(useLookupTable);
+    ensureCurveUpToDate();
+}
+
+bool FiberForceLengthCurve::getUseLookupTable() const
+{   return get_use_lookup_table(); }
+
 //==============================================================================
 // SERVICES
 //==============================================================================
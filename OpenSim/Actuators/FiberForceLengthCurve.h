@@ -172,6 +172,8 @@ public:
         "Fiber stiffness at a tension of 1 normalized force");
     OpenSim_DECLARE_OPTIONAL_PROPERTY(curviness, double,
         "Fiber curve bend, from linear (0) to maximum bend (1)");
+    OpenSim_DECLARE_PROPERTY(use_lookup_table, bool,
+        "Evaluate the curve using a precomputed lookup table");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -269,6 +271,14 @@ public:
                                double stiffnessAtOneNormForce,
                                double curviness);
 
+    /** Evaluate the curve and its first two derivatives by interpolating a
+    precomputed table rather than the exact curve (see
+    SmoothSegmentedFunction::setUseLookupTable()). This sets the
+    use_lookup_table property and rebuilds the curve. */
+    void setUseLookupTable(bool useLookupTable);
+    /** @returns The value of the use_lookup_table property. */
+    bool getUseLookupTable() const;
+
     /** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
@@ -277,7 +287,8 @@ public:
 
     /** Evaluates the fiber-force-length curve at a normalized fiber length of
     'normFiberLength'. */
-    double calcValue(double normFiberLength) const;
+    using Function::calcValue;
+    double calcValue(double normFiberLength) const override;
 
     /** Calculates the derivative of the fiber-force-length multiplier with
     respect to the normalized fiber length.
@@ -82,12 +82,16 @@ void ForceVelocityCurve::constructProperties()
     constructProperty_max_eccentric_velocity_force_multiplier(1.4);
     constructProperty_concentric_curviness(0.6);
     constructProperty_eccentric_curviness(0.9);
+    constructProperty_use_lookup_table(false);
 }
 
 void ForceVelocityCurve::buildCurve()
 {
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
+    if(get_use_lookup_table()) {
+        m_curve.setUseLookupTable(true);
+    }
     delete f;
     setObjectIsUpToDateWithProperties();
 }
@@ -166,6 +170,15 @@ void ForceVelocityCurve::setEccentricCurviness(double aEccentricCurviness)
     ensureCurveUpToDate();
 }
 
+void ForceVelocityCurve::setUseLookupTable(bool useLookupTable)
+{
+    set_use_lookup_table(useLookupTable);
+    ensureCurveUpToDate();
+}
+
+bool ForceVelocityCurve::getUseLookupTable() const
+{   return get_use_lookup_table(); }
+
 //==============================================================================
 // SERVICES
 //==============================================================================
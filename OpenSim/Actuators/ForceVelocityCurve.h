@@ -158,6 +158,8 @@ public:
         "Concentric curve shape, from linear (0) to maximal curve (1)");
     OpenSim_DECLARE_PROPERTY(eccentric_curviness, double,
         "Eccentric curve shape, from linear (0) to maximal curve (1)");
+    OpenSim_DECLARE_PROPERTY(use_lookup_table, bool,
+        "Evaluate the curve using a precomputed lookup table");
 
 //==============================================================================
 // PUBLIC METHODS
@@ -295,6 +297,14 @@ public:
     */
     void setEccentricCurviness(double aEccentricCurviness);
 
+    /** Evaluate the curve and its first two derivatives by interpolating a
+    precomputed table rather than the exact curve (see
+    SmoothSegmentedFunction::setUseLookupTable()). This sets the
+    use_lookup_table property and rebuilds the curve. */
+    void setUseLookupTable(bool useLookupTable);
+    /** @returns The value of the use_lookup_table property. */
+    bool getUseLookupTable() const;
+
     /** Implement the generic OpenSim::Function interface **/
     double calcValue(const SimTK::Vector& x) const override
     {
@@ -303,7 +313,8 @@ public:
 
     /** Evaluates the force-velocity curve at a normalized fiber velocity of
     'normFiberVelocity'. */
-    double calcValue(double normFiberVelocity) const;
+    using Function::calcValue;
+    double calcValue(double normFiberVelocity) const override;
 
     /** Calculates the derivative of the force-velocity multiplier with respect
     to the normalized fiber velocity.
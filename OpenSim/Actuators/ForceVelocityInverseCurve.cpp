@@ -83,12 +83,16 @@ void ForceVelocityInverseCurve::constructProperties()
     constructProperty_max_eccentric_velocity_force_multiplier(1.4);
     constructProperty_concentric_curviness(0.6);
     constructProperty_eccentric_curviness(0.9);
+    constructProperty_use_lookup_table(false);
 }
 
 void ForceVelocityInverseCurve::buildCurve()
 {
     SimTK::Function* f = createSimTKFunction();
     m_curve = *(static_cast<SmoothSegmentedFunction*>(f));
+    if(get_use_lookup_table()) {
+        m_curve.setUseLookupTable(true);
+    }
     delete f;
     setObjectIsUpToDateWithProperties();
 }
@@ -168,6 +172,15 @@ setEccentricCurviness(double aEccentricCurviness)
     ensureCurveUpToDate();
 }
 
+void ForceVelocityInverseCurve::setUseLookupTable(bool useLookupTable)
+{
+    set_use_lookup_table(useLookupTable);
+    ensureCurveUpToDate();
+}
+
+bool ForceVelocityInverseCurve::getUseLookupTable() const
+{   return get_use_lookup_table(); }
+
 //==============================================================================
 // SERVICES
 //==============================================================================
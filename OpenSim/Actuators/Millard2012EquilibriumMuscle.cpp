@@ -535,6 +535,13 @@ computeActuation(const SimTK::State& s) const
 
 void Millard2012EquilibriumMuscle::
 computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
+{
+    computeFiberEquilibrium(s, solveForVelocity, SimTK::NaN);
+}
+
+void Millard2012EquilibriumMuscle::
+computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity,
+                        double initialFiberLength) const
 {
     if(get_ignore_tendon_compliance()) {                    // rigid tendon
         return;
@@ -560,7 +567,15 @@ computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity) const
         std::pair<StatusFromEstimateMuscleFiberState,
                   ValuesFromEstimateMuscleFiberState> result =
             estimateMuscleFiberState(activation, pathLength, pathSpeed,
-                tol, maxIter, solveForVelocity);
+                tol, maxIter, solveForVelocity, initialFiberLength);
+
+        // A poor initial guess can fail to converge where the default
+        // initial guess succeeds.
+        if (!SimTK::isNaN(initialFiberLength) && result.first ==
+                StatusFromEstimateMuscleFiberState::Failure_MaxIterationsReached) {
+            result = estimateMuscleFiberState(activation, pathLength,
+                pathSpeed, tol, maxIter, solveForVelocity);
+        }
 
         switch(result.first) {
 
@@ -1364,7 +1379,8 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
                                     const double pathLengtheningSpeed,
                                     const double aSolTolerance,
                                     const int aMaxIterations,
-                                    bool staticSolution) const
+                                    bool staticSolution,
+                                    double initialFiberLength) const
 {
     // If seeking a static solution, set velocities to zero and avoid the
     // velocity-sharing algorithm below, as it can produce nonzero fiber and
@@ -1393,7 +1409,9 @@ Millard2012EquilibriumMuscle::estimateMuscleFiberState(
 
     // Position level
     double tl  = getTendonSlackLength()*1.01;  // begin with small tendon force
-    double lce = clampFiberLength(getPennationModel().calcFiberLength(ml,tl));
+    double lce = SimTK::isNaN(initialFiberLength)
+        ? clampFiberLength(getPennationModel().calcFiberLength(ml,tl))
+        : clampFiberLength(initialFiberLength);
 
     double phi = 0.0;
     double cosphi = 1.0;
@@ -442,6 +442,23 @@ public:
     void computeFiberEquilibrium(SimTK::State& s, 
                                  bool solveForVelocity = false) const;
 
+    /** Same as computeFiberEquilibrium(SimTK::State&, bool), but the Newton
+        iterations start from the provided fiber length rather than from a
+        fiber length computed assuming a slightly stretched tendon. When
+        processing a trajectory, the solution from the previous frame is
+        usually a much better initial guess and reduces the number of
+        iterations. If the iterations do not converge from the initial guess,
+        the solve is repeated with the default initial guess.
+        @param[in,out] s              The state of the system.
+        @param solveForVelocity       See computeFiberEquilibrium().
+        @param initialFiberLength     The initial guess for the fiber length
+                                      (m). If NaN, the default initial guess
+                                      is used.
+        @throws MuscleCannotEquilibrate
+    */
+    void computeFiberEquilibrium(SimTK::State& s, bool solveForVelocity,
+                                 double initialFiberLength) const;
+
 //==============================================================================
 // DEPRECATED
 //==============================================================================
@@ -759,6 +776,9 @@ private:
            give up attempting to initialize the model
     @param staticSolution set to true to calculate the static equilibrium
            solution, setting fiber and tendon velocities to zero
+    @param initialFiberLength the fiber length at which to start the Newton
+           iterations; if NaN, the iterations start from the fiber length
+           corresponding to a tendon stretched to 1.01 times its slack length
     */
     std::pair<StatusFromEstimateMuscleFiberState,
               ValuesFromEstimateMuscleFiberState>
@@ -767,7 +787,8 @@ private:
                                  const double pathLengtheningSpeed,
                                  const double aSolTolerance,
                                  const int aMaxIterations,
-                                 bool staticSolution=false) const;
+                                 bool staticSolution=false,
+                                 double initialFiberLength=SimTK::NaN) const;
 
 };
 } //end of namespace OpenSim
@@ -0,0 +1,78 @@
+/* -------------------------------------------------------------------------- *
+ *                 OpenSim:  MuscleEquilibriumSolver.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MuscleEquilibriumSolver.h"
+
+using namespace OpenSim;
+
+MuscleEquilibriumSolver::MuscleEquilibriumSolver(const Model& model)
+        : m_model(&model) {
+    for (const auto& muscle : model.getComponentList<Muscle>()) {
+        Entry entry;
+        entry.muscle.reset(&muscle);
+        const auto* millard =
+                dynamic_cast<const Millard2012EquilibriumMuscle*>(&muscle);
+        if (millard && !millard->get_ignore_tendon_compliance()) {
+            entry.millard.reset(millard);
+            entry.fiberLength = millard->getStateVariableHandle("fiber_length");
+        }
+        m_entries.push_back(std::move(entry));
+    }
+}
+
+void MuscleEquilibriumSolver::solve(SimTK::State& state) {
+    m_model->getMultibodySystem().realize(state, SimTK::Stage::Velocity);
+
+    bool failed = false;
+    std::string errorMsg;
+
+    for (auto& entry : m_entries) {
+        if (!entry.muscle->appliesForce(state)) continue;
+        try {
+            if (entry.millard) {
+                entry.millard->computeFiberEquilibrium(state, false,
+                        m_useWarmStart ? entry.previousFiberLength
+                                       : SimTK::NaN);
+                entry.previousFiberLength = entry.millard->getStateVariableValue(
+                        state, entry.fiberLength);
+            } else {
+                entry.muscle->computeEquilibrium(state);
+            }
+        } catch (const std::exception& e) {
+            if (!failed) {
+                errorMsg = e.what();
+                failed = true;
+            }
+            // Do not warm-start from a failed solve.
+            entry.previousFiberLength = SimTK::NaN;
+            // Continue with the remaining muscles, as in
+            // Model::equilibrateMuscles().
+        }
+    }
+
+    OPENSIM_THROW_IF(failed, Exception,
+            "MuscleEquilibriumSolver::solve() " + errorMsg);
+}
+
+void MuscleEquilibriumSolver::clearInitialGuesses() {
+    for (auto& entry : m_entries) entry.previousFiberLength = SimTK::NaN;
+}
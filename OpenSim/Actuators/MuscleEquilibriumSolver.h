@@ -0,0 +1,83 @@
+#ifndef OPENSIM_MUSCLEEQUILIBRIUMSOLVER_H
+#define OPENSIM_MUSCLEEQUILIBRIUMSOLVER_H
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  MuscleEquilibriumSolver.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Actuators/Millard2012EquilibriumMuscle.h>
+
+namespace OpenSim {
+
+/** This class equilibrates all muscles in a model, like
+Model::equilibrateMuscles(), but is intended for processing many states of a
+trajectory (e.g., in AnalyzeTool).
+
+- The muscles of the model are collected once, upon construction, rather than
+  for each state.
+- For Millard2012EquilibriumMuscle%s with tendon compliance, the Newton
+  iterations are warm-started from the fiber length solved for the previous
+  state passed to solve(). The states of a trajectory change little from one
+  frame to the next, so this typically reduces the number of iterations
+  substantially. If the warm-started solve does not converge, the muscle
+  falls back to its default initial guess.
+- Other muscles use Muscle::computeEquilibrium().
+
+Construct the solver after calling initSystem() on the model, and do not
+modify the model's muscles while using the solver. Call clearInitialGuesses()
+when switching to an unrelated trajectory. */
+class OSIMACTUATORS_API MuscleEquilibriumSolver {
+public:
+    explicit MuscleEquilibriumSolver(const Model& model);
+
+    /** Update the state of all muscles that apply force so they are in
+    equilibrium.
+    @throws Exception if any muscle failed to equilibrate; the remaining
+            muscles are still equilibrated (same as
+            Model::equilibrateMuscles()). */
+    void solve(SimTK::State& state);
+
+    /** Forget the solutions from previous calls to solve(), so that the next
+    call uses each muscle's default initial guess. */
+    void clearInitialGuesses();
+
+    /** Warm-starting is enabled by default. If disabled, solve() behaves
+    like Model::equilibrateMuscles(). */
+    void setUseWarmStart(bool tf) { m_useWarmStart = tf; }
+    bool getUseWarmStart() const { return m_useWarmStart; }
+
+private:
+    struct Entry {
+        SimTK::ReferencePtr<const Muscle> muscle;
+        // Null if the muscle is not a Millard2012EquilibriumMuscle with
+        // tendon compliance.
+        SimTK::ReferencePtr<const Millard2012EquilibriumMuscle> millard;
+        Component::StateVariableHandle fiberLength;
+        double previousFiberLength = SimTK::NaN;
+    };
+
+    SimTK::ReferencePtr<const Model> m_model;
+    std::vector<Entry> m_entries;
+    bool m_useWarmStart = true;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MUSCLEEQUILIBRIUMSOLVER_H
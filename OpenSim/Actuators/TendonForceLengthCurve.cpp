@@ -88,6 +88,7 @@ void TendonForceLengthCurve::constructProperties()
     constructProperty_stiffness_at_one_norm_force();
     constructProperty_norm_force_at_toe_end();
     constructProperty_curviness();
+    constructProperty_use_lookup_table(false);
 }
 
 void TendonForceLengthCurve::buildCurve(bool computeIntegral)
@@ -100,6 +101,9 @@ void TendonForceLengthCurve::buildCurve(bool computeIntegral)
                                      computeIntegral,
                                      getName());
     m_curve = *f;
+    if(get_use_lookup_table()) {
+        m_curve.setUseLookupTable(true);
+    }
     delete f;
     setObjectIsUpToDateWithProperties();
 }
@@ -213,6 +217,15 @@ SimTK::Function* TendonForceLengthCurve::createSimTKFunction() const
                 getName());
 }
 
+void TendonForceLengthCurve::setUseLookupTable(bool useLookupTable)
+{
+    set_use_lookup_table(useLookupTable);
+    ensureCurveUpToDate();
+}
+
+bool TendonForceLengthCurve::getUseLookupTable() const
+{   return get_use_lookup_table(); }
+
 //==============================================================================
 // SERVICES
 //==============================================================================
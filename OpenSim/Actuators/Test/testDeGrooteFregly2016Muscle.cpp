@@ -24,6 +24,7 @@
 #include <OpenSim/Actuators/DeGrooteFregly2016Muscle.h>
 #include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Common/Stopwatch.h>
 #include <OpenSim/Moco/osimMoco.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
@@ -1085,3 +1086,38 @@ TEST_CASE("DeGrooteFregly2016Muscle basics") {
         CHECK(state.getY()[2] == Approx(0.451));
     }
 }
+
+TEST_CASE("State copy benchmark with muscle info extras", "[.][benchmark]") {
+    // The muscles' info structs are cached in the State, and each muscle
+    // fills 5 dynamics extras; copying the State copies them.
+    Model model;
+    auto* body = new Body("body", 1.0, SimTK::Vec3(0), SimTK::Inertia(1));
+    model.addBody(body);
+    auto* joint = new SliderJoint("joint", model.getGround(), *body);
+    model.addJoint(joint);
+    const int numMuscles = 50;
+    for (int i = 0; i < numMuscles; ++i) {
+        auto* muscle = new DeGrooteFregly2016Muscle();
+        muscle->setName("muscle" + std::to_string(i));
+        muscle->set_optimal_fiber_length(0.1);
+        muscle->set_tendon_slack_length(0.2);
+        muscle->addNewPathPoint("origin", model.updGround(),
+                SimTK::Vec3(0, 0.01 * i, 0));
+        muscle->addNewPathPoint("insertion", *body, SimTK::Vec3(0));
+        model.addForce(muscle);
+    }
+    SimTK::State state = model.initSystem();
+    model.getCoordinateSet()[0].setValue(state, 0.3);
+    model.realizeDynamics(state);
+
+    const int numCopies = 1000;
+    Stopwatch watch;
+    for (int i = 0; i < numCopies; ++i) {
+        SimTK::State copy(state);
+        CHECK(copy.getNY() == state.getNY());
+    }
+    const auto elapsed = watch.getElapsedTimeInNs();
+    std::cout << "Copying a State with " << numMuscles << " muscles: "
+              << Stopwatch::formatNs(elapsed / numCopies) << " per copy."
+              << std::endl;
+}
@@ -45,9 +45,24 @@
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Auxiliary/auxiliaryTestMuscleFunctions.h>
 
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
 using namespace OpenSim;
 using namespace std;
 
+// Count the calls to the global operator new so that testMuscleInfoExtras()
+// can check which copies of the muscle info structs allocate memory.
+static std::atomic<long> numAllocations(0);
+void* operator new(std::size_t size) {
+    ++numAllocations;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
 //==============================================================================
 static const double IntegrationAccuracy         = 1e-5;
 static const double SimulationTestTolerance     = 1e-4;
@@ -100,6 +115,8 @@ void testMillard2012AccelerationMuscle();
 void testDeGrooteFregly2016Muscle();
 void testSchutte1993Muscle();
 void testDelp1990Muscle();
+void testMuscleInfoExtras();
+void testMuscleEquilibriumSolver();
 
 void testMuscleEquilibriumSolve(const Model& model, const Storage& statesStore);
 
@@ -152,6 +169,20 @@ int main()
         failures.push_back("testDeGrooteFregly2016Muscle");
     }
 
+    try { testMuscleEquilibriumSolver();
+        cout << "MuscleEquilibriumSolver Test passed" << endl;
+    } catch (const Exception& e) {
+        e.print(cout);
+        failures.push_back("testMuscleEquilibriumSolver");
+    }
+
+    try { testMuscleInfoExtras();
+        cout << "Muscle::InfoExtras Test passed" << endl;
+    } catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testMuscleInfoExtras");
+    }
+
     printf("\n\n");
     cout <<"************************************************************"<<endl;
     cout <<"************************************************************"<<endl;
@@ -1066,6 +1097,139 @@ void testDelp1990Muscle()
 
 
 
+void testMuscleEquilibriumSolver()
+{
+    // Muscles with different tendon slack lengths, including one with a rigid
+    // tendon.
+    Model model;
+    auto* body = new Body("body", 1.0, SimTK::Vec3(0), SimTK::Inertia(1));
+    model.addBody(body);
+    auto* joint = new SliderJoint("joint", model.getGround(), *body);
+    model.addJoint(joint);
+    for (int i = 0; i < 3; ++i) {
+        auto* muscle = new Millard2012EquilibriumMuscle(
+                "muscle" + std::to_string(i), MaxIsometricForce0,
+                OptimalFiberLength0, (1.0 + 0.2 * i) * TendonSlackLength0,
+                PennationAngle0);
+        muscle->set_ignore_tendon_compliance(i == 2);
+        muscle->addNewPathPoint("origin", model.updGround(), SimTK::Vec3(0));
+        muscle->addNewPathPoint("insertion", *body, SimTK::Vec3(0));
+        model.addForce(muscle);
+    }
+    SimTK::State state = model.initSystem();
+    SimTK::State stateExpected = state;
+    const auto& coord = model.getCoordinateSet()[0];
+    const auto& muscles = model.getMuscles();
+
+    MuscleEquilibriumSolver solver(model);
+    for (int frame = 0; frame < 20; ++frame) {
+        const double length = 1.1 * OptimalFiberLength0 + TendonSlackLength0 +
+                0.02 * OptimalFiberLength0 * frame;
+        for (auto* s : {&state, &stateExpected}) {
+            coord.setValue(*s, length);
+            for (int i = 0; i < muscles.getSize(); ++i) {
+                muscles[i].setActivation(*s, 0.1 + 0.04 * frame);
+            }
+        }
+        solver.solve(state);
+        model.equilibrateMuscles(stateExpected);
+        model.realizeVelocity(state);
+        model.realizeVelocity(stateExpected);
+        for (int i = 0; i < muscles.getSize(); ++i) {
+            ASSERT_EQUAL(muscles[i].getFiberLength(stateExpected),
+                    muscles[i].getFiberLength(state),
+                    1e-6 * OptimalFiberLength0);
+        }
+    }
+}
+
+// Exposes the muscle info structs, which are protected, to the test.
+class MuscleInfoStructs : public Muscle {
+public:
+    using Muscle::MuscleLengthInfo;
+    using Muscle::FiberVelocityInfo;
+    using Muscle::MuscleDynamicsInfo;
+    using Muscle::MusclePotentialEnergyInfo;
+};
+
+long countCloneAllocations(const SimTK::AbstractValue& value)
+{
+    const long before = numAllocations;
+    std::unique_ptr<SimTK::AbstractValue> clone(value.clone());
+    return numAllocations - before;
+}
+
+template <typename InfoType>
+void checkInfoCloneAllocations(Muscle::InfoExtras InfoType::* extras,
+        long valueAllocations)
+{
+    InfoType info;
+    (info.*extras).resize(Muscle::InfoExtras::InlineCapacity);
+    ASSERT(countCloneAllocations(SimTK::Value<InfoType>(info)) ==
+            valueAllocations);
+    // Extras that do not fit inline are allocated when they are copied.
+    (info.*extras).resize(Muscle::InfoExtras::InlineCapacity + 1);
+    ASSERT(countCloneAllocations(SimTK::Value<InfoType>(info)) >
+            valueAllocations);
+}
+
+void testMuscleInfoExtras()
+{
+    Muscle::InfoExtras extras;
+    ASSERT(extras.size() == 0);
+
+    extras.resize(3);
+    ASSERT(extras.size() == 3);
+    ASSERT(SimTK::isNaN(extras[2]));
+    extras[0] = 1.5;
+    extras(1) = -2.0;
+    ASSERT(extras[0] == 1.5);
+    ASSERT(extras[1] == -2.0);
+
+    SimTK::Vector values(2);
+    values[0] = 3.0;
+    values[1] = 4.0;
+    extras = values;
+    ASSERT(extras.size() == 2);
+    ASSERT(extras[1] == 4.0);
+    // Growing the extras again does not expose stale values.
+    extras.resize(3);
+    ASSERT(SimTK::isNaN(extras[2]));
+
+    ASSERT_THROW(SimTK::Exception::Base, extras.resize(-1));
+
+    // More extras than fit inline are stored on the heap.
+    const int numExtras = Muscle::InfoExtras::InlineCapacity + 4;
+    extras.resize(numExtras);
+    ASSERT(extras.size() == numExtras);
+    ASSERT(extras[1] == 4.0);
+    ASSERT(SimTK::isNaN(extras[numExtras - 1]));
+    for (int i = 0; i < numExtras; ++i) extras[i] = i;
+    const Muscle::InfoExtras copy(extras);
+    ASSERT(copy.size() == numExtras);
+    ASSERT(copy[numExtras - 1] == numExtras - 1);
+    extras.resize(2);
+    ASSERT(extras[1] == 1.0);
+    extras.resize(3);
+    ASSERT(SimTK::isNaN(extras[2]));
+    const Muscle::InfoExtras filled(numExtras, 0.5);
+    ASSERT(filled[numExtras - 1] == 0.5);
+
+    // Simbody copies a State's cache entries by cloning their
+    // SimTK::Value<T>. Cloning the muscle info structs allocates nothing but
+    // the Value itself as long as the extras fit inline.
+    const long valueAllocations =
+            countCloneAllocations(SimTK::Value<double>(0));
+    checkInfoCloneAllocations(&MuscleInfoStructs::MuscleLengthInfo::
+            userDefinedLengthExtras, valueAllocations);
+    checkInfoCloneAllocations(&MuscleInfoStructs::FiberVelocityInfo::
+            userDefinedVelocityExtras, valueAllocations);
+    checkInfoCloneAllocations(&MuscleInfoStructs::MuscleDynamicsInfo::
+            userDefinedDynamicsExtras, valueAllocations);
+    checkInfoCloneAllocations(&MuscleInfoStructs::MusclePotentialEnergyInfo::
+            userDefinedPotentialEnergyExtras, valueAllocations);
+}
+
 void testMuscleEquilibriumSolve(const Model& model, const Storage& statesStore)
 {
     // Get the muscle to test
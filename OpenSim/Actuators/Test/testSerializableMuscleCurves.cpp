@@ -30,7 +30,9 @@
 #include <OpenSim/Actuators/FiberCompressiveForceCosPennationCurve.h>
 
 #include <SimTKsimbody.h>
+#include <cmath>
 #include <ctime>
+#include <memory>
 #include <string>
 #include <stdio.h>
 
@@ -45,6 +47,7 @@ void testTendonForceLengthCurve();
 void testFiberForceLengthCurve();
 void testFiberCompressiveForceLengthCurve();
 void testFiberCompressiveForceCosPennationCurve();
+template <typename CurveType> void testLookupTable(CurveType curve);
 
 int main(int argc, char* argv[])
 {
@@ -60,6 +63,14 @@ int main(int argc, char* argv[])
             testFiberCompressiveForceLengthCurve();
             testFiberCompressiveForceCosPennationCurve();
 
+            testLookupTable(ActiveForceLengthCurve());
+            testLookupTable(ForceVelocityCurve());
+            testLookupTable(ForceVelocityInverseCurve());
+            testLookupTable(TendonForceLengthCurve());
+            testLookupTable(FiberForceLengthCurve());
+            testLookupTable(FiberCompressiveForceLengthCurve());
+            testLookupTable(FiberCompressiveForceCosPennationCurve());
+
             cout << "================================================" << endl;
             cout << "                   Timing Tests                 " << endl;
             cout << "================================================" << endl;
@@ -1227,3 +1238,42 @@ void testFiberCompressiveForceCosPennationCurve()
         cout <<"________________________________________________________"<<endl;
 
 }
+
+template <typename CurveType>
+void testLookupTable(CurveType curve)
+{
+    cout << "Testing the lookup table of " << curve.getConcreteClassName()
+         << endl;
+
+    // The lookup table is off by default, and is set per curve.
+    SimTK_TEST(!curve.getUseLookupTable());
+    CurveType tableCurve(curve);
+    tableCurve.setUseLookupTable(true);
+    SimTK_TEST(tableCurve.getUseLookupTable());
+    SimTK_TEST(!curve.getUseLookupTable());
+
+    // The table agrees with the exact curve across the curve domain.
+    const SimTK::Vec2 domain = curve.getCurveDomain();
+    const int numPoints = 37;
+    for (int i = 0; i <= numPoints; ++i) {
+        const double x = domain[0] + (domain[1] - domain[0]) * i / numPoints;
+        for (int order = 0; order <= 1; ++order) {
+            const double exact = order == 0 ? curve.calcValue(x)
+                                            : curve.calcDerivative(x, order);
+            const double table = order == 0 ? tableCurve.calcValue(x)
+                                      : tableCurve.calcDerivative(x, order);
+            SimTK_TEST_EQ_TOL(table, exact, 1e-4 * (1 + std::abs(exact)));
+        }
+    }
+
+    // The setting is serialized with the curve's other properties.
+    const std::string fileName =
+            "lookupTable_" + curve.getConcreteClassName() + ".xml";
+    tableCurve.print(fileName);
+    std::unique_ptr<Object> obj(Object::makeObjectFromFile(fileName));
+    CurveType deserialized = *dynamic_cast<CurveType*>(obj.get());
+    SimTK_TEST(deserialized.getUseLookupTable());
+    deserialized.ensureCurveUpToDate();
+    SimTK_TEST(deserialized == tableCurve);
+    remove(fileName.c_str());
+}
@@ -39,6 +39,7 @@
 #include "RigidTendonMuscle.h"
 #include "Millard2012EquilibriumMuscle.h"
 #include "Millard2012AccelerationMuscle.h"
+#include "MuscleEquilibriumSolver.h"
 #include "DeGrooteFregly2016Muscle.h"
 
 #include "McKibbenActuator.h"
@@ -26,6 +26,8 @@
 #include <OpenSim/Actuators/osimActuators.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Analyses/OutputReporter.h>
+#include <OpenSim/Analyses/Kinematics.h>
+#include <cstdio>
 
 using namespace OpenSim;
 using namespace std;
@@ -60,6 +62,13 @@ void simulateMuscle(const Muscle& muscle,
                     double integrationAccuracy,
                     bool printResults);
 
+/*
+This function checks that the files written with
+AnalysisSet::setResultsOutputFiles() hold the same rows as the storages of the
+analyses.
+*/
+void testResultsOutputFiles();
+
 int main()
 {
     SimTK::Array_<std::string> failures;
@@ -83,6 +92,12 @@ int main()
         failures.push_back("testOutputReporter");
     }
 
+    try { testResultsOutputFiles(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testResultsOutputFiles");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -282,3 +297,57 @@ void simulateMuscle(
     ASSERT_EQUAL(ang_acc, val_omega, SimTK::Eps);
     ASSERT_EQUAL(reaction, val_jrf, SimTK::Eps);
 }
+
+//=============================================================================
+// Results written to files while simulating
+//=============================================================================
+void testResultsOutputFiles()
+{
+    using SimTK::Vec3;
+
+    // A ball connected to ground via a slider along X.
+    Model model;
+    OpenSim::Body* ball = new OpenSim::Body("ball", 1.0, Vec3(0),
+            SimTK::Inertia::sphere(0.05));
+    SliderJoint* slider = new SliderJoint("slider", model.getGround(), *ball);
+    slider->updCoordinate().setName("tx");
+    model.addBody(ball);
+    model.addJoint(slider);
+    model.setGravity(Vec3(-9.81, 0, 0));
+
+    Kinematics* kinematics = new Kinematics(&model);
+    model.addAnalysis(kinematics);
+    model.updAnalysisSet().setResultsOutputFiles("testResultsOutputFiles");
+
+    // The files are opened by AnalysisSet::begin() and closed by
+    // AnalysisSet::end(), which the Manager calls at the start and end of
+    // integrating.
+    SimTK::State& state = model.initSystem();
+    Manager manager(model);
+    manager.initialize(state);
+    manager.integrate(0.5);
+
+    ArrayPtrs<Storage>& storages = kinematics->getStorageList();
+    ASSERT(storages.getSize() > 0);
+    for (int i = 0; i < storages.getSize(); ++i) {
+        const Storage& expected = *storages[i];
+        const std::string fileName = "./testResultsOutputFiles_" +
+                kinematics->getName() + "_" + expected.getName() + ".sto";
+        Storage actual(fileName);
+        ASSERT(expected.getSize() > 1);
+        ASSERT(actual.getSize() == expected.getSize());
+        ASSERT(actual.getColumnLabels() == expected.getColumnLabels());
+        for (int j = 0; j < expected.getSize(); ++j) {
+            const StateVector& expectedRow = *expected.getStateVector(j);
+            const StateVector& actualRow = *actual.getStateVector(j);
+            ASSERT_EQUAL(expectedRow.getTime(), actualRow.getTime(),
+                    SimTK::Eps);
+            ASSERT(actualRow.getSize() == expectedRow.getSize());
+            for (int k = 0; k < expectedRow.getSize(); ++k) {
+                ASSERT_EQUAL(expectedRow.getData()[k],
+                        actualRow.getData()[k], 1e-12);
+            }
+        }
+        std::remove(fileName.c_str());
+    }
+}
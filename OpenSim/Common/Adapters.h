@@ -26,6 +26,8 @@
 #include "DelimFileAdapter.h"
 #include "STOFileAdapter.h"
 #include "CSVFileAdapter.h"
+#include "BinaryTimeSeriesFileAdapter.h"
+#include "TableFileWriter.h"
 
 #if defined (WITH_EZC3D) || defined (WITH_BTK)
 
@@ -0,0 +1,632 @@
+/* -------------------------------------------------------------------------- *
+ *                OpenSim:  BinaryTimeSeriesFileAdapter.cpp                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "BinaryTimeSeriesFileAdapter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace OpenSim {
+
+const std::string BinaryTimeSeriesFileAdapter::_table{"table"};
+
+namespace {
+
+// Layout of the file. All numbers are in the byte order of the machine that
+// wrote the file; strings are stored as their length followed by their
+// characters.
+//   header: magic, format version, byte order mark, data type, number of
+//           components per element, number of rows, number of columns,
+//           number of rows per block, compression flag, column labels,
+//           table metadata, dependents metadata (except the labels).
+//   blocks: the number of bytes of each stream of the block, followed by
+//           the streams: the times, then each component of each column.
+//   index:  number of blocks, then the time range, first row, number of
+//           rows, offset and number of bytes of each block.
+//   footer: offset of the index, magic.
+const char magic[8] = {'O', 'S', 'I', 'M', 'B', 'T', 'S', '\0'};
+const std::uint32_t formatVersion = 1;
+const std::uint32_t byteOrderMark = 0x01020304;
+
+struct BlockInfo {
+    double startTime;
+    double endTime;
+    std::uint64_t firstRow;
+    std::uint64_t numRows;
+    std::uint64_t offset;
+    std::uint64_t numBytes;
+};
+
+struct FileHeader {
+    std::string dataType;
+    std::uint64_t numComponents;
+    std::uint64_t numRows;
+    std::uint64_t numColumns;
+    std::uint64_t numRowsPerBlock;
+    bool compressed;
+    std::vector<std::string> labels;
+    std::vector<std::pair<std::string, std::string>> tableMetaData;
+    std::vector<std::pair<std::string, std::vector<std::string>>>
+            dependentsMetaData;
+};
+
+template<typename T> struct DataType;
+template<> struct DataType<double> {
+    static std::string name() { return "double"; }
+};
+template<> struct DataType<SimTK::Vec3> {
+    static std::string name() { return "Vec3"; }
+};
+template<> struct DataType<SimTK::Quaternion> {
+    static std::string name() { return "Quaternion"; }
+};
+template<> struct DataType<SimTK::SpatialVec> {
+    static std::string name() { return "SpatialVec"; }
+};
+
+// The elements are stored as contiguous doubles.
+template<typename T>
+constexpr size_t numComponents() {
+    return sizeof(T) / sizeof(double);
+}
+template<typename T>
+const double* components(const T& elt) {
+    static_assert(sizeof(T) % sizeof(double) == 0,
+                  "Element type must consist of doubles.");
+    return reinterpret_cast<const double*>(&elt);
+}
+template<typename T>
+double* updComponents(T& elt) {
+    return reinterpret_cast<double*>(&elt);
+}
+
+template<typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeString(std::ostream& out, const std::string& str) {
+    writeValue<std::uint64_t>(out, str.size());
+    out.write(str.data(), str.size());
+}
+
+template<typename T>
+T readValue(std::istream& in, const std::string& fileName) {
+    T value{};
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    OPENSIM_THROW_IF(!in, IOError,
+                     "Unexpected end of file '" + fileName + "'.");
+    return value;
+}
+
+std::string readString(std::istream& in, const std::string& fileName) {
+    const auto size = readValue<std::uint64_t>(in, fileName);
+    std::string str(size, '\0');
+    in.read(&str[0], size);
+    OPENSIM_THROW_IF(!in, IOError,
+                     "Unexpected end of file '" + fileName + "'.");
+    return str;
+}
+
+// Encode n doubles into out. Without compression, the bytes of the values are
+// copied. With compression, each value is replaced by the bitwise XOR with the
+// previous value; for sampled signals, most of the high-order bytes of the
+// result are zero. The bytes are grouped by significance (the lowest byte of
+// all values, then the next byte of all values, etc.) and runs of zero bytes
+// are collapsed: a control byte c < 128 is followed by c + 1 literal bytes,
+// and a control byte c >= 128 stands for c - 127 zero bytes.
+void encodeStream(const double* values, size_t n, bool compress,
+                  std::vector<unsigned char>& out) {
+    out.clear();
+    if (!compress) {
+        const auto bytes = reinterpret_cast<const unsigned char*>(values);
+        out.assign(bytes, bytes + n * sizeof(double));
+        return;
+    }
+    const size_t numBytes = n * sizeof(double);
+    std::vector<unsigned char> shuffled(numBytes);
+    std::uint64_t previous = 0;
+    for (size_t i = 0; i < n; ++i) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &values[i], sizeof(bits));
+        const std::uint64_t delta = bits ^ previous;
+        previous = bits;
+        for (size_t b = 0; b < sizeof(bits); ++b)
+            shuffled[b * n + i] = static_cast<unsigned char>(delta >> (8 * b));
+    }
+    size_t i = 0;
+    while (i < numBytes) {
+        size_t length = 1;
+        if (shuffled[i] == 0) {
+            while (i + length < numBytes && length < 128 &&
+                   shuffled[i + length] == 0)
+                ++length;
+            out.push_back(static_cast<unsigned char>(127 + length));
+        } else {
+            // Isolated zeros stay in the literal run; they would cost as much
+            // as a control byte.
+            while (i + length < numBytes && length < 128 &&
+                   !(shuffled[i + length] == 0 &&
+                     (i + length + 1 == numBytes ||
+                      shuffled[i + length + 1] == 0)))
+                ++length;
+            out.push_back(static_cast<unsigned char>(length - 1));
+            out.insert(out.end(), shuffled.begin() + i,
+                       shuffled.begin() + i + length);
+        }
+        i += length;
+    }
+}
+
+// Inverse of encodeStream().
+void decodeStream(const std::vector<unsigned char>& in, size_t n,
+                  bool compressed, double* values,
+                  const std::string& fileName) {
+    const size_t numBytes = n * sizeof(double);
+    if (!compressed) {
+        OPENSIM_THROW_IF(in.size() != numBytes, IOError,
+                         "Corrupt block in file '" + fileName + "'.");
+        std::memcpy(values, in.data(), numBytes);
+        return;
+    }
+    std::vector<unsigned char> shuffled(numBytes, 0);
+    size_t pos = 0;
+    size_t i = 0;
+    while (pos < in.size()) {
+        const unsigned control = in[pos++];
+        if (control >= 128) {
+            const size_t length = control - 127;
+            OPENSIM_THROW_IF(i + length > numBytes, IOError,
+                             "Corrupt block in file '" + fileName + "'.");
+            i += length;
+        } else {
+            const size_t length = control + 1;
+            OPENSIM_THROW_IF(i + length > numBytes ||
+                             pos + length > in.size(), IOError,
+                             "Corrupt block in file '" + fileName + "'.");
+            std::memcpy(&shuffled[i], &in[pos], length);
+            pos += length;
+            i += length;
+        }
+    }
+    OPENSIM_THROW_IF(i != numBytes, IOError,
+                     "Corrupt block in file '" + fileName + "'.");
+    std::uint64_t previous = 0;
+    for (size_t k = 0; k < n; ++k) {
+        std::uint64_t delta = 0;
+        for (size_t b = 0; b < sizeof(delta); ++b)
+            delta |= std::uint64_t(shuffled[b * n + k]) << (8 * b);
+        previous ^= delta;
+        std::memcpy(&values[k], &previous, sizeof(previous));
+    }
+}
+
+FileHeader readHeader(std::istream& in, const std::string& fileName) {
+    char fileMagic[sizeof(magic)] = {};
+    in.read(fileMagic, sizeof(fileMagic));
+    OPENSIM_THROW_IF(!in || std::memcmp(fileMagic, magic, sizeof(magic)),
+                     IOError,
+                     "File '" + fileName + "' is not a binary time series "
+                     "file.");
+    const auto version = readValue<std::uint32_t>(in, fileName);
+    OPENSIM_THROW_IF(version > formatVersion, IOError,
+                     "File '" + fileName + "' has version " +
+                     std::to_string(version) + " of the binary time series "
+                     "format; this version of OpenSim can only read up to "
+                     "version " + std::to_string(formatVersion) + ".");
+    OPENSIM_THROW_IF(readValue<std::uint32_t>(in, fileName) != byteOrderMark,
+                     IOError,
+                     "File '" + fileName + "' was written on a machine with a "
+                     "different byte order.");
+
+    FileHeader header;
+    header.dataType = readString(in, fileName);
+    header.numComponents = readValue<std::uint64_t>(in, fileName);
+    header.numRows = readValue<std::uint64_t>(in, fileName);
+    header.numColumns = readValue<std::uint64_t>(in, fileName);
+    header.numRowsPerBlock = readValue<std::uint64_t>(in, fileName);
+    header.compressed = readValue<std::uint8_t>(in, fileName) != 0;
+    for (std::uint64_t c = 0; c < header.numColumns; ++c)
+        header.labels.push_back(readString(in, fileName));
+    const auto numTableMetaData = readValue<std::uint64_t>(in, fileName);
+    for (std::uint64_t i = 0; i < numTableMetaData; ++i) {
+        auto key = readString(in, fileName);
+        auto value = readString(in, fileName);
+        header.tableMetaData.emplace_back(std::move(key), std::move(value));
+    }
+    const auto numDependentsMetaData = readValue<std::uint64_t>(in, fileName);
+    for (std::uint64_t i = 0; i < numDependentsMetaData; ++i) {
+        auto key = readString(in, fileName);
+        std::vector<std::string> values;
+        for (std::uint64_t c = 0; c < header.numColumns; ++c)
+            values.push_back(readString(in, fileName));
+        header.dependentsMetaData.emplace_back(std::move(key),
+                                               std::move(values));
+    }
+    return header;
+}
+
+std::vector<BlockInfo> readIndex(std::istream& in,
+                                 const std::string& fileName) {
+    in.seekg(-std::streamoff(sizeof(std::uint64_t) + sizeof(magic)),
+             std::ios::end);
+    const auto indexOffset = readValue<std::uint64_t>(in, fileName);
+    char fileMagic[sizeof(magic)] = {};
+    in.read(fileMagic, sizeof(fileMagic));
+    OPENSIM_THROW_IF(!in || std::memcmp(fileMagic, magic, sizeof(magic)),
+                     IOError,
+                     "File '" + fileName + "' is incomplete.");
+
+    in.seekg(std::streamoff(indexOffset));
+    const auto numBlocks = readValue<std::uint64_t>(in, fileName);
+    std::vector<BlockInfo> index;
+    index.reserve(numBlocks);
+    for (std::uint64_t b = 0; b < numBlocks; ++b) {
+        BlockInfo info;
+        info.startTime = readValue<double>(in, fileName);
+        info.endTime = readValue<double>(in, fileName);
+        info.firstRow = readValue<std::uint64_t>(in, fileName);
+        info.numRows = readValue<std::uint64_t>(in, fileName);
+        info.offset = readValue<std::uint64_t>(in, fileName);
+        info.numBytes = readValue<std::uint64_t>(in, fileName);
+        index.push_back(info);
+    }
+    return index;
+}
+
+template<typename T>
+TimeSeriesTable_<T> readTable(const std::string& fileName,
+                              double startTime,
+                              double endTime) {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+    OPENSIM_THROW_IF(startTime > endTime,
+                     InvalidArgument,
+                     "Expected startTime <= endTime, but startTime = " +
+                     std::to_string(startTime) + " and endTime = " +
+                     std::to_string(endTime) + ".");
+
+    std::ifstream in{fileName, std::ios::binary};
+    OPENSIM_THROW_IF(!in.good(),
+                     FileDoesNotExist,
+                     fileName);
+
+    const FileHeader header = readHeader(in, fileName);
+    OPENSIM_THROW_IF(header.dataType != DataType<T>::name() ||
+                     header.numComponents != numComponents<T>(),
+                     IncorrectTableType,
+                     "File '" + fileName + "' contains a table with elements "
+                     "of type '" + header.dataType + "', not '" +
+                     DataType<T>::name() + "'.");
+    const std::vector<BlockInfo> index = readIndex(in, fileName);
+
+    // The blocks are in order of time, so the blocks overlapping
+    // [startTime, endTime] are contiguous.
+    const auto first = std::lower_bound(index.begin(), index.end(), startTime,
+            [](const BlockInfo& info, double time) {
+                return info.endTime < time;
+            });
+    auto last = first;
+    size_t maxNumRows = 0;
+    while (last != index.end() && !(endTime < last->startTime)) {
+        maxNumRows += last->numRows;
+        ++last;
+    }
+
+    const size_t numColumns = header.numColumns;
+    const size_t numStreams = 1 + numColumns * numComponents<T>();
+    std::vector<double> times;
+    times.reserve(maxNumRows);
+    SimTK::Matrix_<T> data((int)maxNumRows, (int)numColumns);
+    std::vector<std::uint64_t> streamSizes(numStreams);
+    std::vector<unsigned char> buffer;
+    std::vector<double> blockTimes;
+    std::vector<double> values;
+    for (auto it = first; it != last; ++it) {
+        const size_t n = it->numRows;
+        in.seekg(std::streamoff(it->offset));
+        for (auto& size : streamSizes)
+            size = readValue<std::uint64_t>(in, fileName);
+
+        // Read and decode stream s of this block.
+        const auto readStream = [&](size_t s, std::vector<double>& out) {
+            buffer.resize(streamSizes[s]);
+            in.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+            OPENSIM_THROW_IF(!in, IOError,
+                             "Unexpected end of file '" + fileName + "'.");
+            out.resize(n);
+            decodeStream(buffer, n, header.compressed, out.data(), fileName);
+        };
+
+        readStream(0, blockTimes);
+        const size_t begin = std::lower_bound(blockTimes.begin(),
+                blockTimes.end(), startTime) - blockTimes.begin();
+        const size_t end = std::upper_bound(blockTimes.begin(),
+                blockTimes.end(), endTime) - blockTimes.begin();
+        if (begin >= end) continue;
+
+        const int row0 = (int)times.size();
+        times.insert(times.end(), blockTimes.begin() + begin,
+                     blockTimes.begin() + end);
+        for (size_t s = 1; s < numStreams; ++s) {
+            readStream(s, values);
+            const int col = int((s - 1) / numComponents<T>());
+            const size_t comp = (s - 1) % numComponents<T>();
+            for (size_t i = begin; i < end; ++i)
+                updComponents(data.updElt(row0 + int(i - begin), col))[comp] =
+                        values[i];
+        }
+    }
+    data.resizeKeep((int)times.size(), (int)numColumns);
+
+    TimeSeriesTable_<T> table{times, data, header.labels};
+    for (const auto& keyValue : header.tableMetaData)
+        table.addTableMetaData(keyValue.first, keyValue.second);
+    if (!header.dependentsMetaData.empty()) {
+        auto dependentsMetaData = table.getDependentsMetaData();
+        for (const auto& keyValues : header.dependentsMetaData) {
+            ValueArray<std::string> valueArray{};
+            for (const auto& value : keyValues.second)
+                valueArray.upd().push_back(SimTK::Value<std::string>{value});
+            dependentsMetaData.setValueArrayForKey(keyValues.first,
+                                                   valueArray);
+        }
+        table.setDependentsMetaData(dependentsMetaData);
+    }
+    return table;
+}
+
+} // anonymous namespace
+
+BinaryTimeSeriesFileAdapter*
+BinaryTimeSeriesFileAdapter::clone() const {
+    return new BinaryTimeSeriesFileAdapter{*this};
+}
+
+void
+BinaryTimeSeriesFileAdapter::setNumRowsPerBlock(int numRows) {
+    OPENSIM_THROW_IF(numRows <= 0,
+                     InvalidArgument,
+                     "Expected a positive number of rows per block, but got " +
+                     std::to_string(numRows) + ".");
+    _numRowsPerBlock = numRows;
+}
+
+template<typename T>
+void
+BinaryTimeSeriesFileAdapter::write(const TimeSeriesTable_<T>& table,
+                                   const std::string& fileName) {
+    BinaryTimeSeriesFileAdapter{}.writeTable(table, fileName);
+}
+
+template<typename T>
+void
+BinaryTimeSeriesFileAdapter::writeTable(const TimeSeriesTable_<T>& table,
+                                        const std::string& fileName) const {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+
+    std::ofstream out{fileName, std::ios::binary};
+    OPENSIM_THROW_IF(!out.good(),
+                     IOError,
+                     "Could not open file '" + fileName + "' for writing.");
+
+    const size_t numRows = table.getNumRows();
+    const size_t numColumns = table.getNumColumns();
+    const size_t numRowsPerBlock = _numRowsPerBlock;
+
+    // Header.
+    out.write(magic, sizeof(magic));
+    writeValue(out, formatVersion);
+    writeValue(out, byteOrderMark);
+    writeString(out, DataType<T>::name());
+    writeValue<std::uint64_t>(out, numComponents<T>());
+    writeValue<std::uint64_t>(out, numRows);
+    writeValue<std::uint64_t>(out, numColumns);
+    writeValue<std::uint64_t>(out, numRowsPerBlock);
+    writeValue<std::uint8_t>(out, _compressionEnabled ? 1 : 0);
+    for (const auto& label : table.getColumnLabels())
+        writeString(out, label);
+
+    // Only metadata with string values is written, as in STO files.
+    std::vector<std::pair<std::string, std::string>> tableMetaData;
+    for (const auto& key : table.getTableMetaDataKeys()) {
+        try {
+            tableMetaData.emplace_back(key,
+                    table.template getTableMetaData<std::string>(key));
+        } catch(const InvalidTemplateArgument&) {}
+    }
+    writeValue<std::uint64_t>(out, tableMetaData.size());
+    for (const auto& keyValue : tableMetaData) {
+        writeString(out, keyValue.first);
+        writeString(out, keyValue.second);
+    }
+    const auto& dependentsMetaData = table.getDependentsMetaData();
+    std::vector<std::pair<std::string, const ValueArray<std::string>*>>
+            stringDependentsMetaData;
+    for (const auto& key : dependentsMetaData.getKeys()) {
+        if (key == "labels") continue;
+        const auto valueArray = dynamic_cast<const ValueArray<std::string>*>(
+                &dependentsMetaData.getValueArrayForKey(key));
+        if (valueArray)
+            stringDependentsMetaData.emplace_back(key, valueArray);
+    }
+    writeValue<std::uint64_t>(out, stringDependentsMetaData.size());
+    for (const auto& keyValues : stringDependentsMetaData) {
+        writeString(out, keyValues.first);
+        for (const auto& value : keyValues.second->get())
+            writeString(out, value.get());
+    }
+
+    // Blocks.
+    const auto& times = table.getIndependentColumn();
+    const auto& matrix = table.getMatrix();
+    const size_t numStreams = 1 + numColumns * numComponents<T>();
+    std::vector<std::vector<unsigned char>> streams(numStreams);
+    std::vector<double> values;
+    std::vector<BlockInfo> index;
+    for (size_t firstRow = 0; firstRow < numRows;
+            firstRow += numRowsPerBlock) {
+        const size_t n = std::min(numRowsPerBlock, numRows - firstRow);
+        BlockInfo info;
+        info.startTime = times[firstRow];
+        info.endTime = times[firstRow + n - 1];
+        info.firstRow = firstRow;
+        info.numRows = n;
+        info.offset = static_cast<std::uint64_t>(out.tellp());
+
+        encodeStream(&times[firstRow], n, _compressionEnabled, streams[0]);
+        values.resize(n);
+        for (size_t s = 1; s < numStreams; ++s) {
+            const int col = int((s - 1) / numComponents<T>());
+            const size_t comp = (s - 1) % numComponents<T>();
+            for (size_t i = 0; i < n; ++i)
+                values[i] = components(
+                        matrix.getElt(int(firstRow + i), col))[comp];
+            encodeStream(values.data(), n, _compressionEnabled, streams[s]);
+        }
+        for (const auto& stream : streams)
+            writeValue<std::uint64_t>(out, stream.size());
+        for (const auto& stream : streams)
+            out.write(reinterpret_cast<const char*>(stream.data()),
+                      stream.size());
+
+        info.numBytes = static_cast<std::uint64_t>(out.tellp()) - info.offset;
+        index.push_back(info);
+    }
+
+    // Index and footer.
+    const auto indexOffset = static_cast<std::uint64_t>(out.tellp());
+    writeValue<std::uint64_t>(out, index.size());
+    for (const auto& info : index) {
+        writeValue(out, info.startTime);
+        writeValue(out, info.endTime);
+        writeValue(out, info.firstRow);
+        writeValue(out, info.numRows);
+        writeValue(out, info.offset);
+        writeValue(out, info.numBytes);
+    }
+    writeValue(out, indexOffset);
+    out.write(magic, sizeof(magic));
+
+    OPENSIM_THROW_IF(!out.good(),
+                     IOError,
+                     "Could not write file '" + fileName + "'.");
+}
+
+template<typename T>
+TimeSeriesTable_<T>
+BinaryTimeSeriesFileAdapter::readTimeRange(const std::string& fileName,
+                                           double startTime,
+                                           double endTime) {
+    return readTable<T>(fileName, startTime, endTime);
+}
+
+std::string
+BinaryTimeSeriesFileAdapter::readDataType(const std::string& fileName) {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+    std::ifstream in{fileName, std::ios::binary};
+    OPENSIM_THROW_IF(!in.good(),
+                     FileDoesNotExist,
+                     fileName);
+    return readHeader(in, fileName).dataType;
+}
+
+BinaryTimeSeriesFileAdapter::OutputTables
+BinaryTimeSeriesFileAdapter::extendRead(const std::string& fileName) const {
+    const std::string dataType = readDataType(fileName);
+    const double inf = SimTK::Infinity;
+
+    OutputTables tables{};
+    std::shared_ptr<AbstractDataTable> table;
+    if (dataType == DataType<double>::name()) {
+        table.reset(new TimeSeriesTable(
+                readTable<double>(fileName, -inf, inf)));
+    } else if (dataType == DataType<SimTK::Vec3>::name()) {
+        table.reset(new TimeSeriesTableVec3(
+                readTable<SimTK::Vec3>(fileName, -inf, inf)));
+    } else if (dataType == DataType<SimTK::Quaternion>::name()) {
+        table.reset(new TimeSeriesTableQuaternion(
+                readTable<SimTK::Quaternion>(fileName, -inf, inf)));
+    } else if (dataType == DataType<SimTK::SpatialVec>::name()) {
+        table.reset(new TimeSeriesTable_<SimTK::SpatialVec>(
+                readTable<SimTK::SpatialVec>(fileName, -inf, inf)));
+    } else {
+        OPENSIM_THROW(IOError,
+                      "File '" + fileName + "' contains a table with "
+                      "unsupported elements of type '" + dataType + "'.");
+    }
+    tables.emplace(_table, table);
+    return tables;
+}
+
+void
+BinaryTimeSeriesFileAdapter::extendWrite(const InputTables& absTables,
+                                         const std::string& fileName) const {
+    OPENSIM_THROW_IF(absTables.empty(),
+                     NoTableFound);
+
+    const AbstractDataTable* absTable{};
+    try {
+        absTable = absTables.at(_table);
+    } catch(const std::out_of_range&) {
+        OPENSIM_THROW(KeyMissing,
+                      _table);
+    }
+
+    if (auto table = dynamic_cast<const TimeSeriesTable*>(absTable)) {
+        writeTable(*table, fileName);
+    } else if (auto tableVec3 =
+            dynamic_cast<const TimeSeriesTableVec3*>(absTable)) {
+        writeTable(*tableVec3, fileName);
+    } else if (auto tableQuat =
+            dynamic_cast<const TimeSeriesTableQuaternion*>(absTable)) {
+        writeTable(*tableQuat, fileName);
+    } else if (auto tableSpatialVec = dynamic_cast<
+            const TimeSeriesTable_<SimTK::SpatialVec>*>(absTable)) {
+        writeTable(*tableSpatialVec, fileName);
+    } else {
+        OPENSIM_THROW(IncorrectTableType,
+                      "Expected a TimeSeriesTable with elements of type "
+                      "double, Vec3, Quaternion or SpatialVec.");
+    }
+}
+
+#define OPENSIM_INSTANTIATE_BINARY_TIME_SERIES(T)                             \
+template OSIMCOMMON_API void BinaryTimeSeriesFileAdapter::write<T>(           \
+        const TimeSeriesTable_<T>&, const std::string&);                      \
+template OSIMCOMMON_API void BinaryTimeSeriesFileAdapter::writeTable<T>(      \
+        const TimeSeriesTable_<T>&, const std::string&) const;                \
+template OSIMCOMMON_API TimeSeriesTable_<T>                                   \
+BinaryTimeSeriesFileAdapter::readTimeRange<T>(                                \
+        const std::string&, double, double);
+
+OPENSIM_INSTANTIATE_BINARY_TIME_SERIES(double)
+OPENSIM_INSTANTIATE_BINARY_TIME_SERIES(SimTK::Vec3)
+OPENSIM_INSTANTIATE_BINARY_TIME_SERIES(SimTK::Quaternion)
+OPENSIM_INSTANTIATE_BINARY_TIME_SERIES(SimTK::SpatialVec)
+
+#undef OPENSIM_INSTANTIATE_BINARY_TIME_SERIES
+
+} // namespace OpenSim
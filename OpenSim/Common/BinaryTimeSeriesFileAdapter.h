@@ -0,0 +1,134 @@
+/* -------------------------------------------------------------------------- *
+ *                 OpenSim:  BinaryTimeSeriesFileAdapter.h                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_BINARY_TIME_SERIES_FILE_ADAPTER_H_
+#define OPENSIM_BINARY_TIME_SERIES_FILE_ADAPTER_H_
+
+#include "FileAdapter.h"
+#include "TimeSeriesTable.h"
+
+namespace OpenSim {
+
+/** BinaryTimeSeriesFileAdapter is a FileAdapter that reads and writes
+TimeSeriesTable_%s in a binary format (files with extension ".bsto").
+Compared to STO files, these files are smaller, store the values exactly, are
+read without parsing text, and allow reading only the rows in a time window.
+
+The supported tables are TimeSeriesTable, TimeSeriesTableVec3,
+TimeSeriesTableQuaternion and TimeSeriesTable_<SimTK::SpatialVec>. The column
+labels, the table metadata with string values and the dependents metadata
+with string values are stored; metadata of other types is skipped, as in STO
+files.
+
+The rows are stored in blocks with a fixed number of rows (see
+setNumRowsPerBlock()). Within a block, the values are stored column by
+column: first the time, then each component of each column. The blocks can
+be compressed losslessly (see setCompressionEnabled()); each column is then
+stored as the bitwise difference (XOR) of consecutive values, with the bytes
+grouped by significance and runs of zero bytes collapsed. This works well for
+sampled signals, whose consecutive values share most of their high-order
+bytes. An index at the end of the file holds the time range and location of
+each block, so that readTimeRange() only reads the blocks that overlap the
+requested time window.
+
+Numbers are stored in the byte order of the machine that writes the file.
+Reading a file written on a machine with a different byte order throws.
+
+@code
+TimeSeriesTable table("long_trial.sto");
+BinaryTimeSeriesFileAdapter::write(table, "long_trial.bsto");
+// Read 10 seconds from the middle of the trial.
+TimeSeriesTable window = BinaryTimeSeriesFileAdapter::readTimeRange<double>(
+        "long_trial.bsto", 3600, 3610);
+@endcode
+
+The adapter is registered for the extension "bsto", so the tables can also be
+read with, e.g., `TimeSeriesTable table("long_trial.bsto")`.               */
+class OSIMCOMMON_API BinaryTimeSeriesFileAdapter : public FileAdapter {
+public:
+    BinaryTimeSeriesFileAdapter()                                   = default;
+    BinaryTimeSeriesFileAdapter(const BinaryTimeSeriesFileAdapter&) = default;
+    BinaryTimeSeriesFileAdapter(BinaryTimeSeriesFileAdapter&&)      = default;
+    BinaryTimeSeriesFileAdapter& operator=(
+            const BinaryTimeSeriesFileAdapter&)                     = default;
+    BinaryTimeSeriesFileAdapter& operator=(
+            BinaryTimeSeriesFileAdapter&&)                          = default;
+    ~BinaryTimeSeriesFileAdapter()                                  = default;
+
+    BinaryTimeSeriesFileAdapter* clone() const override;
+
+    /** Write a table to a file using the default settings (compressed blocks
+    of 4096 rows). The filename provided need not contain ".bsto".
+    \tparam T double, SimTK::Vec3, SimTK::Quaternion or SimTK::SpatialVec.  */
+    template<typename T>
+    static void write(const TimeSeriesTable_<T>& table,
+                      const std::string& fileName);
+
+    /** Write a table to a file using the settings of this adapter.
+    \tparam T double, SimTK::Vec3, SimTK::Quaternion or SimTK::SpatialVec.  */
+    template<typename T>
+    void writeTable(const TimeSeriesTable_<T>& table,
+                    const std::string& fileName) const;
+
+    /** Read the rows of the table in a file whose times are within
+    [startTime, endTime]. Only the blocks of rows that overlap this interval
+    are read from the file.
+    \throws IncorrectTableType If the file does not contain a table with
+                               elements of type T.                           */
+    template<typename T>
+    static TimeSeriesTable_<T> readTimeRange(const std::string& fileName,
+                                             double startTime,
+                                             double endTime);
+
+    /** Name of the type of the elements of the table in a file: "double",
+    "Vec3", "Quaternion" or "SpatialVec".                                     */
+    static std::string readDataType(const std::string& fileName);
+
+    /** Number of rows in each block of the file (except possibly the last).
+    Smaller blocks make reading short time windows cheaper; larger blocks
+    compress better. The default is 4096.                                     */
+    void setNumRowsPerBlock(int numRows);
+    int getNumRowsPerBlock() const { return _numRowsPerBlock; }
+
+    /** Whether the blocks are compressed when writing. The default is true.
+    Reading detects compression from the file.                               */
+    void setCompressionEnabled(bool enabled) { _compressionEnabled = enabled; }
+    bool getCompressionEnabled() const { return _compressionEnabled; }
+
+    /** Key used for table associative array returned/accepted by write/read. */
+    static const std::string _table;
+
+protected:
+    /** Implementation of the read functionality.                             */
+    OutputTables extendRead(const std::string& fileName) const override;
+
+    /** Implementation of the write functionality.                            */
+    void extendWrite(const InputTables& tables,
+                     const std::string& fileName) const override;
+
+private:
+    int  _numRowsPerBlock{4096};
+    bool _compressionEnabled{true};
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_BINARY_TIME_SERIES_FILE_ADAPTER_H_
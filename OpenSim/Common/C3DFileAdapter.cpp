@@ -9,8 +9,92 @@
 #include "btkGroundReactionWrenchFilter.h"
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 namespace {
 
+// Number of threads to use for a requested maximum, where 0 means the number
+// of hardware threads.
+int resolveNumThreads(int maxNumThreads) {
+    if(maxNumThreads > 0)
+        return maxNumThreads;
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+// Call func(begin, end) on contiguous blocks of the frames [0, numFrames),
+// using up to numThreads threads (including the calling thread). Each frame
+// is processed exactly once, so func may write to the rows of a preallocated
+// matrix. Rethrows the exception of the first block that threw.
+void forEachFrameBlock(int numFrames, int numThreads,
+                       const std::function<void(int, int)>& func) {
+    // Short recordings are not worth the overhead of threads.
+    const int minFramesPerThread = 1000;
+    numThreads = std::max(1, std::min(numThreads,
+                                      numFrames / minFramesPerThread));
+    if(numThreads == 1) {
+        func(0, numFrames);
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(numThreads);
+    const auto processBlock = [&](int thread) {
+        const int begin = static_cast<int>(
+                static_cast<long long>(numFrames) * thread / numThreads);
+        const int end = static_cast<int>(
+                static_cast<long long>(numFrames) * (thread + 1) / numThreads);
+        try {
+            func(begin, end);
+        } catch(...) {
+            errors[thread] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads{};
+    for(int thread = 1; thread < numThreads; ++thread)
+        threads.emplace_back(processBlock, thread);
+    processBlock(0);
+    for(auto& thread : threads)
+        thread.join();
+    for(const auto& error : errors)
+        if(error)
+            std::rethrow_exception(error);
+}
+
+// Run first on a separate thread while the calling thread runs second, or run
+// them one after the other if concurrent is false. Exceptions are rethrown
+// once both have finished (the exception of first takes precedence).
+void runConcurrently(bool concurrent,
+                     const std::function<void()>& first,
+                     const std::function<void()>& second) {
+    if(!concurrent) {
+        first();
+        second();
+        return;
+    }
+    std::exception_ptr firstError{};
+    std::thread thread{[&] {
+        try {
+            first();
+        } catch(...) {
+            firstError = std::current_exception();
+        }
+    }};
+    std::exception_ptr secondError{};
+    try {
+        second();
+    } catch(...) {
+        secondError = std::current_exception();
+    }
+    thread.join();
+    if(firstError)
+        std::rethrow_exception(firstError);
+    if(secondError)
+        std::rethrow_exception(secondError);
+}
+
 #ifdef WITH_EZC3D
 // Function to convert ezc3d matrix to SimTK matrix. This can become a lambda
 // function inside extendRead in future.
@@ -80,6 +164,62 @@ C3DFileAdapter::clone() const {
     return new C3DFileAdapter{*this};
 }
 
+void C3DFileAdapter::setMaxNumThreads(int numThreads) {
+    OPENSIM_THROW_IF(numThreads < 0, InvalidArgument,
+                     "Expected a non-negative number of threads, but got " +
+                     std::to_string(numThreads) + ".");
+    _maxNumThreads = numThreads;
+}
+
+void C3DFileAdapter::readFiles(const std::vector<std::string>& fileNames,
+        const std::function<void(size_t, OutputTables&)>& process,
+        int numThreads) const {
+    OPENSIM_THROW_IF(numThreads < 0, InvalidArgument,
+                     "Expected a non-negative number of threads, but got " +
+                     std::to_string(numThreads) + ".");
+    numThreads = std::min(resolveNumThreads(numThreads),
+                          static_cast<int>(fileNames.size()));
+
+    // The files are already read concurrently.
+    C3DFileAdapter adapter{*this};
+    adapter._maxNumThreads = 1;
+
+    // Files are handed out in order, so when a file fails, all files with a
+    // lower index have been started and the first error (by index) is the
+    // one a serial loop would have hit.
+    std::atomic<size_t> nextFile{0};
+    std::atomic<bool> failed{false};
+    std::mutex errorMutex;
+    size_t errorFile = fileNames.size();
+    std::exception_ptr error{};
+    const auto readFilesOnThread = [&] {
+        while(!failed) {
+            const size_t i = nextFile++;
+            if(i >= fileNames.size())
+                return;
+            try {
+                auto tables = adapter.read(fileNames[i]);
+                process(i, tables);
+            } catch(...) {
+                std::lock_guard<std::mutex> lock{errorMutex};
+                if(i < errorFile) {
+                    errorFile = i;
+                    error = std::current_exception();
+                }
+                failed = true;
+            }
+        }
+    };
+    std::vector<std::thread> threads{};
+    for(int thread = 1; thread < numThreads; ++thread)
+        threads.emplace_back(readFilesOnThread);
+    readFilesOnThread();
+    for(auto& thread : threads)
+        thread.join();
+    if(error)
+        std::rethrow_exception(error);
+}
+
 void C3DFileAdapter::write(
                       const C3DFileAdapter::Tables& tables,
                       const std::string& fileName) {
@@ -113,238 +253,246 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
                         eventDescriptionStr
                 });
     }
-    OutputTables tables{};
-
-    int numFrames(static_cast<int>(c3d.data().nbFrames()));
-    int numMarkers(c3d.parameters().group("POINT")
-                           .parameter("USED").valuesAsInt()[0]);
-    double pointFrequency(
-            static_cast<double>(
-                    c3d.parameters().group("POINT")
-                            .parameter("RATE").valuesAsDouble()[0]));
-
-    if(numMarkers != 0) {
-
-        int marker_nrow = numFrames;
-        int marker_ncol = numMarkers;
-
-        std::vector<double> marker_times(marker_nrow);
-        SimTK::Matrix_<SimTK::Vec3> marker_matrix(marker_nrow, marker_ncol);
-
-        std::vector<std::string> marker_labels{};
-        for (auto label : c3d.parameters().group("POINT")
-                .parameter("LABELS").valuesAsString()) {
-            marker_labels.push_back(SimTK::Value<std::string>(label));
-        }
+    const int numThreads = resolveNumThreads(_maxNumThreads);
+    // Markers and force platforms are decoded from the parsed file, which is
+    // only read, so they can be decoded concurrently. Split the threads
+    // between them.
+    const int numMarkerThreads = std::max(1, numThreads / 2);
+    const int numForceThreads = std::max(1, numThreads - numMarkerThreads);
+
+    std::shared_ptr<TimeSeriesTableVec3> marker_table;
+    std::shared_ptr<TimeSeriesTableVec3> force_table;
+
+    const auto readMarkers = [&] {
+        int numFrames(static_cast<int>(c3d.data().nbFrames()));
+        int numMarkers(c3d.parameters().group("POINT")
+                               .parameter("USED").valuesAsInt()[0]);
+        double pointFrequency(
+                static_cast<double>(
+                        c3d.parameters().group("POINT")
+                                .parameter("RATE").valuesAsDouble()[0]));
+
+        if(numMarkers != 0) {
+
+            int marker_nrow = numFrames;
+            int marker_ncol = numMarkers;
+
+            std::vector<double> marker_times(marker_nrow);
+            SimTK::Matrix_<SimTK::Vec3> marker_matrix(marker_nrow, marker_ncol,
+                                                      SimTK::Vec3(SimTK::NaN));
+
+            std::vector<std::string> marker_labels{};
+            for (auto label : c3d.parameters().group("POINT")
+                    .parameter("LABELS").valuesAsString()) {
+                marker_labels.push_back(SimTK::Value<std::string>(label));
+            }
 
-        double time_step{1.0 / pointFrequency};
-        for(int f = 0; f < marker_nrow; ++f) {
-            SimTK::RowVector_<SimTK::Vec3> row{ numMarkers,
-                                                SimTK::Vec3(SimTK::NaN) };
-            int m{0};
-            // C3D standard is to read empty values as zero, but sets a
-            // "residual" value to -1 and it is how it knows to export these
-            // values as blank, instead of 0,  when exporting to .trc
-            // See: C3D documention 3D Point Residuals
-            // Read in value if it is not zero or residual is not -1
-            for(auto pt : c3d.data().frame(f).points().points()) {
-                if (!pt.isEmpty() ) {//residual is not -1
-                    row[m] = SimTK::Vec3{ static_cast<double>(pt.x()),
-                                          static_cast<double>(pt.y()),
-                                          static_cast<double>(pt.z()) };
+            double time_step{1.0 / pointFrequency};
+            forEachFrameBlock(marker_nrow, numMarkerThreads,
+                    [&](int begin, int end) {
+                for(int f = begin; f < end; ++f) {
+                    int m{0};
+                    // C3D standard is to read empty values as zero, but sets a
+                    // "residual" value to -1 and it is how it knows to export
+                    // these values as blank, instead of 0,  when exporting to
+                    // .trc. See: C3D documention 3D Point Residuals
+                    // Read in value if it is not zero or residual is not -1
+                    for(const auto& pt : c3d.data().frame(f).points().points()) {
+                        if (m == marker_ncol) break;
+                        if (!pt.isEmpty() ) {//residual is not -1
+                            marker_matrix(f, m) =
+                                    SimTK::Vec3{ static_cast<double>(pt.x()),
+                                                 static_cast<double>(pt.y()),
+                                                 static_cast<double>(pt.z()) };
+                        }
+                        ++m;
+                    }
+                    marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
                 }
-                ++m;
+            });
+
+            // Create the data
+            marker_table =
+                    std::make_shared<TimeSeriesTableVec3>(marker_times,
+                                                          marker_matrix,
+                                                          marker_labels);
+
+            marker_table->
+                    updTableMetaData().
+                    setValueForKey("DataRate",
+                                   std::to_string(pointFrequency));
+
+            const auto& units_param = c3d.parameters().group("POINT")
+                    .parameter("UNITS").valuesAsString();
+            std::string units;
+            if (units_param.size() > 0){
+                units = units_param[0];
             }
+            else {
+                units = "";
+            }
+            marker_table->updTableMetaData().setValueForKey("Units", units);
 
-            marker_matrix.updRow(f) = row;
-            marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
-        }
-
-        // Create the data
-        auto marker_table =
-                std::make_shared<TimeSeriesTableVec3>(marker_times,
-                                                      marker_matrix,
-                                                      marker_labels);
-
-        marker_table->
-                updTableMetaData().
-                setValueForKey("DataRate",
-                               std::to_string(pointFrequency));
-
-        const auto& units_param = c3d.parameters().group("POINT")
-                .parameter("UNITS").valuesAsString();
-        std::string units;
-        if (units_param.size() > 0){
-            units = units_param[0];
+            marker_table->updTableMetaData().setValueForKey("events", event_table);
         }
-        else {
-            units = "";
+        else { // insert empty table
+            std::vector<double> emptyTimes;
+            std::vector<std::string> emptyLabels;
+            SimTK::Matrix_<SimTK::Vec3> noData;
+            marker_table =
+                    std::make_shared<TimeSeriesTableVec3>(
+                            emptyTimes, noData, emptyLabels);
         }
-        marker_table->updTableMetaData().setValueForKey("Units", units);
-
-        marker_table->updTableMetaData().setValueForKey("events", event_table);
+    };
 
-        tables.emplace(_markers, marker_table);
-    }
-    else { // insert empty table
-        std::vector<double> emptyTimes;
-        std::vector<std::string> emptyLabels;
-        SimTK::Matrix_<SimTK::Vec3> noData;
-        auto emptyMarkersTable =
-                std::make_shared<TimeSeriesTableVec3>(
-                        emptyTimes, noData, emptyLabels);
-        tables.emplace(_markers, emptyMarkersTable);
-    }
+    const auto readForces = [&] {
+        std::vector<SimTK::Matrix_<double>> fpCalMatrices{};
+        std::vector<SimTK::Matrix_<double>> fpCorners{};
+        std::vector<SimTK::Matrix_<double>> fpOrigins{};
+        std::vector<unsigned>               fpTypes{};
+        const auto& force_platforms_extractor = ezc3d::Modules::ForcePlatforms(c3d);
 
-    std::vector<SimTK::Matrix_<double>> fpCalMatrices{};
-    std::vector<SimTK::Matrix_<double>> fpCorners{};
-    std::vector<SimTK::Matrix_<double>> fpOrigins{};
-    std::vector<unsigned>               fpTypes{};
-    const auto& force_platforms_extractor = ezc3d::Modules::ForcePlatforms(c3d);
+        ForceLocation forceLocation(getLocationForForceExpression());
+        auto numPlatform(static_cast<int>(
+                                 force_platforms_extractor.forcePlatforms().size()));
 
-    ForceLocation forceLocation(getLocationForForceExpression());
-    auto numPlatform(static_cast<int>(
-                             force_platforms_extractor.forcePlatforms().size()));
+        for (const auto& platform : force_platforms_extractor.forcePlatforms()){
 
-    for (const auto& platform : force_platforms_extractor.forcePlatforms()){
+            const auto& calMatrix = platform.calMatrix();
+            const auto& corners   = platform.corners();
+            const auto& origins   = platform.origin();
+            auto type = platform.type();
 
-        const auto& calMatrix = platform.calMatrix();
-        const auto& corners   = platform.corners();
-        const auto& origins   = platform.origin();
-        auto type = platform.type();
+            fpCalMatrices.push_back(convertToSimtkMatrix(calMatrix));
+            fpCorners.push_back(convertToSimtkMatrix(corners));
+            fpOrigins.push_back(convertToSimtkMatrix(origins));
+            fpTypes.push_back(static_cast<unsigned>(type));
 
-        fpCalMatrices.push_back(convertToSimtkMatrix(calMatrix));
-        fpCorners.push_back(convertToSimtkMatrix(corners));
-        fpOrigins.push_back(convertToSimtkMatrix(origins));
-        fpTypes.push_back(static_cast<unsigned>(type));
-
-    }
-
-    if(numPlatform != 0) {
-        for (auto type : c3d.parameters().group("FORCE_PLATFORM")
-                            .parameter("TYPE").valuesAsInt()){
-            if (type == 1){
-                log_warn("C3DFileAdapter::extendRead::ezc3d: "
-                         "Type 1 force platform detected. Please note that "
-                         "results will vary between BTK and ezc3d backends.");
-            }
-        }
-        std::vector<std::string> labels{};
-        ValueArray<std::string> units{};
-        for(int fp = 1; fp <= numPlatform; ++fp) {
-            auto fp_str = std::to_string(fp);
-
-            auto force_unit =
-                    force_platforms_extractor.forcePlatform(fp-1).forceUnit();
-            auto position_unit =
-                    force_platforms_extractor.forcePlatform(fp-1).positionUnit();
-            auto moment_unit =
-                    force_platforms_extractor.forcePlatform(fp-1).momentUnit();
-
-            labels.push_back(SimTK::Value<std::string>("f" + fp_str));
-            units.upd().push_back(SimTK::Value<std::string>(force_unit));
-
-            labels.push_back(SimTK::Value<std::string>("p" + fp_str));
-            units.upd().push_back(SimTK::Value<std::string>(position_unit));
-
-            labels.push_back(SimTK::Value<std::string>("m" + fp_str));
-            units.upd().push_back(SimTK::Value<std::string>(moment_unit));
         }
 
-        const int nf = static_cast<int>(force_platforms_extractor.forcePlatform(0).nbFrames());
-        auto analogFrequency = static_cast<double>(c3d.header().frameRate()
-                                                   * c3d.header().nbAnalogByFrame());
-        const auto& pf_ref(force_platforms_extractor.forcePlatforms());
-
-        std::vector<double> force_times(nf);
-        SimTK::Matrix_<SimTK::Vec3> force_matrix(nf, (int)labels.size());
-
-        double time_step{1.0 / analogFrequency};
-
-        for(int f = 0; f < nf;  ++f) {
-            SimTK::RowVector_<SimTK::Vec3>
-                    row{numPlatform * 3};
-            int col{0};
-            for (size_t i = 0; i < (size_t)numPlatform; ++i){
-                row[col] = SimTK::Vec3{pf_ref[i].forces()[f](0),
-                                       pf_ref[i].forces()[f](1),
-                                       pf_ref[i].forces()[f](2)};
-                ++col;
-                if (forceLocation == ForceLocation::CenterOfPressure){
-                    row[col] = SimTK::Vec3{pf_ref[i].CoP()[f](0),
-                                           pf_ref[i].CoP()[f](1),
-                                           pf_ref[i].CoP()[f](2)};
-                    ++col;
-                    row[col] = SimTK::Vec3{pf_ref[i].Tz()[f](0),
-                                           pf_ref[i].Tz()[f](1),
-                                           pf_ref[i].Tz()[f](2)};
-                    ++col;
-                } else if (forceLocation == ForceLocation::OriginOfForcePlate){
-                    row[col] = SimTK::Vec3{pf_ref[i].meanCorners()(0),
-                                           pf_ref[i].meanCorners()(1),
-                                           pf_ref[i].meanCorners()(2)};
-                    ++col;
-                    row[col] = SimTK::Vec3{pf_ref[i].moments()[f](0),
-                                           pf_ref[i].moments()[f](1),
-                                           pf_ref[i].moments()[f](2)};
-                    ++col;
-                } else {
-                    OPENSIM_THROW(Exception,
-                                  "The selected force location is not "
-                                  "implemented for ezc3d files");
+        if(numPlatform != 0) {
+            for (auto type : c3d.parameters().group("FORCE_PLATFORM")
+                                .parameter("TYPE").valuesAsInt()){
+                if (type == 1){
+                    log_warn("C3DFileAdapter::extendRead::ezc3d: "
+                             "Type 1 force platform detected. Please note that "
+                             "results will vary between BTK and ezc3d backends.");
                 }
             }
-            force_matrix.updRow(f) = row;
-            force_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
-        }
+            std::vector<std::string> labels{};
+            ValueArray<std::string> units{};
+            for(int fp = 1; fp <= numPlatform; ++fp) {
+                auto fp_str = std::to_string(fp);
+
+                auto force_unit =
+                        force_platforms_extractor.forcePlatform(fp-1).forceUnit();
+                auto position_unit =
+                        force_platforms_extractor.forcePlatform(fp-1).positionUnit();
+                auto moment_unit =
+                        force_platforms_extractor.forcePlatform(fp-1).momentUnit();
+
+                labels.push_back(SimTK::Value<std::string>("f" + fp_str));
+                units.upd().push_back(SimTK::Value<std::string>(force_unit));
+
+                labels.push_back(SimTK::Value<std::string>("p" + fp_str));
+                units.upd().push_back(SimTK::Value<std::string>(position_unit));
+
+                labels.push_back(SimTK::Value<std::string>("m" + fp_str));
+                units.upd().push_back(SimTK::Value<std::string>(moment_unit));
+            }
 
-        auto&  force_table =
-                *(new TimeSeriesTableVec3(force_times, force_matrix, labels));
+            const int nf = static_cast<int>(force_platforms_extractor.forcePlatform(0).nbFrames());
+            auto analogFrequency = static_cast<double>(c3d.header().frameRate()
+                                                       * c3d.header().nbAnalogByFrame());
+            const auto& pf_ref(force_platforms_extractor.forcePlatforms());
+
+            OPENSIM_THROW_IF(nf > 0 &&
+                             forceLocation != ForceLocation::CenterOfPressure &&
+                             forceLocation != ForceLocation::OriginOfForcePlate,
+                             Exception,
+                             "The selected force location is not "
+                             "implemented for ezc3d files");
+
+            std::vector<double> force_times(nf);
+            SimTK::Matrix_<SimTK::Vec3> force_matrix(nf, (int)labels.size());
+
+            double time_step{1.0 / analogFrequency};
+
+            const auto toVec3 = [](const ezc3d::Vector3d& vec) {
+                return SimTK::Vec3{vec(0), vec(1), vec(2)};
+            };
+            forEachFrameBlock(nf, numForceThreads, [&](int begin, int end) {
+                for(int f = begin; f < end;  ++f) {
+                    int col{0};
+                    for (size_t i = 0; i < (size_t)numPlatform; ++i){
+                        force_matrix(f, col++) = toVec3(pf_ref[i].forces()[f]);
+                        if (forceLocation == ForceLocation::CenterOfPressure){
+                            force_matrix(f, col++) = toVec3(pf_ref[i].CoP()[f]);
+                            force_matrix(f, col++) = toVec3(pf_ref[i].Tz()[f]);
+                        } else {
+                            force_matrix(f, col++) =
+                                    toVec3(pf_ref[i].meanCorners());
+                            force_matrix(f, col++) =
+                                    toVec3(pf_ref[i].moments()[f]);
+                        }
+                    }
+                    force_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
+                }
+            });
 
-        TimeSeriesTableVec3::DependentsMetaData force_dep_metadata
-                = force_table.getDependentsMetaData();
+            force_table = std::make_shared<TimeSeriesTableVec3>(
+                    force_times, force_matrix, labels);
 
-        // add units to the dependent meta data
-        force_dep_metadata.setValueArrayForKey("units", units);
-        force_table.setDependentsMetaData(force_dep_metadata);
+            TimeSeriesTableVec3::DependentsMetaData force_dep_metadata
+                    = force_table->getDependentsMetaData();
 
-        force_table.
-                updTableMetaData().
-                setValueForKey("CalibrationMatrices", std::move(fpCalMatrices));
+            // add units to the dependent meta data
+            force_dep_metadata.setValueArrayForKey("units", units);
+            force_table->setDependentsMetaData(force_dep_metadata);
 
-        force_table.
-                updTableMetaData().
-                setValueForKey("Corners", std::move(fpCorners));
+            force_table->
+                    updTableMetaData().
+                    setValueForKey("CalibrationMatrices", std::move(fpCalMatrices));
 
-        force_table.
-                updTableMetaData().
-                setValueForKey("Origins", std::move(fpOrigins));
+            force_table->
+                    updTableMetaData().
+                    setValueForKey("Corners", std::move(fpCorners));
 
-        force_table.
-                updTableMetaData().
-                setValueForKey("Types", std::move(fpTypes));
+            force_table->
+                    updTableMetaData().
+                    setValueForKey("Origins", std::move(fpOrigins));
 
-        force_table.
-                updTableMetaData().
-                setValueForKey("DataRate",
-                               std::to_string(analogFrequency));
+            force_table->
+                    updTableMetaData().
+                    setValueForKey("Types", std::move(fpTypes));
 
-        tables.emplace(_forces,
-                       std::shared_ptr<TimeSeriesTableVec3>(&force_table));
+            force_table->
+                    updTableMetaData().
+                    setValueForKey("DataRate",
+                                   std::to_string(analogFrequency));
 
-        force_table.updTableMetaData().setValueForKey("events", event_table);
-    }
-    else { // insert empty table
-        std::vector<double> emptyTimes;
-        std::vector<std::string> emptyLabels;
-        SimTK::Matrix_<SimTK::Vec3> noData;
-        auto emptyforcesTable = std::make_shared<TimeSeriesTableVec3>(
-                emptyTimes, noData, emptyLabels);
-        tables.emplace(_forces, emptyforcesTable);
-    }
-    return tables;
+            force_table->updTableMetaData().setValueForKey("events", event_table);
+        }
+        else { // insert empty table
+            std::vector<double> emptyTimes;
+            std::vector<std::string> emptyLabels;
+            SimTK::Matrix_<SimTK::Vec3> noData;
+            force_table = std::make_shared<TimeSeriesTableVec3>(
+                    emptyTimes, noData, emptyLabels);
+        }
+    };
+
+    runConcurrently(numThreads > 1, readMarkers, readForces);
 
+    OutputTables tables{};
+    tables.emplace(_markers, marker_table);
+    tables.emplace(_forces, force_table);
+    return tables;
 #else // WITH_BTK.
+    // BTK's filters run one after the other; only the copies of the frames
+    // into the tables are done in parallel.
+    const int numThreads = resolveNumThreads(_maxNumThreads);
+
     auto reader = btk::AcquisitionFileReader::New();
     reader->SetFilename(fileName);
     reader->Update();
@@ -382,7 +530,8 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
         int marker_ncol = numMarkers;
 
         std::vector<double> marker_times(marker_nrow);
-        SimTK::Matrix_<SimTK::Vec3> marker_matrix(marker_nrow, marker_ncol);
+        SimTK::Matrix_<SimTK::Vec3> marker_matrix(marker_nrow, marker_ncol,
+                                                  SimTK::Vec3(SimTK::NaN));
 
         std::vector<std::string> marker_labels{};
         for (auto it = marker_pts->Begin(); it != marker_pts->End(); ++it) {
@@ -390,9 +539,7 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
         }
 
         double time_step{1.0 / pointFrequency};
-        for(int f = 0; f < marker_nrow; ++f) {
-            SimTK::RowVector_<SimTK::Vec3> row{ numMarkers,
-                                                SimTK::Vec3(SimTK::NaN) };
+        forEachFrameBlock(marker_nrow, numThreads, [&](int begin, int end) {
             int m{0};
             // C3D standard is to read empty values as zero, but sets a
             // "residual" value to -1 and it is how it knows to export these
@@ -401,19 +548,21 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
             // Read in value if it is not zero or residual is not -1
             for(auto it = marker_pts->Begin();  it != marker_pts->End(); ++it) {
                 // See: BTKCore/Code/IO/btkTRCFileIO.cpp#L359-L360
-                auto pt = *it;
-                if (!pt->GetValues().row(f).isZero() ||    //not precisely zero
-                    (pt->GetResiduals().coeff(f) != -1) ) {//residual is not -1
-                    row[m] = SimTK::Vec3{ pt->GetValues().coeff(f, 0),
-                                          pt->GetValues().coeff(f, 1),
-                                          pt->GetValues().coeff(f, 2) };
+                const auto& values = (*it)->GetValues();
+                const auto& residuals = (*it)->GetResiduals();
+                for(int f = begin; f < end; ++f) {
+                    if (!values.row(f).isZero() ||    //not precisely zero
+                        (residuals.coeff(f) != -1) ) {//residual is not -1
+                        marker_matrix(f, m) = SimTK::Vec3{ values.coeff(f, 0),
+                                                           values.coeff(f, 1),
+                                                           values.coeff(f, 2) };
+                    }
                 }
                 ++m;
             }
-
-            marker_matrix.updRow(f) = row;
-            marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
-        }
+            for(int f = begin; f < end; ++f)
+                marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
+        });
 
         // Create the data
         auto marker_table = 
@@ -524,9 +673,16 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
 
         double time_step{1.0 / analogFrequency};
 
-        for(int f = 0; f < nf;  ++f) {
-            SimTK::RowVector_<SimTK::Vec3> 
-                row{numPlatform * 3};
+        // Copy the values of a point into a column of the matrix.
+        const auto copyColumn = [&](const btk::Point::Pointer& point, int col,
+                                    int begin, int end) {
+            const auto& values = point->GetValues();
+            for(int f = begin; f < end; ++f)
+                force_matrix(f, col) = SimTK::Vec3{values.coeff(f, 0),
+                                                   values.coeff(f, 1),
+                                                   values.coeff(f, 2)};
+        };
+        forEachFrameBlock(nf, numThreads, [&](int begin, int end) {
             int col{0};
             for(auto fit = fp_force_pts->Begin(),
                 mit =     fp_moment_pts->Begin(),
@@ -535,22 +691,13 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
                 ++fit, 
                 ++mit,
                 ++pit) {
-                row[col] = SimTK::Vec3{(*fit)->GetValues().coeff(f, 0),
-                                       (*fit)->GetValues().coeff(f, 1),
-                                       (*fit)->GetValues().coeff(f, 2)};
-                ++col;
-                row[col] = SimTK::Vec3{(*pit)->GetValues().coeff(f, 0),
-                                       (*pit)->GetValues().coeff(f, 1),
-                                       (*pit)->GetValues().coeff(f, 2)};
-                ++col;
-                row[col] = SimTK::Vec3{(*mit)->GetValues().coeff(f, 0),
-                                       (*mit)->GetValues().coeff(f, 1),
-                                       (*mit)->GetValues().coeff(f, 2)};
-                ++col;
+                copyColumn(*fit, col++, begin, end);
+                copyColumn(*pit, col++, begin, end);
+                copyColumn(*mit, col++, begin, end);
             }
-            force_matrix.updRow(f) = row;
-            force_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
-        }
+            for(int f = begin; f < end; ++f)
+                force_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
+        });
 
         auto&  force_table = 
             *(new TimeSeriesTableVec3(force_times, force_matrix, labels));
@@ -28,6 +28,8 @@
 #include "TimeSeriesTable.h"
 #include "Event.h"
 
+#include <functional>
+
 namespace OpenSim {
 
 /** C3DFileAdapter reads a C3D file into markers and forces tables of type
@@ -117,9 +119,41 @@ public:
         return _location;
     }
 
+    /** Set the maximum number of threads used to read a file. With more than
+        one thread, the markers and the force-plate data are decoded
+        concurrently (ezc3d only), and the frames of long recordings are
+        copied into the tables in parallel blocks. The tables are identical
+        to those read with a single thread. The default is 1; 0 uses
+        the number of hardware threads. */
+    void setMaxNumThreads(int numThreads);
+    /** Retrieve the maximum number of threads used to read a file. */
+    int getMaxNumThreads() const {
+        return _maxNumThreads;
+    }
+
 #ifndef SWIG
     static
     void write(const Tables& markerTable, const std::string& fileName);
+
+    /** Read many files concurrently, e.g., to process a collection of trials.
+        Each file is read (with the settings of this adapter, but with one
+        thread per file) and the resulting tables are passed to `process`
+        along with the index of the file in `fileNames`. The tables are
+        released once `process` returns, so at most `numThreads` files are
+        held in memory at any time. `process` is called concurrently from
+        multiple threads, in no particular order.
+
+        If reading a file or `process` throws, no further files are started,
+        and the exception for the file with the lowest index is rethrown once
+        the files in progress are finished.
+
+        @param fileNames The C3D files to read.
+        @param process Called with the index of the file and its tables.
+        @param numThreads Number of files read at once; 0 uses the number of
+                          hardware threads. */
+    void readFiles(const std::vector<std::string>& fileNames,
+                   const std::function<void(size_t, OutputTables&)>& process,
+                   int numThreads = 0) const;
 #endif
 
     /** Retrieve the TimeSeriesTableVec3 of Markers */
@@ -149,6 +183,8 @@ private:
 
     ForceLocation _location{ ForceLocation::OriginOfForcePlate };
 
+    int _maxNumThreads{ 1 };
+
 };
 
 } // namespace OpenSim
@@ -179,6 +179,10 @@ void Component::finalizeFromProperties()
 {
     reset();
 
+    // The tree may have changed; the root's index of components by name must
+    // be rebuilt before it is used again.
+    getRoot()._componentsByNameIsValid = false;
+
     // last opportunity to modify Object names based on properties
     if (!hasOwner()) {
         // only call when Component is root since method is recursive
@@ -301,6 +305,30 @@ void Component::finalizeConnections(Component& root)
         finalizeFromProperties();
     }
 
+    // Connecting the Sockets of the whole tree calls findComponent() on the
+    // root once per Socket; let those calls use an index of the components
+    // by name rather than traverse the tree each time.
+    if (&root == this && !_useComponentsByName) {
+        _useComponentsByName = true;
+        _componentsByNameIsValid = false;
+        try {
+            finalizeConnections(root);
+        } catch (...) {
+            _useComponentsByName = false;
+            _componentsByName.clear();
+            throw;
+        }
+        _useComponentsByName = false;
+        _componentsByName.clear();
+        return;
+    }
+
+    // The names and owners in the tree are final now; store the absolute
+    // path so that getAbsolutePathString() and getAbsolutePath() need not
+    // traverse the tree. reset() clears these.
+    _absolutePathString = generateAbsolutePathString();
+    _absolutePath = ComponentPath(_absolutePathString);
+
     for (auto& it : _socketsTable) {
         auto& socket = it.second;
         try {
@@ -339,6 +367,34 @@ void Component::finalizeConnections(Component& root)
     setObjectIsUpToDateWithProperties();
 }
 
+bool Component::isStrictAncestorOf(const Component& other) const
+{
+    const Component* comp = &other;
+    while (comp->hasOwner()) {
+        comp = &comp->getOwner();
+        if (comp == this) return true;
+    }
+    return false;
+}
+
+const std::vector<const Component*>*
+Component::findIndexedComponentsWithName(const std::string& name) const
+{
+    if (!_useComponentsByName) return nullptr;
+
+    if (!_componentsByNameIsValid) {
+        _componentsByName.clear();
+        for (const auto& comp : getComponentList<Component>()) {
+            _componentsByName[comp.getName()].push_back(&comp);
+        }
+        _componentsByNameIsValid = true;
+    }
+
+    static const std::vector<const Component*> none;
+    auto it = _componentsByName.find(name);
+    return it != _componentsByName.end() ? &it->second : &none;
+}
+
 // invoke connect on all (sub)components of this component
 void Component::componentsFinalizeConnections(Component& root)
 {
@@ -710,9 +766,11 @@ void Component::setOwner(const Component& owner)
     }
 
     _owner.reset(&owner);
+    _absolutePathString.clear();
+    _absolutePath = ComponentPath();
 }
 
-std::string Component::getAbsolutePathString() const
+std::string Component::generateAbsolutePathString() const
 {
     if (!hasOwner()) return "/";
     std::string absPathName("/" + getName());
@@ -726,25 +784,41 @@ std::string Component::getAbsolutePathString() const
     }
 
     return absPathName;
-
 }
 
-ComponentPath Component::getAbsolutePath() const
+bool Component::isStoredAbsolutePathCurrent() const
 {
-    if (!hasOwner()) return ComponentPath({}, true);
-
-    std::vector<std::string> pathVec;
-    pathVec.push_back(getName());
-
+    const std::string& path = _absolutePathString;
+    if (path.empty()) return false;
+    // Compare the names from this Component up to the root with the
+    // segments of the stored path, from its end, without allocating.
+    size_t end = path.size();
     const Component* up = this;
-
-    while (up && up->hasOwner()) {
+    while (up->hasOwner()) {
+        const std::string& name = up->getName();
+        if (end < name.size() + 1) return false;
+        const size_t start = end - name.size();
+        if (path[start - 1] != '/' ||
+                path.compare(start, name.size(), name) != 0)
+            return false;
+        end = start - 1;
         up = &up->getOwner();
-        if (up->hasOwner())
-            pathVec.insert(pathVec.begin(), up->getName());
     }
+    return end == 0;
+}
+
+std::string Component::getAbsolutePathString() const
+{
+    if (!hasOwner()) return "/";
+    if (isStoredAbsolutePathCurrent()) return _absolutePathString;
+    return generateAbsolutePathString();
+}
 
-    return ComponentPath(pathVec, true);
+ComponentPath Component::getAbsolutePath() const
+{
+    if (!hasOwner()) return ComponentPath({}, true);
+    if (isStoredAbsolutePathCurrent()) return _absolutePath;
+    return ComponentPath(generateAbsolutePathString());
 }
 
 std::string Component::getRelativePathString(const Component& wrt) const
@@ -900,6 +974,93 @@ void Component::
     throw Exception(msg.str(),__FILE__,__LINE__);
 }
 
+Component::StateVariableHandle
+Component::getStateVariableHandle(const std::string& path) const
+{
+    // Must have already called initSystem.
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+
+    const StateVariable* sv = traverseToStateVariable(path);
+    OPENSIM_THROW_IF_FRMOBJ(!sv, Exception,
+            "State variable '{}' not found.", path);
+
+    StateVariableHandle handle;
+    handle.stateVariable.reset(sv);
+    handle.system.reset(&getSystem());
+
+    // For added state variables, record where the value and the derivative
+    // are stored so they can be accessed without name lookups.
+    if (dynamic_cast<const AddedStateVariable*>(sv)) {
+        handle.subsysIndex = sv->getSubsysIndex();
+        handle.zIndex = SimTK::ZIndex(sv->getVarIndex());
+        handle.derivIndex = sv->getOwner().getCacheVariableIndex(
+                sv->getName() + "_deriv");
+    }
+    return handle;
+}
+
+const Component::StateVariable& Component::getStateVariableFromHandle(
+        const StateVariableHandle& handle) const
+{
+    // Must have already called initSystem.
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+    OPENSIM_THROW_IF_FRMOBJ(!handle.isValid(), Exception,
+            "The state variable handle is not valid; obtain one with "
+            "getStateVariableHandle().");
+    OPENSIM_THROW_IF_FRMOBJ(
+            !getSystem().isSameSystem(handle.system.getRef()), Exception,
+            "The handle for state variable '{}' was obtained for a "
+            "different System; call getStateVariableHandle() again after "
+            "initSystem().",
+            handle.getName());
+    return handle.stateVariable.getRef();
+}
+
+double Component::getStateVariableValue(const SimTK::State& state,
+        const StateVariableHandle& handle) const
+{
+    const StateVariable& sv = getStateVariableFromHandle(handle);
+    if (handle.zIndex.isValid()) {
+        return state.getZ(handle.subsysIndex)[handle.zIndex];
+    }
+    return sv.getValue(state);
+}
+
+void Component::setStateVariableValue(SimTK::State& state,
+        const StateVariableHandle& handle, double value) const
+{
+    const StateVariable& sv = getStateVariableFromHandle(handle);
+    if (handle.zIndex.isValid()) {
+        state.updZ(handle.subsysIndex)[handle.zIndex] = value;
+        return;
+    }
+    sv.setValue(state, value);
+}
+
+double Component::getStateVariableDerivativeValue(const SimTK::State& state,
+        const StateVariableHandle& handle) const
+{
+    const StateVariable& sv = getStateVariableFromHandle(handle);
+    sv.getOwner().computeStateVariableDerivatives(state);
+    if (handle.derivIndex.isValid()) {
+        const SimTK::AbstractValue& v =
+                sv.getOwner().getDefaultSubsystem().getCacheEntry(
+                        state, handle.derivIndex);
+        return SimTK::Value<double>::downcast(v).get();
+    }
+    return sv.getDerivative(state);
+}
+
+const std::string& Component::StateVariableHandle::getName() const
+{
+    return stateVariable.getRef().getName();
+}
+
+const Component& Component::StateVariableHandle::getOwner() const
+{
+    return stateVariable.getRef().getOwner();
+}
+
 bool Component::isAllStatesVariablesListValid() const
 {
     int nsv = getNumStateVariables();
@@ -928,6 +1089,30 @@ bool Component::isAllStatesVariablesListValid() const
 }
 
 
+void Component::updateAllStateVariablesList() const
+{
+    _statesAssociatedSystem.reset(&getSystem());
+    _allStateVariables.clear();
+    _allStateVariables.reserve(getNumStateVariables());
+
+    // Same order as getStateVariableNames(): the state variables of this
+    // Component, then those of each Component in the ComponentList, each in
+    // order of allocation.
+    auto appendAddedByComponent = [this](const Component& comp) {
+        const int offset = (int)_allStateVariables.size();
+        _allStateVariables.resize(
+                offset + (int)comp._namedStateVariableInfo.size());
+        for (const auto& kv : comp._namedStateVariableInfo) {
+            _allStateVariables[offset + kv.second.order].reset(
+                    kv.second.stateVariable.get());
+        }
+    };
+    appendAddedByComponent(*this);
+    for (const auto& comp : getComponentList<Component>()) {
+        appendAddedByComponent(comp);
+    }
+}
+
 // Get all values of the state variables allocated by this Component. Includes
 // state variables allocated by its subcomponents.
 SimTK::Vector Component::
@@ -938,14 +1123,7 @@ SimTK::Vector Component::
 
     int nsv = getNumStateVariables();
     // if the StateVariables are invalid (see above) rebuild the list
-    if (!isAllStatesVariablesListValid()) {
-        _statesAssociatedSystem.reset(&getSystem());
-        _allStateVariables.clear();
-        _allStateVariables.resize(nsv);
-        Array<std::string> names = getStateVariableNames();
-        for (int i = 0; i < nsv; ++i)
-            _allStateVariables[i].reset(traverseToStateVariable(names[i]));
-    }
+    if (!isAllStatesVariablesListValid()) updateAllStateVariablesList();
 
     Vector stateVariableValues(nsv, SimTK::NaN);
     for(int i=0; i<nsv; ++i){
@@ -971,14 +1149,7 @@ void Component::
         "number of state variables.");
 
     // if the StateVariables are invalid (see above) rebuild the list 
-    if (!isAllStatesVariablesListValid()) {
-        _statesAssociatedSystem.reset(&getSystem());
-        _allStateVariables.clear();
-        _allStateVariables.resize(nsv);
-        Array<std::string> names = getStateVariableNames();
-        for (int i = 0; i < nsv; ++i)
-            _allStateVariables[i].reset(traverseToStateVariable(names[i]));
-    }
+    if (!isAllStatesVariablesListValid()) updateAllStateVariablesList();
 
     for(int i=0; i<nsv; ++i){
         _allStateVariables[i]->setValue(state, values[i]);
@@ -1056,6 +1227,22 @@ setDiscreteVariableValue(SimTK::State& s, const std::string& name, double value)
     }
 }
 
+std::vector<SimTK::DiscreteVariableIndex>
+Component::getDiscreteVariableIndices() const
+{
+    // Must have already called initSystem.
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+
+    std::vector<SimTK::DiscreteVariableIndex> indices;
+    for (const auto& kv : _namedDiscreteVariableInfo)
+        indices.push_back(kv.second.index);
+    for (const auto& comp : getComponentList<Component>()) {
+        for (const auto& kv : comp._namedDiscreteVariableInfo)
+            indices.push_back(kv.second.index);
+    }
+    return indices;
+}
+
 SimTK::CacheEntryIndex Component::getCacheVariableIndex(const std::string& name) const
 {
     auto it = this->_namedCacheVariables.find(name);
@@ -1834,6 +2021,9 @@ void Component::reset()
     _simTKcomponentIndex.invalidate();
     clearStateAllocations();
 
+    _absolutePathString.clear();
+    _absolutePath = ComponentPath();
+
     _propertySubcomponents.clear();
     _adoptedSubcomponents.clear();
     resetSubcomponentOrder();
@@ -683,17 +683,20 @@ public:
      * For example: a Coordinate Component would have an absolute path name
      * like: `/arm26/elbow_r/flexion`. Accessing a Component by its
      * absolutePathName from root is guaranteed to be unique. The
-     * absolutePathName is generated on-the-fly by traversing the ownership tree
-     * and, therefore, calling this method is not "free". */
+     * absolutePathName is stored when the Component's connections are
+     * finalized (see finalizeConnections()), after which this method only
+     * checks that the stored absolutePathName still matches the names of this
+     * Component and its owners, without allocating. Before that, after
+     * finalizeFromProperties() is called again, or after this Component or
+     * one of its owners is renamed, the absolutePathName is generated
+     * on-the-fly by traversing the ownership tree. */
     std::string getAbsolutePathString() const;
 
     /** Return a ComponentPath of the absolute path of this Component.
-     * Note that this has more overhead than calling `getName()` because
-     * it traverses up the tree to generate the absolute pathname (and its
-     * computational cost is thus a function of depth). Consider other
-     * options if this is repeatedly called and efficiency is important.
-     * For instance, `getAbsolutePathString()` is faster if you only
-     * need the path as a string. */
+     * Like getAbsolutePathString(), this returns the path stored by
+     * finalizeConnections() if there is one; otherwise, it traverses up the
+     * tree to generate the absolute pathname (and its computational cost is
+     * thus a function of depth). */
     ComponentPath getAbsolutePath() const;
 
     /** Get the relative path of this Component with respect to another
@@ -1368,6 +1371,51 @@ public:
     double getStateVariableDerivativeValue(const SimTK::State& state,
         const std::string& name) const;
 
+#ifndef SWIG // StateVariableHandle is a nested class.
+    class StateVariableHandle;
+
+    /**
+     * Resolve a state variable anywhere in the Component tree, given its
+     * path (relative to this Component or absolute), into a
+     * StateVariableHandle. Looking up the state variable by name happens only
+     * here; accessing the state variable through the handle does not hash or
+     * compare strings. Use this in code that accesses the same state
+     * variables repeatedly (e.g., controllers, analyses, or goals):
+     *
+     *  @code
+     *  // Once, after initSystem().
+     *  auto handle = model.getStateVariableHandle("/forceset/soleus/activation");
+     *  // Repeatedly.
+     *  double activation = model.getStateVariableValue(state, handle);
+     *  @endcode
+     *
+     * The handle is tied to the System that exists when it is resolved; using
+     * it after the System is rebuilt (e.g., by calling initSystem() again)
+     * throws an Exception.
+     *
+     * @param path   path to the state variable of interest
+     * @throws ComponentHasNoSystem if this Component has not been added to a
+     *         System (i.e., if initSystem has not been called)
+     */
+    StateVariableHandle getStateVariableHandle(const std::string& path) const;
+
+    /** Get the value of a state variable resolved with
+     * getStateVariableHandle(). */
+    double getStateVariableValue(const SimTK::State& state,
+            const StateVariableHandle& handle) const;
+
+    /** %Set the value of a state variable resolved with
+     * getStateVariableHandle(). */
+    void setStateVariableValue(SimTK::State& state,
+            const StateVariableHandle& handle, double value) const;
+
+    /** Get the value of the derivative of a state variable resolved with
+     * getStateVariableHandle(). The derivatives of the Component that owns the
+     * state variable are computed first. */
+    double getStateVariableDerivativeValue(const SimTK::State& state,
+            const StateVariableHandle& handle) const;
+#endif
+
     /**
      * Get the value of a discrete variable allocated by this Component by name.
      *
@@ -1392,6 +1440,18 @@ public:
     void setDiscreteVariableValue(SimTK::State& state, const std::string& name,
                                   double value) const;
 
+    /**
+     * Get the indices of the discrete variables allocated (via
+     * addDiscreteVariable()) by this Component and its subcomponents. These
+     * discrete variables have type double and belong to the System's default
+     * subsystem. This allows copying the values of all discrete variables
+     * between states without looking them up by name (see, e.g.,
+     * CompactStatesTrajectory).
+     * @throws ComponentHasNoSystem if this Component has not been added to a
+     *         System (i.e., if initSystem has not been called)
+     */
+    std::vector<SimTK::DiscreteVariableIndex> getDiscreteVariableIndices() const;
+
     /**
      * A cache variable containing a value of type T.
      *
@@ -2522,15 +2582,36 @@ public:
                 foundCs.push_back(found);
         }
 
+        // While the root is finalizing its connections, use its index of
+        // components by name instead of traversing the whole subtree. The
+        // candidates are in tree order, so this finds the same components as
+        // the traversal below.
+        if (const auto* candidates =
+                getRoot().findIndexedComponentsWithName(subname)) {
+            for (const Component* candidate : *candidates) {
+                if (!isStrictAncestorOf(*candidate)) continue;
+                const C* comp = dynamic_cast<const C*>(candidate);
+                if (!comp) continue;
+                foundCs.push_back(comp);
+                // A child of this Component is an exact path match.
+                if (&comp->getOwner() == this) break;
+                log_debug("{} Found '{}' as a match for: Component '{}' of "
+                          "type {}, but it is not on the specified path.",
+                          msg, comp->getAbsolutePathString(),
+                          comp->getConcreteClassName());
+            }
+            return foundCs.empty() ? nullptr :
+                    findComponentCheckUnique(foundCs, name, msg);
+        }
+
         ComponentList<const C> compsList = this->template getComponentList<C>();
 
         for (const C& comp : compsList) {
             // if a child of this Component, one should not need
-            // to specify this Component's absolute path name
-            ComponentPath compAbsPath = comp.getAbsolutePath();
-            ComponentPath thisAbsPathPlusSubname = getAbsolutePath();
-            thisAbsPathPlusSubname.pushBack(subname);
-            if (compAbsPath == thisAbsPathPlusSubname) {
+            // to specify this Component's absolute path name (the child's
+            // absolute path is this Component's path plus subname).
+            const std::string& compName = comp.getName();
+            if (compName == subname && &comp.getOwner() == this) {
                 foundCs.push_back(&comp);
                 break;
             }
@@ -2539,34 +2620,22 @@ public:
             // which we may need to support for compatibility with older models
             // where only names were used (not path or type)
             // TODO replace with an exception -aseth
-            std::string compName = comp.getName();
             if (compName == subname) {
                 foundCs.push_back(&comp);
                 // TODO Revisit why the exact match isn't found when
                 // when what appears to be the complete path.
                 log_debug("{} Found '{}' as a match for: Component '{}' of "
                           "type {}, but it is not on the specified path.",
-                          msg, compAbsPath.toString(),
+                          msg, comp.getAbsolutePathString(),
                           comp.getConcreteClassName());
                 //throw Exception(details, __FILE__, __LINE__);
             }
         }
 
-        if (foundCs.size() == 1) {
-            //unique type and name match!
-            return foundCs[0];
-        }
-
-        // Only error cases remain
-        // too many components of the right type with the same name
-        if (foundCs.size() > 1) {
-            msg += "Found multiple '" + name + "'s of type " +
-                foundCs[0]->getConcreteClassName() + ".";
-            throw Exception(msg, __FILE__, __LINE__);
-        }
-
         // Not found
-        return nullptr;
+        if (foundCs.empty()) return nullptr;
+
+        return findComponentCheckUnique(foundCs, name, msg);
     }
 
     /** Same as findComponent(const ComponentPath&), but accepting a string (a
@@ -2576,6 +2645,29 @@ public:
         return findComponent<C>(ComponentPath(pathToFind));
     }
 
+private:
+    // Return the single component found by findComponent(); throw if there
+    // are too many components of the right type with the same name.
+    template<class C>
+    static const C* findComponentCheckUnique(const std::vector<const C*>& foundCs,
+            const std::string& name, std::string msg) {
+        if (foundCs.size() > 1) {
+            msg += "Found multiple '" + name + "'s of type " +
+                foundCs[0]->getConcreteClassName() + ".";
+            throw Exception(msg, __FILE__, __LINE__);
+        }
+        //unique type and name match!
+        return foundCs[0];
+    }
+
+    // Is this Component the owner, the owner's owner, etc. of other?
+    bool isStrictAncestorOf(const Component& other) const;
+
+    // Components in this (root) Component's tree with the given name, in tree
+    // order; nullptr if the index is not in use (see finalizeConnections()).
+    const std::vector<const Component*>*
+    findIndexedComponentsWithName(const std::string& name) const;
+
 protected:
 
     template<class C>
@@ -3017,6 +3109,43 @@ protected:
         bool hidden;
     };
 
+#ifndef SWIG
+public:
+    /**
+     * A state variable resolved with Component::getStateVariableHandle().
+     *
+     * The handle holds the StateVariable itself and, for state variables that
+     * a Component added with addStateVariable(), the subsystem and index of
+     * its Z slot and the index of the cache entry for its derivative, so that
+     * access does not require name lookups.
+     */
+    class StateVariableHandle {
+    public:
+        // A default-constructed handle is invalid; obtain a valid handle from
+        // Component::getStateVariableHandle().
+        StateVariableHandle() = default;
+
+        bool isValid() const { return !stateVariable.empty(); }
+        /** The name of the state variable (without a path). */
+        const std::string& getName() const;
+        /** The Component that owns the state variable. */
+        const Component& getOwner() const;
+
+    private:
+        friend class Component;
+
+        SimTK::ReferencePtr<const StateVariable> stateVariable;
+        // The System for which this handle was resolved.
+        SimTK::ReferencePtr<const SimTK::System> system;
+        // Valid only if the state variable is an AddedStateVariable.
+        SimTK::SubsystemIndex subsysIndex;
+        SimTK::ZIndex zIndex;
+        SimTK::CacheEntryIndex derivIndex;
+    };
+
+protected:
+#endif
+
     /// Helper method to enable Component makers to specify the order of their
     /// subcomponents to be added to the System during addToSystem(). It is
     /// highly unlikely that you will need to reorder the subcomponents of your
@@ -3061,6 +3190,16 @@ private:
     // Reference pointer to the successor of the current Component in Pre-order traversal
     mutable SimTK::ReferencePtr<const Component> _nextComponent;
 
+    // The absolute path of this Component, stored by finalizeConnections()
+    // and cleared by reset() and setOwner(). Empty if not yet stored. The
+    // stored path is used only while it matches the names along the owner
+    // chain (see isStoredAbsolutePathCurrent()), since any of them may be
+    // renamed with setName() after the tree is finalized.
+    SimTK::ResetOnCopy<std::string> _absolutePathString;
+    SimTK::ResetOnCopy<ComponentPath> _absolutePath;
+    std::string generateAbsolutePathString() const;
+    bool isStoredAbsolutePathCurrent() const;
+
     // Reference pointer to the system that this component belongs to.
     SimTK::ReferencePtr<SimTK::MultibodySystem> _system;
 
@@ -3241,6 +3380,12 @@ private:
 
     // Check that the list of _allStateVariables is valid
     bool isAllStatesVariablesListValid() const;
+    // Rebuild _allStateVariables (in the order of getStateVariableNames())
+    // directly from the Components of the subtree, without forming names.
+    void updateAllStateVariablesList() const;
+    // Throw if the handle was not resolved for the current System.
+    const StateVariable& getStateVariableFromHandle(
+            const StateVariableHandle& handle) const;
 
     // Array of all state variables for fast access during simulation
     mutable SimTK::Array_<SimTK::ReferencePtr<const StateVariable> >
@@ -3248,6 +3393,16 @@ private:
     // A handle the System associated with the above state variables
     mutable SimTK::ReferencePtr<const SimTK::System> _statesAssociatedSystem;
 
+    // Index of the components in the tree of this (root) Component by name,
+    // in tree order, for findComponent(). The index is in use only while this
+    // Component finalizes the connections of its tree, when findComponent()
+    // is called once per Socket. It is (re)built on first use and cleared
+    // whenever a Component in the tree is finalized from its properties.
+    mutable SimTK::ResetOnCopy<std::unordered_map<std::string,
+            std::vector<const Component*>>> _componentsByName;
+    mutable SimTK::ResetOnCopy<bool> _useComponentsByName{false};
+    mutable SimTK::ResetOnCopy<bool> _componentsByNameIsValid{false};
+
 //==============================================================================
 };  // END of class Component
 //==============================================================================
@@ -89,6 +89,11 @@ public:
     {
         return _value;
     }
+    double calcValue(double xUnused) const override { return _value; }
+    double calcValue(double xUnused, int& hintUnused) const override
+    {
+        return _value;
+    }
     double getValue() const { return _value; }
     SimTK::Function* createSimTKFunction() const override;
 //=============================================================================
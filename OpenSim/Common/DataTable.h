@@ -34,6 +34,7 @@ in-memory container for data access and manipulation.                         */
 #include "SimTKcommon/internal/Quaternion.h"
 #include <OpenSim/Common/IO.h>
 
+#include <algorithm>
 #include <iomanip>
 #include <numeric>
 
@@ -645,7 +646,9 @@ public:
         appendRow(indRow, depRow.getAsRowVectorView());
     }
 
-    /** Append row to the DataTable_.                                         
+    /** Append row to the DataTable_. The underlying matrix grows
+    geometrically, so appending runs in amortized constant time. Use reserve()
+    if the number of rows is known in advance.
 
     \throws IncorrectNumColumns If the row added is invalid. Validity of the 
     row added is decided by the derived class.                                */
@@ -662,15 +665,47 @@ public:
                              static_cast<size_t>(depRow.ncol()));
         }
 
+        const int numRows = static_cast<int>(getNumRows());
+        if(numRows == 0 && _depData.ncol() != depRow.size()) {
+            // The first row determines the number of columns. Keep any rows
+            // reserved in advance.
+            _depData.resize(std::max(_depData.nrow(), 1), depRow.size());
+            _numReservedRows = static_cast<size_t>(_depData.nrow());
+        }
+        if(_numReservedRows == 0) {
+            const int capacity = std::max(2 * numRows, 1);
+            _depData.resizeKeep(capacity, _depData.ncol());
+            _numReservedRows = static_cast<size_t>(capacity - numRows);
+        }
+
+        _depData.updRow(numRows) = depRow;
+        --_numReservedRows;
         _indData.push_back(indRow);
+    }
 
-        if(_depData.nrow() == 0) {
-            _depData.resize(1, depRow.size());
+    /** Allocate memory for at least numRows rows so that appending up to that
+    many rows does not reallocate the underlying matrix. This does not change
+    the number of rows in the table. If the table has no rows yet, the number
+    of columns is taken from the column labels, if any. Unused memory is
+    released by the next operation that modifies the table other than
+    appendRow() (e.g., removeRowAtIndex(), appendColumn(), or updMatrix()).
+    Read-only accessors never release it.                                     */
+    void reserve(size_t numRows) {
+        _indData.reserve(numRows);
+        if(numRows <= static_cast<size_t>(_depData.nrow()))
+            return;
+
+        const size_t numExistingRows = getNumRows();
+        if(numExistingRows == 0) {
+            int numColumns = _depData.ncol();
+            if(numColumns == 0 && _dependentsMetaData.hasKey("labels"))
+                numColumns = static_cast<int>(_dependentsMetaData.
+                        getValueArrayForKey("labels").size());
+            _depData.resize(static_cast<int>(numRows), numColumns);
+        } else {
+            _depData.resizeKeep(static_cast<int>(numRows), _depData.ncol());
         }
-        else 
-            _depData.resizeKeep(_depData.nrow() + 1, _depData.ncol());
-            
-        _depData.updRow(_depData.nrow() - 1) = depRow;
+        _numReservedRows = numRows - numExistingRows;
     }
 
     /** Get row at index.                                                     
@@ -785,6 +820,7 @@ public:
                          RowIndexOutOfRange, 
                          index, 0, static_cast<unsigned>(_indData.size() - 1));
 
+        releaseReservedRows();
         if(index < getNumRows() - 1)
             for(size_t r = index; r < getNumRows() - 1; ++r)
                 _depData.updRow((int)r) = _depData.row((int)(r + 1));
@@ -943,6 +979,7 @@ public:
                          static_cast<size_t>(getNumRows()),
                          static_cast<size_t>(depCol.nrow()));
         
+        releaseReservedRows();
         _depData.resizeKeep(_depData.nrow(), _depData.ncol() + 1);
         _depData.updCol(_depData.ncol() - 1) = depCol;
         appendColumnLabel(columnLabel);
@@ -956,6 +993,8 @@ public:
             ColumnIndexOutOfRange,
             index, 0, static_cast<unsigned>(_depData.ncol() - 1));
 
+        releaseReservedRows();
+
         // get copy of labels
         auto labels = getColumnLabels();
 
@@ -998,7 +1037,8 @@ public:
                          ColumnIndexOutOfRange, index, 0,
                          static_cast<size_t>(_depData.ncol() - 1));
 
-        return _depData.col(static_cast<int>(index));
+        return _depData.block(0, static_cast<int>(index),
+                              static_cast<int>(getNumRows()), 1).col(0);
     }
 
     /** Get dependent Column which has the given column label.                
@@ -1006,7 +1046,9 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView getDependentColumn(const std::string& columnLabel) const {
-        return _depData.col(static_cast<int>(getColumnIndex(columnLabel)));
+        return _depData.block(0,
+                              static_cast<int>(getColumnIndex(columnLabel)),
+                              static_cast<int>(getNumRows()), 1).col(0);
     }
 
     /** Update dependent column at index.
@@ -1020,6 +1062,7 @@ public:
                          ColumnIndexOutOfRange, index, 0,
                          static_cast<size_t>(_depData.ncol() - 1));
 
+        releaseReservedRows();
         return _depData.updCol(static_cast<int>(index));
     }
 
@@ -1028,6 +1071,7 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView updDependentColumn(const std::string& columnLabel) {
+        releaseReservedRows();
         return _depData.updCol(static_cast<int>(getColumnIndex(columnLabel)));
     }
 
@@ -1055,9 +1099,13 @@ public:
     /// column.
     /// @{
 
-    /** Get a read-only view to the underlying matrix.                        */
-    const MatrixView& getMatrix() const {
-        return _depData.getAsMatrixView();
+    /** Get a read-only view to the underlying matrix. The view refers to the
+    table's data; it is invalidated by operations that change the number of
+    rows or columns of the table (other than appending rows to reserved
+    memory; see reserve()).                                                   */
+    MatrixView getMatrix() const {
+        return _depData.block(0, 0, static_cast<int>(getNumRows()),
+                              _depData.ncol());
     }
 
     /** Get a read-only view of a block of the underlying matrix.             
@@ -1079,11 +1127,11 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart),
                          RowIndexOutOfRange,
                          rowStart, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(getNumRows() - 1));
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart + numRows - 1),
                          RowIndexOutOfRange,
                          rowStart + numRows - 1, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(getNumRows() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart),
                          ColumnIndexOutOfRange,
                          columnStart, 0, 
@@ -1101,6 +1149,7 @@ public:
 
     /** Get a writable view to the underlying matrix.                         */
     MatrixView& updMatrix() {
+        releaseReservedRows();
         return _depData.updAsMatrixView();
     }
 
@@ -1123,11 +1172,11 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart),
                          RowIndexOutOfRange,
                          rowStart, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(getNumRows() - 1));
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart + numRows - 1),
                          RowIndexOutOfRange,
                          rowStart + numRows - 1, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(getNumRows() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart),
                          ColumnIndexOutOfRange,
                          columnStart, 0, 
@@ -1137,6 +1186,7 @@ public:
                          columnStart + numColumns - 1, 0, 
                          static_cast<unsigned>(_depData.ncol() - 1));
 
+        releaseReservedRows();
         return _depData.updBlock(static_cast<int>(rowStart),
                                  static_cast<int>(columnStart),
                                  static_cast<int>(numRows),
@@ -1318,7 +1368,7 @@ protected:
             rowData.push_back(toStr(getIndependentColumn()[row]));
             for(const auto& col : cols)
                 for(const auto& comp :
-                        splitElement(getMatrix().getElt(row, col)))
+                        splitElement(_depData.getElt(row, col)))
                         rowData.push_back(toStr(comp));
             table.push_back(std::move(rowData));
         }
@@ -1557,7 +1607,20 @@ protected:
 
     /** Get number of rows.                                                   */
     size_t implementGetNumRows() const override {
-        return _depData.nrow();
+        return _depData.nrow() - _numReservedRows;
+    }
+
+    /** Shrink the underlying matrix to the number of rows in the table, 
+    discarding the rows reserved by appendRow() and reserve(). This is 
+    called by operations that modify the table, and before handing out
+    writable views that span all rows of the matrix. Read-only accessors
+    instead return views of the rows in the table, so they need not (and must
+    not) modify the matrix.                                                   */
+    void releaseReservedRows() {
+        if(_numReservedRows == 0)
+            return;
+        _depData.resizeKeep(static_cast<int>(getNumRows()), _depData.ncol());
+        _numReservedRows = 0;
     }
 
     /** Get number of columns.                                                */
@@ -1662,7 +1725,12 @@ protected:
     }
 
     std::vector<ETX>    _indData;
+    // May contain rows beyond the end of the table (see reserve()). These are
+    // released by operations that modify the table (see
+    // releaseReservedRows()).
     SimTK::Matrix_<ETY> _depData;
+    // Number of trailing rows of _depData that are not part of the table.
+    size_t              _numReservedRows = 0;
 };  // DataTable_
 
 
@@ -29,8 +29,10 @@
 #include "TimeSeriesTable.h"
 #include "OpenSim/Common/IO.h"
 
+#include <deque>
 #include <string>
 #include <fstream>
+#include <memory>
 #include <regex>
 
 namespace OpenSim {
@@ -116,6 +118,10 @@ public:
     /** Name of the data type T (template parameter).                         */
     static inline std::string dataTypeName();
 
+#ifndef SWIG
+    class BlockReader;
+#endif
+
 protected:
     /** Implementation of the read functionality.                             */
     OutputTables extendRead(const std::string& filename) const override;
@@ -124,6 +130,29 @@ protected:
     void extendWrite(const InputTables& tables,
                      const std::string& filename) const override;
 
+    /** Read the header of a file, up to and including the line containing
+    the column labels. Lines are obtained by calling `getLine(line)`, which
+    must return false once there are no more lines. `line_num` is incremented
+    for each line read. The time column label is removed from
+    `column_labels`.                                                          */
+    template<typename LineGetter>
+    void readHeader(const std::string& fileName,
+                    LineGetter getLine,
+                    size_t& line_num,
+                    ValueArrayDictionary& keyValuePairs,
+                    std::vector<std::string>& column_labels) const;
+
+    /** Read the data rows (up to the first empty line) from the buffer,
+    starting at position `pos`. `line_num` is the number of lines before the
+    data rows.                                                                */
+    inline void readRows(const std::string& fileName,
+                         const std::string& buffer,
+                         std::size_t pos,
+                         size_t line_num,
+                         int ncol,
+                         std::vector<double>& timeVec,
+                         SimTK::Matrix_<T>& matrix) const;
+
     /** Read elements of type T (template parameter) from a sequence of 
     tokens.                                                                   */
     inline SimTK::RowVector_<T> 
@@ -144,6 +173,27 @@ private:
     template<int M>
     static inline std::string dataTypeName_impl(SimTK::Vec<M>);
 
+    /** Following overloads implement readRows(). Rows of doubles are parsed
+    in place (see FileAdapter::parseNumericRows()); other types are read
+    token by token with readElems().                                          */
+    inline void readRows_impl(const std::string& fileName,
+                              const std::string& buffer,
+                              std::size_t pos,
+                              size_t line_num,
+                              int ncol,
+                              std::vector<double>& timeVec,
+                              SimTK::Matrix_<T>& matrix,
+                              double) const;
+    template<typename U>
+    inline void readRows_impl(const std::string& fileName,
+                              const std::string& buffer,
+                              std::size_t pos,
+                              size_t line_num,
+                              int ncol,
+                              std::vector<double>& timeVec,
+                              SimTK::Matrix_<T>& matrix,
+                              U) const;
+
     /** Following overloads implement readElems().                            */
     inline SimTK::RowVector_<double>
     readElems_impl(const std::vector<std::string>& tokens,
@@ -200,6 +250,81 @@ private:
     static const std::string _versionNumber;
 };
 
+#ifndef SWIG
+/** Reads the data rows of a file in blocks of at most a given number of rows,
+so that files too large to fit in memory can be processed incrementally. Only
+the current block is held in memory. The header and column labels are read
+upon construction, and each block has the same metadata and column labels as
+the table returned by read().
+
+@code
+STOFileAdapter adapter;
+STOFileAdapter::BlockReader reader(adapter, "long_trial.sto");
+TimeSeriesTable block;
+while (reader.readBlock(block, 10000)) {
+    // Process the rows in block.
+}
+@endcode
+
+The reader keeps its own copy of the adapter.                                */
+template<typename T>
+class DelimFileAdapter<T>::BlockReader {
+public:
+    /** Open the file and read its header.
+
+    \throws FileDoesNotExist If the file cannot be opened.                   */
+    BlockReader(const DelimFileAdapter& adapter, const std::string& fileName);
+
+    const std::vector<std::string>& getColumnLabels() const {
+        return _columnLabels;
+    }
+    const ValueArrayDictionary& getTableMetaData() const {
+        return _metaData;
+    }
+    /** Number of data rows read so far.                                      */
+    size_t getNumRowsRead() const { return _numRowsRead; }
+
+    /** Replace `block` with the next (up to) `maxRows` rows of the file.
+    Returns false, leaving `block` unchanged, if there are no more rows. As
+    with read(), the data ends at the first empty line.
+
+    \throws InvalidArgument If maxRows is zero.                              */
+    bool readBlock(TimeSeriesTable_<T>& block, size_t maxRows);
+
+    /** Read the remaining rows in blocks of `blockSize` rows and return those
+    whose times are within [startTime, endTime], along with up to
+    `numPaddingRows` rows on either side of that range (e.g., so that splines
+    fit to the rows are not affected by trimming). Rows before the range are
+    discarded as they are read, and reading stops after the last padding row,
+    so memory use is bounded by the size of the range and a single block. The
+    returned table has the same metadata and column labels as the blocks; it
+    is empty if no rows are at or after startTime.
+
+    \throws InvalidArgument If startTime is greater than endTime, or if
+                            blockSize is zero.                               */
+    TimeSeriesTable_<T> readTimeRange(double startTime, double endTime,
+                                      size_t numPaddingRows = 0,
+                                      size_t blockSize = 10000);
+
+private:
+    /** Get the next line of the file, without the line ending.               */
+    bool getNextLine(std::string& line);
+
+    std::unique_ptr<DelimFileAdapter> _adapter;
+    std::string _fileName;
+    std::ifstream _stream;
+    std::vector<std::string> _columnLabels;
+    ValueArrayDictionary _metaData;
+    /** Number of lines read from the file so far.                            */
+    size_t _lineNumber{};
+    size_t _numRowsRead{};
+    bool _endOfData{false};
+    /** Lines of the current block, reused between blocks.                    */
+    std::string _block;
+};
+#endif // SWIG
+
+
 
 template<typename T>
 const std::string 
@@ -310,40 +435,65 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
     OPENSIM_THROW_IF(fileName.empty(),
                      EmptyFileName);
 
-    std::ifstream in_stream{fileName};
-    OPENSIM_THROW_IF(!in_stream.good(),
-                     FileDoesNotExist,
-                     fileName);
-    
-    OPENSIM_THROW_IF(in_stream.peek() == std::ifstream::traits_type::eof(),
-                     FileIsEmpty,
-                     fileName);
+    // Read the whole file at once; the lines are then taken from the buffer.
+    const std::string buffer = readFileContents(fileName);
+    std::size_t pos{};
 
     size_t line_num{};
+    ValueArrayDictionary keyValuePairs;
+    std::vector<std::string> column_labels{};
+    readHeader(fileName,
+               [&buffer, &pos](std::string& line) {
+                   return FileAdapter::getNextLine(buffer, pos, line);
+               },
+               line_num, keyValuePairs, column_labels);
+
+    // Read the rows and fill up the time column container and the data
+    // container.
+    std::vector<double> timeVec;
+    SimTK::Matrix_<T> matrix;
+    readRows(fileName, buffer, pos, line_num,
+             static_cast<int>(column_labels.size()), timeVec, matrix);
+
+    // Create the table and update other metadata from above
+    auto table = 
+        std::make_shared<TimeSeriesTable_<T>>(timeVec, matrix, column_labels);
+    table->updTableMetaData() = keyValuePairs;
+
+    OutputTables output_tables{};
+    output_tables.emplace(tableString(), table);
+
+    return output_tables;
+}
+
+template<typename T>
+template<typename LineGetter>
+void
+DelimFileAdapter<T>::readHeader(const std::string& fileName,
+                                LineGetter getLine,
+                                size_t& line_num,
+                                ValueArrayDictionary& keyValuePairs,
+                                std::vector<std::string>& column_labels) const {
     // All the lines until "endheader" is header.
-    std::regex endheader{R"([ \t]*)" + _endHeaderString + R"([ \t]*)"};
-    std::regex keyvalue{R"((.*)=(.*))"};
     std::string header{};
     std::string line{};
-    ValueArrayDictionary keyValuePairs;
-    while(std::getline(in_stream, line)) {
+    while(getLine(line)) {
         ++line_num;
 
-        // We might be parsing a file with CRLF (\r\n) line endings on a
-        // platform that uses only LF (\n) line endings, in which case the \r
-        // is part of `line` and we must remove it manually.
-        if (!line.empty() && line.back() == '\r') 
-            line.pop_back();
-
-        if(std::regex_match(line, endheader))
+        // The line "endheader", possibly surrounded by spaces and tabs.
+        const auto first = line.find_first_not_of(" \t");
+        if(first != std::string::npos &&
+                line.compare(first, line.find_last_not_of(" \t") - first + 1,
+                             _endHeaderString) == 0)
             break;
 
         // Detect Key value pairs of the form "key = value" and add them to
-        // metadata.
-        std::smatch matchRes{};
-        if(std::regex_match(line, matchRes, keyvalue)) {
-            auto key = matchRes[1].str();
-            auto value = matchRes[2].str();
+        // metadata. The key is everything before the last '='.
+        const auto equals = line.rfind('=');
+        if(equals != std::string::npos &&
+                line.find('\r') == std::string::npos) {
+            auto key = line.substr(0, equals);
+            auto value = line.substr(equals + 1);
             IO::TrimWhitespace(value);
             if(!key.empty() && !value.empty()) {
                 const auto trimmed_key = trim(key);
@@ -374,16 +524,11 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
     }
     keyValuePairs.setValueForKey("header", header);
 
-    // Callable to get the next line in form of vector of tokens.
-    auto nextLine = [&] {
-        return getNextLine(in_stream, _delimitersRead);
-    };
-
     // Read the line containing column labels and fill up the column labels
     // container.
-    std::vector<std::string> column_labels{};
-    while (column_labels.size() == 0) { // keep going down rows to find labels
-        column_labels = nextLine();
+    // keep going down rows to find labels
+    while (column_labels.size() == 0 && getLine(line)) {
+        column_labels = tokenize(line, _delimitersRead);
         // for labels we never expect empty elements, so remove them
         IO::eraseEmptyElements(column_labels);
         ++line_num;
@@ -400,26 +545,62 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
                      _timeColumnLabel,
                      column_labels[0]);
     column_labels.erase(column_labels.begin());
+}
 
-    // Read the rows one at a time and fill up the time column container and
-    // the data container. Start with a reasonable initial capacity for
-    // tradeoff between a small file and larger files. 100 worked well for
-    // a 50 MB file with ~80000 lines.
-    std::vector<double> timeVec;
+template<typename T>
+void
+DelimFileAdapter<T>::readRows(const std::string& fileName,
+                              const std::string& buffer,
+                              std::size_t pos,
+                              size_t line_num,
+                              int ncol,
+                              std::vector<double>& timeVec,
+                              SimTK::Matrix_<T>& matrix) const {
+    readRows_impl(fileName, buffer, pos, line_num, ncol, timeVec, matrix, T{});
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::readRows_impl(const std::string& fileName,
+                                   const std::string& buffer,
+                                   std::size_t pos,
+                                   size_t line_num,
+                                   int ncol,
+                                   std::vector<double>& timeVec,
+                                   SimTK::Matrix_<T>& matrix,
+                                   double) const {
+    parseNumericRows(fileName, buffer, pos, _delimitersRead, line_num + 1,
+                     ncol, timeVec, matrix);
+}
+
+template<typename T>
+template<typename U>
+void
+DelimFileAdapter<T>::readRows_impl(const std::string& fileName,
+                                   const std::string& buffer,
+                                   std::size_t pos,
+                                   size_t line_num,
+                                   int ncol,
+                                   std::vector<double>& timeVec,
+                                   SimTK::Matrix_<T>& matrix,
+                                   U) const {
+    // Start with a reasonable initial capacity for tradeoff between a small
+    // file and larger files. 100 worked well for a 50 MB file with ~80000
+    // lines.
     int initCapacity = 100;
-    int ncol = static_cast<int>(column_labels.size());
     timeVec.reserve(initCapacity);
-    SimTK::Matrix_<T> matrix(initCapacity, ncol);
-    
+    matrix.resize(initCapacity, ncol);
+
     // Initialize current row and capacity
     int curCapacity = initCapacity;
     int curRow = 0;
 
-    // Start looping through each line
-    auto row = nextLine();
-    while (!row.empty()) {
+    // Start looping through each line; the data ends at the first empty line.
+    std::string line{};
+    while (getNextLine(buffer, pos, line) && !line.empty()) {
         ++line_num;
-        
+        auto row = tokenize(line, _delimitersRead);
+
         // Double capacity if we reach the end of the containers.
         // This is necessary until Simbody issue #401 is addressed.
         if (curRow+1 > curCapacity) {
@@ -434,32 +615,21 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
 
         auto row_vector = readElems(row);
 
-        OPENSIM_THROW_IF(row_vector.size() != (int)column_labels.size(),
+        OPENSIM_THROW_IF(row_vector.size() != ncol,
             RowLengthMismatch,
             fileName,
             line_num,
-            column_labels.size(),
+            static_cast<size_t>(ncol),
             static_cast<size_t>(row_vector.size()));
         
         matrix.updRow(curRow) = std::move(row_vector);
 
-        row = nextLine();
         ++curRow;
     }
 
     // Resize the matrix down to the correct number of rows.
     // This is necessary until Simbody issue #401 is addressed.
     matrix.resizeKeep(curRow, ncol);
-
-    // Create the table and update other metadata from above
-    auto table = 
-        std::make_shared<TimeSeriesTable_<T>>(timeVec, matrix, column_labels);
-    table->updTableMetaData() = keyValuePairs;
-
-    OutputTables output_tables{};
-    output_tables.emplace(tableString(), table);
-
-    return output_tables;
 }
 
 template<typename T>
@@ -670,6 +840,130 @@ DelimFileAdapter<T>::writeElem_impl(std::ostream& stream,
         stream << _compDelimWrite << std::setprecision(prec) << elem[i];
 }
 
+#ifndef SWIG
+template<typename T>
+DelimFileAdapter<T>::BlockReader::BlockReader(const DelimFileAdapter& adapter,
+                                              const std::string& fileName) :
+    _adapter{adapter.clone()},
+    _fileName{fileName} {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+
+    // Binary mode, for consistency with read(); line endings are handled by
+    // getNextLine().
+    _stream.open(fileName, std::ios::in | std::ios::binary);
+    OPENSIM_THROW_IF(!_stream.good(),
+                     FileDoesNotExist,
+                     fileName);
+
+    _adapter->readHeader(fileName,
+                         [this](std::string& line) {
+                             return getNextLine(line);
+                         },
+                         _lineNumber, _metaData, _columnLabels);
+}
+
+template<typename T>
+bool
+DelimFileAdapter<T>::BlockReader::getNextLine(std::string& line) {
+    if(!std::getline(_stream, line))
+        return false;
+    // Get rid of the extra \r if parsing a file with CRLF line endings.
+    if(!line.empty() && line.back() == '\r')
+        line.pop_back();
+    return true;
+}
+
+template<typename T>
+bool
+DelimFileAdapter<T>::BlockReader::readBlock(TimeSeriesTable_<T>& block,
+                                            size_t maxRows) {
+    OPENSIM_THROW_IF(maxRows == 0,
+                     InvalidArgument,
+                     "Expected maxRows to be greater than zero.");
+
+    // Collect the lines of the block, then parse them as read() does.
+    const size_t lineNumberBeforeBlock = _lineNumber;
+    size_t numRows{};
+    _block.clear();
+    std::string line{};
+    while(!_endOfData && numRows < maxRows) {
+        if(!getNextLine(line) || line.empty()) {
+            _endOfData = true;
+            break;
+        }
+        ++_lineNumber;
+        _block += line;
+        _block += '\n';
+        ++numRows;
+    }
+    if(numRows == 0)
+        return false;
+
+    std::vector<double> timeVec;
+    SimTK::Matrix_<T> matrix;
+    _adapter->readRows(_fileName, _block, 0, lineNumberBeforeBlock,
+                       static_cast<int>(_columnLabels.size()),
+                       timeVec, matrix);
+
+    block = TimeSeriesTable_<T>(timeVec, matrix, _columnLabels);
+    block.updTableMetaData() = _metaData;
+    _numRowsRead += numRows;
+    return true;
+}
+
+template<typename T>
+TimeSeriesTable_<T>
+DelimFileAdapter<T>::BlockReader::readTimeRange(double startTime,
+                                                double endTime,
+                                                size_t numPaddingRows,
+                                                size_t blockSize) {
+    OPENSIM_THROW_IF(startTime > endTime,
+                     InvalidArgument,
+                     "Expected startTime <= endTime, but got startTime = " +
+                     std::to_string(startTime) + " and endTime = " +
+                     std::to_string(endTime) + ".");
+
+    TimeSeriesTable_<T> table{};
+    table.setColumnLabels(_columnLabels);
+    table.updTableMetaData() = _metaData;
+
+    // The last numPaddingRows rows before startTime; these are only added to
+    // the table once a row within (or after) the range is read.
+    std::deque<std::pair<double, SimTK::RowVector_<T>>> rowsBefore;
+    size_t numRowsAfter{};
+    bool done{false};
+    TimeSeriesTable_<T> block{};
+    while(!done && readBlock(block, blockSize)) {
+        const auto& times = block.getIndependentColumn();
+        for(size_t i = 0; i < times.size(); ++i) {
+            const double time = times[i];
+            if(time < startTime) {
+                if(numPaddingRows == 0)
+                    continue;
+                if(rowsBefore.size() == numPaddingRows)
+                    rowsBefore.pop_front();
+                rowsBefore.emplace_back(time,
+                        block.getRowAtIndex(i).getAsRowVector());
+                continue;
+            }
+            if(time > endTime) {
+                if(numRowsAfter == numPaddingRows) {
+                    done = true;
+                    break;
+                }
+                ++numRowsAfter;
+            }
+            for(const auto& row : rowsBefore)
+                table.appendRow(row.first, row.second);
+            rowsBefore.clear();
+            table.appendRow(time, block.getRowAtIndex(i));
+        }
+    }
+    return table;
+}
+#endif // SWIG
+
 } // namespace OpenSim
 
 #endif // OPENSIM_DELIM_FILE_ADAPTER_H_
@@ -2,6 +2,15 @@
 #include <OpenSim/Common/IO.h>
 #include "STOFileAdapter.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
 namespace OpenSim {
 
 std::shared_ptr<DataAdapter>
@@ -80,6 +89,199 @@ FileAdapter::getNextLine(std::istream& stream,
     return {};
 }
 
+std::string
+FileAdapter::readFileContents(const std::string& fileName) {
+    // Binary mode, so that the size of the file is the number of characters.
+    std::ifstream stream{fileName, std::ios::in | std::ios::binary};
+    OPENSIM_THROW_IF(!stream.good(),
+                     FileDoesNotExist,
+                     fileName);
+
+    std::string contents{};
+    stream.seekg(0, std::ios::end);
+    const std::streamoff size = stream.tellg();
+    if (size > 0) {
+        contents.resize(static_cast<std::size_t>(size));
+        stream.seekg(0, std::ios::beg);
+        stream.read(&contents[0], size);
+        contents.resize(static_cast<std::size_t>(stream.gcount()));
+    } else if (size < 0) {
+        // The stream does not support seeking.
+        stream.clear();
+        stream.seekg(0, std::ios::beg);
+        std::ostringstream buffer;
+        buffer << stream.rdbuf();
+        contents = buffer.str();
+    }
+
+    OPENSIM_THROW_IF(contents.empty(),
+                     FileIsEmpty,
+                     fileName);
+    return contents;
+}
+
+bool
+FileAdapter::getNextLine(const std::string& buffer,
+                         std::size_t& pos,
+                         std::string& line) {
+    if(pos >= buffer.size())
+        return false;
+    auto end = buffer.find('\n', pos);
+    const auto next = (end == std::string::npos) ? buffer.size() : end + 1;
+    if(end == std::string::npos)
+        end = buffer.size();
+    // Get rid of the extra \r if parsing a file with CRLF line endings.
+    if(end > pos && buffer[end - 1] == '\r')
+        --end;
+    line.assign(buffer, pos, end - pos);
+    pos = next;
+    return true;
+}
+
+namespace {
+// The characters removed by IO::TrimWhitespace().
+inline bool isTrimmedWhitespace(char ch) {
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+}
+
+// Same as std::stod(std::string(begin, end)), including the exceptions it
+// throws. The token is parsed in place, which requires that the buffer is
+// null-terminated after the token. The token is copied only if the
+// conversion does not stop within the token (e.g., empty or invalid tokens).
+double parseDouble(const char* begin, const char* end) {
+    if(begin != end) {
+        const int savedErrno = errno;
+        errno = 0;
+        char* parsedEnd = nullptr;
+        const double value = std::strtod(begin, &parsedEnd);
+        const bool outOfRange = errno == ERANGE;
+        if(errno == 0)
+            errno = savedErrno;
+        if(parsedEnd != begin && parsedEnd <= end) {
+            if(outOfRange)
+                throw std::out_of_range("stod");
+            return value;
+        }
+    }
+    return std::stod(std::string(begin, end));
+}
+
+// Parse one row in the same way as tokenize() followed by std::stod() on
+// each token. Returns the number of tokens; tokens beyond numColumns + 1 are
+// converted (as they would be by std::stod()) but not stored.
+std::size_t parseNumericRow(const char* begin, const char* end,
+                            const std::string& delims,
+                            int numColumns,
+                            double& time,
+                            SimTK::Matrix& matrix,
+                            int row) {
+    std::size_t numTokens = 0;
+    const auto storeToken = [&](const char* tokenBegin, const char* tokenEnd) {
+        while(tokenBegin != tokenEnd && isTrimmedWhitespace(*tokenBegin))
+            ++tokenBegin;
+        while(tokenEnd != tokenBegin && isTrimmedWhitespace(*(tokenEnd - 1)))
+            --tokenEnd;
+        const double value = parseDouble(tokenBegin, tokenEnd);
+        if(numTokens == 0)
+            time = value;
+        else if(numTokens <= static_cast<std::size_t>(numColumns))
+            matrix(row, static_cast<int>(numTokens - 1)) = value;
+        ++numTokens;
+    };
+    const char* tokenBegin = begin;
+    while(true) {
+        const char* tokenEnd = std::find_first_of(tokenBegin, end,
+                delims.begin(), delims.end());
+        if(tokenEnd == end) {
+            // As in tokenize(), there is no empty token after a trailing
+            // delimiter.
+            if(end > tokenBegin)
+                storeToken(tokenBegin, end);
+            break;
+        }
+        storeToken(tokenBegin, tokenEnd);
+        tokenBegin = tokenEnd + 1;
+    }
+    return numTokens;
+}
+} // namespace
+
+void
+FileAdapter::parseNumericRows(const std::string& fileName,
+                              const std::string& buffer,
+                              std::size_t pos,
+                              const std::string& delims,
+                              std::size_t lineNumber,
+                              int numColumns,
+                              std::vector<double>& time,
+                              SimTK::Matrix& matrix) {
+    // Find the lines first, so that the rows can be divided among threads.
+    const char* data = buffer.c_str();
+    const char* const bufferEnd = data + buffer.size();
+    std::vector<std::pair<const char*, const char*>> rows{};
+    const char* lineBegin = data + std::min(pos, buffer.size());
+    while(lineBegin < bufferEnd) {
+        const char* newline = static_cast<const char*>(
+                std::memchr(lineBegin, '\n', bufferEnd - lineBegin));
+        const char* lineEnd = newline ? newline : bufferEnd;
+        const char* next = newline ? newline + 1 : bufferEnd;
+        if(lineEnd > lineBegin && *(lineEnd - 1) == '\r')
+            --lineEnd;
+        // The data ends at the first empty line.
+        if(lineEnd == lineBegin)
+            break;
+        rows.emplace_back(lineBegin, lineEnd);
+        lineBegin = next;
+    }
+
+    const int numRows = static_cast<int>(rows.size());
+    time.resize(numRows);
+    matrix.resize(numRows, numColumns);
+
+    // Small files are not worth the overhead of threads.
+    const int minRowsPerThread = 2000;
+    const int numThreads = std::max(1, std::min(
+            static_cast<int>(std::thread::hardware_concurrency()),
+            numRows / minRowsPerThread));
+
+    // Each thread parses a contiguous block of rows and stops at its first
+    // error. The error that is reported is the one a serial parser would
+    // encounter first.
+    std::vector<std::exception_ptr> errors(numThreads);
+    const auto parseBlock = [&](int thread) {
+        const int first = static_cast<int>(
+                static_cast<long long>(numRows) * thread / numThreads);
+        const int last = static_cast<int>(
+                static_cast<long long>(numRows) * (thread + 1) / numThreads);
+        try {
+            for(int irow = first; irow < last; ++irow) {
+                const auto numTokens = parseNumericRow(rows[irow].first,
+                        rows[irow].second, delims, numColumns, time[irow],
+                        matrix, irow);
+                OPENSIM_THROW_IF(
+                        numTokens - 1 != static_cast<std::size_t>(numColumns),
+                        RowLengthMismatch,
+                        fileName,
+                        lineNumber + irow,
+                        static_cast<std::size_t>(numColumns),
+                        numTokens - 1);
+            }
+        } catch(...) {
+            errors[thread] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads{};
+    for(int thread = 1; thread < numThreads; ++thread)
+        threads.emplace_back(parseBlock, thread);
+    parseBlock(0);
+    for(auto& thread : threads)
+        thread.join();
+    for(const auto& error : errors) {
+        if(error)
+            std::rethrow_exception(error);
+    }
+}
+
 std::shared_ptr<DataAdapter>
 FileAdapter::createAdapterFromExtension(const std::string& fileName) {
     auto extension = FileAdapter::findExtension(fileName);
@@ -213,6 +213,40 @@ public:
     specifies that either a space or a tab can act as the delimiter.          */
     static std::vector<std::string> tokenize(const std::string& str, 
                                       const std::string& delims);
+
+    /** Read the entire contents of a file into a string, with a single read
+    operation. Line endings are not converted.
+    @throws FileDoesNotExist if the file cannot be opened.
+    @throws FileIsEmpty if the file is empty.                                 */
+    static std::string readFileContents(const std::string& fileName);
+
+    /** Get the next line from a buffer (e.g., from readFileContents()),
+    starting at position `pos`, which is advanced to the start of the following
+    line. The line does not include the line ending ("\n" or "\r\n").
+    Returns false if there are no more lines.                                 */
+    static bool getNextLine(const std::string& buffer, std::size_t& pos,
+                            std::string& line);
+
+    /** Parse rows of delimited numbers from a buffer, starting at position
+    `pos`, up to the first empty line or the end of the buffer. `time` and
+    `matrix` are resized to the number of rows; the first number in each row
+    is stored in `time` and the remaining numbers form the corresponding row
+    of `matrix`. Each row must have `numColumns` numbers after the first. The
+    result is identical to splitting each line with getNextLine() and
+    converting each token with std::stod(), including the exceptions thrown
+    for invalid rows. However, the tokens are converted in place without
+    copying them, and the rows of large files are parsed in parallel.
+    `lineNumber` is the line number of the first row in the file, for error
+    messages.
+    @throws RowLengthMismatch if a row has the wrong number of columns.       */
+    static void parseNumericRows(const std::string& fileName,
+                                 const std::string& buffer,
+                                 std::size_t pos,
+                                 const std::string& delims,
+                                 std::size_t lineNumber,
+                                 int numColumns,
+                                 std::vector<double>& time,
+                                 SimTK::Matrix& matrix);
     /** Create a concerte FileAdapter based on the extension of the passed in file and return it.
      This serves as a Factory of FileAdapters so clients don't need to know specific concrete 
      subclasses, as long as the generic base class read interface is used */
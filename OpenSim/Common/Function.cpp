@@ -166,6 +166,43 @@ double Function::calcValue(const Vector& x) const
     return _function->calcValue(x);
 }
 
+double Function::calcValue(double x) const
+{
+    // View x without copying it.
+    const Vector xVector(1, &x, true);
+    return calcValue(xVector);
+}
+
+double Function::calcValue(double x, int& hint) const
+{
+    return calcValue(x);
+}
+
+int Function::findInterval(const double* x, int n, double aX, int& hint)
+{
+    if (hint >= 0 && hint < n-1) {
+        if (x[hint] <= aX && aX <= x[hint+1])
+            return hint;
+        // Monotonic access usually moves on to the next interval.
+        if (hint < n-2 && x[hint+1] <= aX && aX <= x[hint+2])
+            return ++hint;
+    }
+
+    // Do a binary search to find which two points the abscissa is between.
+    int i = 0;
+    int j = n-1;
+    while (j - i > 1)
+    {
+        int k = (i+j)/2;
+        if (aX < x[k])
+            j = k;
+        else
+            i = k;
+    }
+    hint = i;
+    return i;
+}
+
 double Function::calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const
 {
     if (_function == NULL)
@@ -102,6 +102,25 @@ public:
      *          its size must equal the value returned by getArgumentSize().
      */
     virtual double calcValue(const SimTK::Vector& x) const;
+    /**
+     * Calculate the value of this function of a single input argument. This
+     * avoids constructing a SimTK::Vector for the argument. The default
+     * implementation calls calcValue(const SimTK::Vector&); subclasses that
+     * are functions of one variable should override it.
+     */
+    virtual double calcValue(double x) const;
+    /**
+     * Same as calcValue(double), but for functions defined on intervals
+     * (e.g., splines), `hint` is the index of the interval in which to look
+     * for `x` first. On return, `hint` holds the index of the interval that
+     * contains `x`. When the function is evaluated repeatedly at increasing
+     * values of `x` (e.g., at the times of a simulation), passing the same
+     * hint to each call finds the interval in constant time instead of
+     * searching all intervals. Each caller should keep its own hint; any
+     * initial value (e.g., 0) is valid. The default implementation ignores
+     * the hint.
+     */
+    virtual double calcValue(double x, int& hint) const;
     /**
      * Calculate a partial derivative of this function at a particular point.  Which derivative to take is specified
      * by listing the input components with which to take it.  For example, if derivComponents=={0}, that indicates
@@ -135,6 +154,14 @@ protected:
      */
     void resetFunction();
 
+    /**
+     * Find the index k of the interval [x[k], x[k+1]] that contains aX, for
+     * sorted abscissae x of size n >= 2, with x[0] <= aX <= x[n-1]. The
+     * interval `hint` and the one after it are checked before resorting to a
+     * binary search; `hint` is updated to the returned index.
+     */
+    static int findInterval(const double* x, int n, double aX, int& hint);
+
 //=============================================================================
 };  // END class Function
 
@@ -54,6 +54,7 @@ protected:
 //=============================================================================
 public:
     FunctionAdapter(const OpenSim::Function &aFunction);
+    using Function::calcValue;
     double calcValue(const SimTK::Vector& x) const override;
     double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const;
     double calcDerivative(const SimTK::Array_<int>& derivComponents, const SimTK::Vector& x) const override;
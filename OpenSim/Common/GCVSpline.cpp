@@ -32,6 +32,7 @@
 #include "Constant.h"
 #include "gcvspl.h"
 #include "XYFunctionInterface.h"
+#include <array>
 
 
 
@@ -580,6 +581,27 @@ addPoint(double aX, double aY)
     return i;
 }
 
+double GCVSpline::calcValue(double x) const {
+    if (_function == NULL)
+        _function = createSimTKFunction();
+    return static_cast<const SimTK::Spline*>(_function)->calcValue(x);
+}
+
+double GCVSpline::calcValue(double x, int& hint) const {
+    // The coefficients are computed along with the SimTK::Spline.
+    if (_function == NULL)
+        _function = createSimTKFunction();
+    // Workspace for the evaluation tableau: 2 * half order <= 8 (heptic).
+    std::array<double, 8> work;
+    OPENSIM_THROW_IF_FRMOBJ(2 * _halfOrder > (int)work.size(), Exception,
+            "Spline has unsupported degree {}.", getDegree());
+    // splder() checks the interval `hint` (1-based) and its neighbors before
+    // resorting to a binary search, and any value of `hint` is valid.
+    return splder(0, _halfOrder, _x.getSize(), x,
+            const_cast<double*>(&_x[0]),
+            const_cast<double*>(&_coefficients[0]), &hint, work.data());
+}
+
 SimTK::Function* GCVSpline::createSimTKFunction() const {
     int degree = _halfOrder*2-1;
     Vector x(_x.getSize());
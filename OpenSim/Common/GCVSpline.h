@@ -109,6 +109,9 @@ protected:
     /** A workspace used when calculating derivatives of the spline. */
     mutable std::vector<int> _workDeriv;
 
+    // GCVSplineSet::evaluateAll() evaluates the spline coefficients directly.
+    friend class GCVSplineSet;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -233,6 +236,15 @@ public:
     //--------------------------------------------------------------------------
     // EVALUATION
     //--------------------------------------------------------------------------
+    using Function::calcValue;
+    /** Evaluate the underlying SimTK::Spline without constructing a
+    SimTK::Vector for the argument. */
+    double calcValue(double x) const override;
+    /** Evaluate the spline from its coefficients (see getCoefficients()),
+    starting the search for the knot interval that contains `x` at `hint`
+    (see Function::calcValue(double, int&)). The result equals that of
+    calcValue(double) up to roundoff. */
+    double calcValue(double x, int& hint) const override;
 
 //=============================================================================
 };  // END class GCVSpline
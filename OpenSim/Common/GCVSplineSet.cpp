@@ -24,10 +24,65 @@
 #include "GCVSplineSet.h"
 #include "GCVSpline.h"
 #include "Storage.h"
+#include "gcvspl.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <thread>
 
 
 using namespace OpenSim;
 
+namespace {
+// Each thread fits splines with at least this many data points in total, so
+// that small sets are not slowed down by starting threads.
+const int minNumPointsPerThread = 10000;
+
+// Call func(i) for i = 0, ..., count-1, split into contiguous blocks across
+// up to numThreads threads (0 for the number of hardware threads). The
+// calling thread processes the first block. Exceptions are rethrown once all
+// threads are done.
+void forEachInParallel(int count, int numPointsEach, int numThreads,
+        const std::function<void(int)>& func) {
+    if (numThreads <= 0)
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    numThreads = std::min(numThreads, count);
+    numThreads = std::min(numThreads, std::max(1,
+            (int)((long long)count * numPointsEach / minNumPointsPerThread)));
+    if (numThreads <= 1) {
+        for (int i = 0; i < count; ++i) func(i);
+        return;
+    }
+    std::vector<std::exception_ptr> errors(numThreads);
+    auto processBlock = [&](int thread) {
+        try {
+            const int end = (int)((long long)count*(thread+1)/numThreads);
+            for (int i = (int)((long long)count*thread/numThreads); i < end;
+                    ++i)
+                func(i);
+        } catch(...) {
+            errors[thread] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int thread=1;thread<numThreads;thread++)
+        threads.emplace_back(processBlock,thread);
+    processBlock(0);
+    for(auto& thread : threads) thread.join();
+    for(const auto& error : errors)
+        if(error) std::rethrow_exception(error);
+}
+
+// Same knots (and thus same number of data points).
+bool haveSameKnots(const Array<double>& x1, const Array<double>& x2) {
+    return x1.getSize() == x2.getSize() &&
+           std::equal(x1.get(), x1.get() + x1.getSize(), x2.get());
+}
+} // namespace
+
 GCVSplineSet::~GCVSplineSet() {
     // No operation;
 }
@@ -59,7 +114,8 @@ GCVSplineSet::GCVSplineSet(int aDegree,
 GCVSplineSet::GCVSplineSet(const TimeSeriesTable& table,
                            const std::vector<std::string>& labels,
                            int degree,
-                           double errorVariance) {
+                           double errorVariance,
+                           int numThreads) {
     const auto& time = table.getIndependentColumn();
     auto labelsToUse = labels;
     if (labelsToUse.empty()) labelsToUse = table.getColumnLabels();
@@ -68,6 +124,7 @@ GCVSplineSet::GCVSplineSet(const TimeSeriesTable& table,
         adoptAndAppend(new GCVSpline(degree, column.size(), time.data(),
                                      &column[0], label, errorVariance));
     }
+    fitSplines(numThreads);
 }
 
 void GCVSplineSet::setNull() {
@@ -118,8 +175,6 @@ void GCVSplineSet::construct(int aDegree,
         // CONSTRUCT SPLINE
         //printf("%s\t",name);
         spline = new GCVSpline(aDegree,nData,times,data,name,aErrorVariance);
-        SimTK::Function* fp = spline->createSimTKFunction();
-        delete fp;  
 
         // ADD SPLINE
         adoptAndAppend(spline);
@@ -129,6 +184,83 @@ void GCVSplineSet::construct(int aDegree,
     // CLEANUP
     if(times!=NULL) delete[] times;
     if(data!=NULL) delete[] data;
+
+    // FIT THE SPLINES
+    fitSplines(0);
+}
+
+void GCVSplineSet::fitSplines(int aNumThreads) {
+    // Splines that share the factorization with the first of them, and
+    // splines that are fit individually. Splines without enough data points
+    // (see GCVSpline's constructor) or whose knots are not strictly increasing
+    // are left to be fit on first use.
+    std::vector<GCVSpline*> shared, individual;
+    for(int i=0;i<getSize();i++) {
+        GCVSpline* spline = getGCVSpline(i);
+        if(spline==NULL || spline->_function!=NULL) continue;
+        const Array<double>& x = spline->_x;
+        const int n = x.getSize();
+        if(n==0 || n < 2*spline->_halfOrder) continue;
+        if(std::adjacent_find(x.get(), x.get() + n,
+                std::greater_equal<double>()) != x.get() + n) continue;
+        if(spline->_errorVariance==0.0 && (shared.empty() ||
+                (spline->_halfOrder==shared[0]->_halfOrder &&
+                 haveSameKnots(x, shared[0]->_x))))
+            shared.push_back(spline);
+        else
+            individual.push_back(spline);
+    }
+
+    if(!shared.empty()) {
+        // Interpolating splines: the coefficients solve (B + p*W^-1*E) c = y
+        // with p = 0 (see gcvspl() and splc() in gcvspl.c), and the banded
+        // matrix depends only on the knots and the degree.
+        const GCVSpline& first = *shared[0];
+        const int m = first._halfOrder;
+        const int n = first._x.getSize();
+        const int nm2p1 = n*(2*m+1);
+        const int nm2m1 = n*(2*m-1);
+        // Same layout as the work array of gcvspl(): 6 statistics, then BWE,
+        // B and WE.
+        std::vector<double> wk(6 + nm2p1 + nm2m1 + nm2p1);
+        double* bwe = &wk[6];
+        double* b = bwe + nm2p1;
+        double* we = b + nm2m1;
+        std::vector<double> x(first._x.get(), first._x.get() + n);
+        std::vector<double> w(n, 1.0);
+        double bl, el;
+        basis(m, n, x.data(), b, &bl, bwe);
+        prep(m, n, x.data(), w.data(), we, &el);
+        el /= bl;
+        // splc() uses this value of p when p*el is below eps.
+        const double dp = 1e-15/el;
+        for(int i=1;i<=n;i++) {
+            const int km = std::max(-m, 1-i);
+            const int kp = std::min(m, n-i);
+            for(int k=km;k<=kp;k++) {
+                bwe[(i-1)*(2*m+1)+k+m] = dp*we[(i-1)*(2*m+1)+k+m];
+                if(std::abs(k)!=m)
+                    bwe[(i-1)*(2*m+1)+k+m] += b[(i-1)*(2*m-1)+k+m-1];
+            }
+        }
+        bandet(bwe, m, n);
+
+        const SimTK::Vector knots(n, x.data());
+        forEachInParallel((int)shared.size(), n, aNumThreads,
+                [&](int i) {
+            GCVSpline& spline = *shared[i];
+            bansol(bwe, &spline._y[0], &spline._coefficients[0], m, n);
+            spline._function = new SimTK::Spline(2*m-1, knots,
+                    SimTK::Vector(n, &spline._coefficients[0]));
+        });
+    }
+
+    forEachInParallel((int)individual.size(),
+            individual.empty() ? 0 : individual[0]->_x.getSize(), aNumThreads,
+            [&](int i) {
+        GCVSpline& spline = *individual[i];
+        spline._function = spline.createSimTKFunction();
+    });
 }
 
 GCVSpline* GCVSplineSet::getGCVSpline(int aIndex) const {
@@ -136,6 +268,41 @@ GCVSpline* GCVSplineSet::getGCVSpline(int aIndex) const {
     return(&func);
 }
 
+void GCVSplineSet::evaluateAll(
+        double aX, int aDerivOrder, SimTK::Vector& rValues) const {
+    int hint = 1;
+    evaluateAll(aX, aDerivOrder, rValues, hint);
+}
+
+void GCVSplineSet::evaluateAll(double aX, int aDerivOrder,
+        SimTK::Vector& rValues, int& hint) const {
+    OPENSIM_THROW_IF_FRMOBJ(aDerivOrder < 0, Exception,
+            "Expected the derivative order to be non-negative, but got {}.",
+            aDerivOrder);
+    const int n = getSize();
+    if (rValues.size() != n) rValues.resize(n);
+
+    // Interval index shared by all splines. Each search starts from the
+    // interval found for the previous spline, which is the correct interval
+    // if the knots are the same.
+    int& interval = hint;
+    // Workspace for the evaluation tableau: 2 * half order <= 8 (heptic).
+    std::array<double, 8> work;
+    for (int i = 0; i < n; ++i) {
+        const GCVSpline& spline = *getGCVSpline(i);
+        // The coefficients are computed along with the SimTK::Spline.
+        if (spline._function == NULL)
+            spline._function = spline.createSimTKFunction();
+        OPENSIM_THROW_IF_FRMOBJ(2 * spline._halfOrder > (int)work.size(),
+                Exception, "Spline '{}' has unsupported degree {}.",
+                spline.getName(), spline.getDegree());
+        rValues[i] = splder(aDerivOrder, spline._halfOrder,
+                spline._x.getSize(), aX, const_cast<double*>(&spline._x[0]),
+                const_cast<double*>(&spline._coefficients[0]), &interval,
+                work.data());
+    }
+}
+
 Storage* GCVSplineSet::constructStorage(int aDerivOrder,double aDX) {
     if(aDerivOrder<0) return(NULL);
     if(getSize()<=0) return(NULL);
@@ -187,13 +354,15 @@ Storage* GCVSplineSet::constructStorage(int aDerivOrder,double aDX) {
     store->setColumnLabels(labels);
 
     // SET STATES
-    Array<double> y(0.0,n);
+    SimTK::Vector y(n, 0.0);
+    // The rows are evaluated at increasing values of x.
+    int hint = 1;
 
     // LOOP THROUGH THE DATA
     // constant increments
     if(aDX>0.0) {
         for(double x=getMinX(); x<=getMaxX(); x+=aDX) {
-            evaluate(y,aDerivOrder,x);
+            evaluateAll(x,aDerivOrder,y,hint);
             store->append(x,n,&y[0]);
         }
 
@@ -207,7 +376,7 @@ Storage* GCVSplineSet::constructStorage(int aDerivOrder,double aDX) {
             if(xOrig[ix]<getMinX()) continue;
             if(xOrig[ix]>getMaxX()) break;
 
-            evaluate(y,aDerivOrder,xOrig[ix]);
+            evaluateAll(xOrig[ix],aDerivOrder,y,hint);
             store->append(xOrig[ix],n,&y[0]);
         }
     }
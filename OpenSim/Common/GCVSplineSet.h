@@ -100,13 +100,23 @@ public:
      * the error variance assumed for each column in the TimeSeriesTable.  If 
      * different variances should be set for the various columns, you will need 
      * to construct each GCVSpline individually.
+     * @param numThreads Maximum number of threads used to fit the splines (0
+     * for the number of hardware threads).
+     *
+     * The splines are fit upon construction, in parallel across columns.
+     * Since all columns share the same knots (the time column), the
+     * interpolating splines (errorVariance = 0) reuse a single factorization
+     * of the banded spline system; only a back substitution remains for each
+     * column. If the time column is not strictly increasing, the splines are
+     * left to be fit on first use.
      * @see TimeSeriesTable.
      * @see GCVSpline
      */
     GCVSplineSet(const TimeSeriesTable& table,
                  const std::vector<std::string>& labels = {},
                  int degree                             = 5,
-                 double errorVariance                   = 0.0);
+                 double errorVariance                   = 0.0,
+                 int numThreads                         = 0);
     virtual ~GCVSplineSet();
 
 private:
@@ -125,6 +135,14 @@ private:
      */
     void construct(int aDegree,const Storage *aStore,double aErrorVariance);
 
+    /**
+     * Fit all splines in the set that have not been fit yet, using up to
+     * aNumThreads threads (0 for the number of hardware threads). Splines
+     * with an error variance of 0 and the same knots and degree share the
+     * factorization of the banded spline system.
+     */
+    void fitSplines(int aNumThreads);
+
 public:
     /**
      * Get the function at a specified index.
@@ -137,6 +155,32 @@ public:
     double getMinX() const;
     double getMaxX() const;
 
+    /**
+     * Evaluate all splines in the set (or a derivative of them) at the same
+     * value of the independent variable. This is equivalent to calling
+     * calcValue() or calcDerivative() on each spline, but the search for the
+     * interval containing aX is shared across splines: for splines with
+     * identical knots (e.g., splines constructed from the columns of the same
+     * table), the interval is found once rather than once per spline.
+     *
+     * @param aX Value of the independent variable.
+     * @param aDerivOrder Derivative order: 0 evaluates the splines, 1
+     * evaluates their first derivative, etc.
+     * @param rValues One value per spline, in the order of the set. Resized if
+     * necessary.
+     */
+    void evaluateAll(double aX, int aDerivOrder, SimTK::Vector& rValues) const;
+    /**
+     * Same as evaluateAll(double, int, SimTK::Vector&), but the search for
+     * the interval containing aX starts at the knot interval `hint`, which is
+     * updated to the interval that contains aX. When the splines are
+     * evaluated at increasing values of aX (e.g., to resample them), passing
+     * the same hint to each call finds the interval in constant time. Any
+     * initial value is valid.
+     */
+    void evaluateAll(double aX, int aDerivOrder, SimTK::Vector& rValues,
+            int& hint) const;
+
     /**
      * Construct a storage object (see Storage) for this spline set or for 
      * some derivative of this spline set.
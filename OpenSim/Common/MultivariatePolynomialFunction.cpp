@@ -20,8 +20,66 @@
 
 #include "Exception.h"
 
+#include <algorithm>
+#include <array>
+
 using namespace OpenSim;
 
+namespace {
+/// The number of coefficients (terms) of a polynomial of the given order in
+/// numVariables variables: (order + numVariables) choose numVariables.
+inline int calcNumCoefficients(int numVariables, int order) {
+    int num = 1;
+    for (int i = 1; i <= numVariables; ++i) num = num * (order + i) / i;
+    return num;
+}
+
+/// Evaluate a polynomial of the given order in the M variables x[0..M-1]
+/// with the coefficients c, which are ordered as described for
+/// MultivariatePolynomialFunction. This uses a multivariate Horner scheme,
+///     p(x) = P_0(x') + x_0 (P_1(x') + x_0 (P_2(x') + ...)),
+/// where P_a is the polynomial of order (order - a) in the remaining
+/// variables x' and its coefficients are the a-th block of c. If
+/// WithGradient is true, the partial derivatives are computed in the same
+/// pass and written to gradient[0..M-1].
+template <typename T, int M, bool WithGradient>
+struct Horner {
+    static T evaluate(const T* x, int order, const T* c, T* gradient) {
+        T value = 0;
+        T subGradient[M - 1];
+        if (WithGradient) std::fill(gradient, gradient + M, T(0));
+        // Visit the blocks from the highest power of x_0 to the lowest.
+        int offset = calcNumCoefficients(M, order);
+        for (int a = order; a >= 0; --a) {
+            offset -= calcNumCoefficients(M - 1, order - a);
+            const T sub = Horner<T, M - 1, WithGradient>::evaluate(
+                    x + 1, order - a, c + offset, subGradient);
+            if (WithGradient) {
+                gradient[0] = gradient[0] * x[0] + value;
+                for (int j = 0; j < M - 1; ++j)
+                    gradient[j + 1] = gradient[j + 1] * x[0] + subGradient[j];
+            }
+            value = value * x[0] + sub;
+        }
+        return value;
+    }
+};
+
+template <typename T, bool WithGradient>
+struct Horner<T, 1, WithGradient> {
+    static T evaluate(const T* x, int order, const T* c, T* gradient) {
+        T value = c[order];
+        T derivative = 0;
+        for (int k = order - 1; k >= 0; --k) {
+            if (WithGradient) derivative = derivative * x[0] + value;
+            value = value * x[0] + c[k];
+        }
+        if (WithGradient) gradient[0] = derivative;
+        return value;
+    }
+};
+} // namespace
+
 template <class T>
 class SimTKMultivariatePolynomial : public SimTK::Function_<T> {
 public:
@@ -32,137 +90,33 @@ public:
                 "Expected dimension >= 0 && <=4 but got {}.", dimension);
         OPENSIM_THROW_IF(order < 0, Exception,
                 "Expected order >= 0 but got {}.", order);
-        std::array<int, 4> nq{{0, 0, 0, 0}};
-        int coeff_nr = 0;
-        for (nq[0] = 0; nq[0] < order + 1; ++nq[0]) {
-            int nq2_s;
-            if (dimension < 2)
-                nq2_s = 0;
-            else
-                nq2_s = order - nq[0];
-            for (nq[1] = 0; nq[1] < nq2_s + 1; ++nq[1]) {
-                int nq3_s;
-                if (dimension < 3)
-                    nq3_s = 0;
-                else
-                    nq3_s = order - nq[0] - nq[1];
-                for (nq[2] = 0; nq[2] < nq3_s + 1; ++nq[2]) {
-                    int nq4_s;
-                    if (dimension < 4)
-                        nq4_s = 0;
-                    else
-                        nq4_s = order - nq[0] - nq[1] - nq[2];
-                    for (nq[3] = 0; nq[3] < nq4_s + 1; ++nq[3]) { ++coeff_nr; }
-                }
-            }
-        }
+        // With dimension 0, there is one coefficient per order.
+        const int coeff_nr = dimension == 0
+                ? order + 1 : calcNumCoefficients(dimension, order);
         OPENSIM_THROW_IF(coefficients.size() != coeff_nr, Exception,
                 "Expected {} coefficients but got {}.", coeff_nr,
                 coefficients.size());
     }
     T calcValue(const SimTK::Vector& x) const override {
-        std::array<int, 4> nq{{0, 0, 0, 0}};
-        T value = static_cast<T>(0);
-        int coeff_nr = 0;
-        for (nq[0] = 0; nq[0] < order + 1; ++nq[0]) {
-            int nq2_s;
-            if (dimension < 2)
-                nq2_s = 0;
-            else
-                nq2_s = order - nq[0];
-            for (nq[1] = 0; nq[1] < nq2_s + 1; ++nq[1]) {
-                int nq3_s;
-                if (dimension < 3)
-                    nq3_s = 0;
-                else
-                    nq3_s = order - nq[0] - nq[1];
-                for (nq[2] = 0; nq[2] < nq3_s + 1; ++nq[2]) {
-                    int nq4_s;
-                    if (dimension < 4)
-                        nq4_s = 0;
-                    else
-                        nq4_s = order - nq[0] - nq[1] - nq[2];
-                    for (nq[3] = 0; nq[3] < nq4_s + 1; ++nq[3]) {
-                        T valueP = static_cast<T>(1);
-                        for (int i = 0; i < dimension; ++i) {
-                            valueP *= std::pow(x[i], nq[i]);
-                        }
-                        value += valueP * coefficients[coeff_nr];
-                        ++coeff_nr;
-                    }
-                }
-            }
-        }
+        return evaluate<false>(x, nullptr);
+    }
+    /// Compute the value and all first derivatives in a single pass.
+    T calcValueAndGradient(const SimTK::Vector& x,
+            SimTK::Vector_<T>& gradient) const {
+        std::array<T, 4> grad;
+        const T value = evaluate<true>(x, grad.data());
+        gradient.resize(dimension);
+        for (int i = 0; i < dimension; ++i) gradient[i] = grad[i];
         return value;
     }
     T calcDerivative(const SimTK::Array_<int>& derivComponent,
             const SimTK::Vector& x) const override {
-        std::array<int, 4> nq{{0, 0, 0, 0}};
-        T value = static_cast<T>(0);
-        int nqNonNegative;
-        int coeff_nr = 0;
-        for (nq[0] = 0; nq[0] < order + 1; ++nq[0]) {
-            int nq2_s;
-            if (dimension < 2)
-                nq2_s = 0;
-            else
-                nq2_s = order - nq[0];
-            for (nq[1] = 0; nq[1] < nq2_s + 1; ++nq[1]) {
-                int nq3_s;
-                if (dimension < 3)
-                    nq3_s = 0;
-                else
-                    nq3_s = order - nq[0] - nq[1];
-                for (nq[2] = 0; nq[2] < nq3_s + 1; ++nq[2]) {
-                    int nq4_s;
-                    if (dimension < 4)
-                        nq4_s = 0;
-                    else
-                        nq4_s = order - nq[0] - nq[1] - nq[2];
-                    for (nq[3] = 0; nq[3] < nq4_s + 1; ++nq[3]) {
-                        if (derivComponent[0] == 0) {
-                            nqNonNegative = nq[0] - 1;
-                            if (nqNonNegative < 0) nqNonNegative = 0;
-                            T valueP = nq[0] * std::pow(x[0], nqNonNegative);
-                            for (int i = 0; i < dimension; ++i) {
-                                if (i == derivComponent[0]) continue;
-                                valueP *= std::pow(x[i], nq[i]);
-                            }
-                            value += valueP * coefficients[coeff_nr];
-                        } else if (derivComponent[0] == 1) {
-                            nqNonNegative = nq[1] - 1;
-                            if (nqNonNegative < 0) nqNonNegative = 0;
-                            T valueP = nq[1] * std::pow(x[1], nqNonNegative);
-                            for (int i = 0; i < dimension; ++i) {
-                                if (i == derivComponent[0]) continue;
-                                valueP *= std::pow(x[i], nq[i]);
-                            }
-                            value += valueP * coefficients[coeff_nr];
-                        } else if (derivComponent[0] == 2) {
-                            nqNonNegative = nq[2] - 1;
-                            if (nqNonNegative < 0) nqNonNegative = 0;
-                            T valueP = nq[2] * std::pow(x[2], nqNonNegative);
-                            for (int i = 0; i < dimension; ++i) {
-                                if (i == derivComponent[0]) continue;
-                                valueP *= std::pow(x[i], nq[i]);
-                            }
-                            value += valueP * coefficients[coeff_nr];
-                        } else if (derivComponent[0] == 3) {
-                            nqNonNegative = nq[3] - 1;
-                            if (nqNonNegative < 0) nqNonNegative = 0;
-                            T valueP = nq[3] * std::pow(x[3], nqNonNegative);
-                            for (int i = 0; i < dimension; ++i) {
-                                if (i == derivComponent[0]) continue;
-                                valueP *= std::pow(x[i], nq[i]);
-                            }
-                            value += valueP * coefficients[coeff_nr];
-                        }
-                        ++coeff_nr;
-                    }
-                }
-            }
-        }
-        return value;
+        // The polynomial does not depend on components beyond its dimension.
+        if (derivComponent[0] < 0 || derivComponent[0] >= dimension)
+            return static_cast<T>(0);
+        std::array<T, 4> grad;
+        evaluate<true>(x, grad.data());
+        return grad[derivComponent[0]];
     }
     int getArgumentSize() const override { return dimension; }
     int getMaxDerivativeOrder() const override { return 1; }
@@ -175,6 +129,31 @@ public:
     }
 
 private:
+    /// Dispatch to the Horner kernel for this dimension.
+    template <bool WithGradient>
+    T evaluate(const SimTK::Vector& x, T* gradient) const {
+        std::array<T, 4> xc;
+        for (int i = 0; i < dimension; ++i) xc[i] = x[i];
+        const T* c = &coefficients[0];
+        switch (dimension) {
+        case 1:
+            return Horner<T, 1, WithGradient>::evaluate(
+                    xc.data(), order, c, gradient);
+        case 2:
+            return Horner<T, 2, WithGradient>::evaluate(
+                    xc.data(), order, c, gradient);
+        case 3:
+            return Horner<T, 3, WithGradient>::evaluate(
+                    xc.data(), order, c, gradient);
+        case 4:
+            return Horner<T, 4, WithGradient>::evaluate(
+                    xc.data(), order, c, gradient);
+        default:
+            // Each term is a product of no inputs.
+            return coefficients.sum();
+        }
+    }
+
     SimTK::Vector_<T> coefficients;
     int dimension;
     int order;
@@ -184,3 +163,10 @@ SimTK::Function* MultivariatePolynomialFunction::createSimTKFunction() const {
     return new SimTKMultivariatePolynomial<SimTK::Real>(
             get_coefficients(), get_dimension(), getOrder());
 }
+
+double MultivariatePolynomialFunction::calcValueAndGradient(
+        const SimTK::Vector& x, SimTK::Vector& gradient) const {
+    if (_function == nullptr) _function = createSimTKFunction();
+    return static_cast<const SimTKMultivariatePolynomial<SimTK::Real>*>(
+            _function)->calcValueAndGradient(x, gradient);
+}
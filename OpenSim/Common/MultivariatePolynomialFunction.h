@@ -25,7 +25,8 @@ namespace OpenSim {
 
 /** A multivariate polynomial function.
 This implementation assumes a maximum of four input dimensions and allows
-computation of first-order derivatives only.
+computation of first-order derivatives only. The polynomial is evaluated with
+a multivariate Horner scheme, specialized for each number of dimensions.
 @param coefficients the polynomial coefficients in order of ascending
 powers starting from the last dependent component.
 For a polynomial of third order dependent on three components
@@ -95,6 +96,14 @@ public:
     /// Get order
     int getOrder() const { return get_order(); }
 
+    /// Calculate the value of the polynomial and its gradient (the first
+    /// derivatives with respect to each of the getDimension() inputs) in a
+    /// single pass. This is cheaper than calling calcValue() and
+    /// calcDerivative() for each input separately. The gradient is resized
+    /// if necessary.
+    double calcValueAndGradient(
+            const SimTK::Vector& x, SimTK::Vector& gradient) const;
+
     /// Return function
     SimTK::Function* createSimTKFunction() const override;
 
@@ -114,6 +114,7 @@ public:
     //--------------------------------------------------------------------------
     virtual double evaluateTotalFirstDerivative(double aX,double aDxdt) const;
     virtual double evaluateTotalSecondDerivative(double aX,double aDxdt,double aD2xdt2) const;
+    using Function::calcValue;
     double calcValue(const SimTK::Vector& x) const override;
     double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const override;
     int getArgumentSize() const override;
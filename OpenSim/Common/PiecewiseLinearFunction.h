@@ -115,6 +115,8 @@ public:
     // EVALUATION
     //--------------------------------------------------------------------------
     double calcValue(const SimTK::Vector& x) const override;
+    double calcValue(double x) const override;
+    double calcValue(double x, int& hint) const override;
     double calcDerivative(const std::vector<int>& derivComponents, const SimTK::Vector& x) const override;
     int getArgumentSize() const override;
     int getMaxDerivativeOrder() const override;
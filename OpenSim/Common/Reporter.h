@@ -24,6 +24,7 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include <OpenSim/Common/Component.h>
+#include <OpenSim/Common/TableFileWriter.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
 
 namespace OpenSim {
@@ -189,8 +190,10 @@ public:
 
     /** Clear the report. This can be used for example in loops performing 
     simulation. Each new iteration should start with an empty report and so this
-    function can be used to clear the report at the end of each iteration.    */
+    function can be used to clear the report at the end of each iteration.
+    The output file, if any, is closed (see setOutputFileName()).            */
     void clearTable() {
+        closeOutputFile();
         std::vector<std::string> columnLabels;
         // Handle the case where no outputs were connected to the reporter.
         if (_outputTable.hasColumnLabels()) {
@@ -202,6 +205,43 @@ public:
         }
     }
 
+    /** Allocate memory for the given number of rows in the report, if the
+    number of reported time steps is known in advance. This avoids
+    reallocating the report as the table grows. Call this after clearTable(),
+    which releases the memory.                                                */
+    void reserve(size_t numRows) {
+        _outputTable.reserve(numRows);
+    }
+
+    /** Also write the report to a file while it is being recorded, so that
+    the rows are not lost if the simulation does not finish. The file is
+    written with a TableFileWriter (STO format, or CSV if the file name ends
+    with ".csv"), optionally in a background thread. The file is created when
+    the next row is reported and then holds the same rows as getTable(). The
+    file is complete once closeOutputFile() or clearTable() is called, or the
+    reporter is destroyed; reporting after that overwrites the file. Pass an
+    empty file name to stop writing to a file. The file name is not copied
+    with the reporter.
+    @throws Exception If ValueT is not supported by STOFileAdapter_.        */
+    void setOutputFileName(const std::string& fileName,
+                           bool useBackgroundThread = false) {
+        OPENSIM_THROW_IF_FRMOBJ(!fileName.empty() &&
+                !IsTableFileWriterElementType<ValueT>::value, Exception,
+                "Cannot write tables of this element type to a file.");
+        closeOutputFile();
+        _outputFileName = fileName;
+        _useBackgroundThread = useBackgroundThread;
+    }
+    const std::string& getOutputFileName() const { return _outputFileName; }
+
+    /** Write the remaining rows to the output file, if any, and close it.   */
+    void closeOutputFile() {
+        if (!_outputWriter) return;
+        // Release the writer even if closing throws.
+        std::unique_ptr<TableFileWriter> writer(std::move(_outputWriter));
+        writer->close();
+    }
+
 protected:
     void implementReport(const SimTK::State& state) const override {
         const auto& input = this->template getInput<InputT>("inputs");
@@ -223,6 +263,10 @@ protected:
                           "a loop, use clearTable() to clear table at the end "
                           "of each loop.\n\n" + std::string{exception.what()});
         }
+        if (!_outputFileName.empty()) {
+            const_cast<Self*>(this)->writeLastRowToOutputFile(
+                    typename IsTableFileWriterElementType<ValueT>::type());
+        }
     }
 
     void extendFinalizeConnections(Component& root) override {
@@ -246,11 +290,28 @@ protected:
     }
 
 private:
+    // Write the most recent row of the table to the output file, creating the
+    // file (with all rows of the table) if necessary.
+    void writeLastRowToOutputFile(std::true_type) {
+        if (!_outputWriter) {
+            _outputWriter.reset(new TableFileWriter(_outputFileName,
+                    _outputTable, _useBackgroundThread));
+            return;
+        }
+        const size_t last = _outputTable.getNumRows() - 1;
+        _outputWriter->appendRow(_outputTable.getIndependentColumn()[last],
+                                 _outputTable.getRowAtIndex(last));
+    }
+    void writeLastRowToOutputFile(std::false_type) {}
 
     // Hold the output values in a table with values as columns and time rows
     // We write to this table in const methods, but only because we ensure
     // those const methods are never called with trial integrator states.
     TimeSeriesTable_<ValueT> _outputTable;
+
+    SimTK::ResetOnCopy<std::string> _outputFileName;
+    bool _useBackgroundThread = false;
+    SimTK::ResetOnCopy<std::unique_ptr<TableFileWriter>> _outputWriter;
 };
 
 /** A reporter that simply prints quantities to the console
@@ -361,6 +422,8 @@ inline void TableReporter_<SimTK::Vector, SimTK::Real>::
 
     const_cast<Self*>(this)->_outputTable.appendRow(state.getTime(), 
                                                     (~result).getAsRowVector());
+    if (!_outputFileName.empty())
+        const_cast<Self*>(this)->writeLastRowToOutputFile(std::true_type());
 }
 
 /** @name Commonly used concrete TableReporters */
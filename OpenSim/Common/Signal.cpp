@@ -37,9 +37,112 @@
 #include "simmath/internal/Spline.h"
 #include "simmath/internal/SplineFitter.h"
 
+#include <algorithm>
+#include <exception>
+#include <thread>
+
 using namespace OpenSim;
 using namespace std;
 
+namespace {
+
+// Compute the coefficients of the 3rd order Butterworth filter used by
+// LowpassIIR(). fc is lowered if it is not less than half the sample
+// frequency.
+void calcLowpassIIRCoefficients(double T, double& fc, double a[4], double b[4])
+{
+    // CHECK THAT THE CUTOFF FREQUENCY IS LESS THAN HALF THE SAMPLE FREQUENCY
+    double fs = 1 / T;
+    if (fc >= 0.5 * fs) {
+        fc = 0.49 * fs;
+        log_warn("Cutoff frequency should be less than half sample frequency. "
+                 "Changing the cutoff frequency to 0.49*(Sample Frequency)..."
+                 "cutoff = {}", fc);
+    }
+
+    // INITIALIZE SOME VARIABLES
+    double wc = 2*SimTK_PI*fc;
+
+    // CALCULATE THE FREQUENCY WARPING
+    double wa = tan(wc*T/2.0);
+    double wa2 = wa*wa;
+    double wa3 = wa*wa*wa;
+
+    // GET COEFFICIENTS FOR THE FILTER
+    double denom = (wa+1) * (wa*wa + wa + 1.0);
+    a[0] = wa3 / denom;
+    a[1] = 3*wa3 / denom;
+    a[2] = 3*wa3 / denom;
+    a[3] = wa3 / denom;
+    b[0] = 1;
+    b[1] = (3*wa3 + 2*wa2 - 2*wa - 3) / denom;
+    b[2] = (3*wa3 - 2*wa2 - 2*wa + 3) / denom;
+    b[3] = (wa - 1) * (wa2 - wa + 1) / denom;
+}
+
+// Number of signals filtered together by the multi-signal LowpassIIR(). The
+// signals of a block are interleaved (point i of all signals is contiguous),
+// and the innermost loops run over this fixed number of signals so that the
+// compiler can vectorize them.
+const int lowpassIIRBlockSize = 8;
+
+// Filter the signals [begin, end) with LowpassIIR(). The operations for each
+// signal are the same as in the single-signal LowpassIIR(), in the same order.
+void lowpassIIRSignals(const double a[4], const double b[4], int N,
+        const std::vector<const double*>& sig, const std::vector<double*>& sigf,
+        int begin, int end)
+{
+    const int L = lowpassIIRBlockSize;
+    std::vector<double> x((size_t)N * L);
+    std::vector<double> y((size_t)N * L);
+    for (int first = begin; first < end; first += L) {
+        const int numSignals = std::min(L, end - first);
+
+        // INTERLEAVE THE SIGNALS (UNUSED SIGNALS OF THE BLOCK ARE ZERO)
+        for (int l = 0; l < L; ++l) {
+            if (l < numSignals) {
+                const double* s = sig[first + l];
+                for (int i = 0; i < N; ++i) x[(size_t)i*L + l] = s[i];
+            } else {
+                for (int i = 0; i < N; ++i) x[(size_t)i*L + l] = 0;
+            }
+        }
+
+        // FILTER FORWARD; THE 1ST THREE TERMS ARE NOT FILTERED
+        for (int i = 0; i < 3*L; ++i) y[i] = x[i];
+        for (int i = 3; i < N; ++i) {
+            const double* x0 = &x[(size_t)i*L];
+            double* y0 = &y[(size_t)i*L];
+            for (int l = 0; l < L; ++l) {
+                y0[l] = a[0]*x0[l] + a[1]*x0[l-L] + a[2]*x0[l-2*L]
+                        + a[3]*x0[l-3*L]
+                        - b[1]*y0[l-L] - b[2]*y0[l-2*L] - b[3]*y0[l-3*L];
+            }
+        }
+
+        // FILTER BACKWARD INTO x. THIS IS THE SAME AS REVERSING, FILTERING
+        // FORWARD AND REVERSING AGAIN.
+        for (int i = (N-3)*L; i < N*L; ++i) x[i] = y[i];
+        for (int i = N-4; i >= 0; --i) {
+            const double* y0 = &y[(size_t)i*L];
+            double* x0 = &x[(size_t)i*L];
+            for (int l = 0; l < L; ++l) {
+                x0[l] = a[0]*y0[l] + a[1]*y0[l+L] + a[2]*y0[l+2*L]
+                        + a[3]*y0[l+3*L]
+                        - b[1]*x0[l+L] - b[2]*x0[l+2*L] - b[3]*x0[l+3*L];
+            }
+        }
+
+        // DEINTERLEAVE
+        for (int l = 0; l < numSignals; ++l) {
+            double* s = sigf[first + l];
+            for (int i = 0; i < N; ++i) s[i] = x[(size_t)i*L + l];
+        }
+    }
+}
+
+} // anonymous namespace
+
 //=============================================================================
 // FILTERS
 //=============================================================================
@@ -161,8 +264,7 @@ int Signal::
 LowpassIIR(double T,double fc,int N,const double *sig,double *sigf)
 {
 int i,j;
-double fs/*,ws*/,wc,wa,wa2,wa3;
-double a[4],b[4],denom;
+double a[4],b[4];
 double *sigr;
 
     // ERROR CHECK
@@ -171,34 +273,7 @@ double *sigr;
     if(sig==NULL) return(-1);
     if(sigf==NULL) return(-1);
 
-    // CHECK THAT THE CUTOFF FREQUENCY IS LESS THAN HALF THE SAMPLE FREQUENCY
-    fs = 1 / T;
-    if (fc >= 0.5 * fs) {
-        fc = 0.49 * fs;
-        log_warn("Cutoff frequency should be less than half sample frequency. "
-                 "Changing the cutoff frequency to 0.49*(Sample Frequency)..."
-                 "cutoff = {}", fc);
-    }
-
-    // INITIALIZE SOME VARIABLES
-    //ws = 2*SimTK_PI*fs;
-    wc = 2*SimTK_PI*fc;
-
-    // CALCULATE THE FREQUENCY WARPING
-    wa = tan(wc*T/2.0);
-    wa2 = wa*wa;
-    wa3 = wa*wa*wa;
-
-    // GET COEFFICIENTS FOR THE FILTER
-    denom = (wa+1) * (wa*wa + wa + 1.0);
-    a[0] = wa3 / denom;
-    a[1] = 3*wa3 / denom;
-    a[2] = 3*wa3 / denom;
-    a[3] = wa3 / denom;
-    b[0] = 1;
-    b[1] = (3*wa3 + 2*wa2 - 2*wa - 3) / denom; 
-    b[2] = (3*wa3 - 2*wa2 - 2*wa + 3) / denom; 
-    b[3] = (wa - 1) * (wa2 - wa + 1) / denom;
+    calcLowpassIIRCoefficients(T,fc,a,b);
 
     // ALLOCATE MEMORY FOR sigr[]
     sigr = new double[N];
@@ -241,6 +316,71 @@ double *sigr;
   return(0);
 }
 
+//_____________________________________________________________________________
+/**
+ * 3rd ORDER LOWPASS IIR BUTTERWORTH DIGITAL FILTER FOR MULTIPLE SIGNALS
+ *
+ * See LowpassIIR() for a single signal.
+ *
+ *  @param T Sample interval in seconds.
+ *  @param fc Cutoff frequency in Hz.
+ *  @param N Number of data points in each signal.
+ *  @param sig The sampled signals.
+ *  @param sigf The filtered signals (may be the same as sig).
+ *  @param numThreads Maximum number of threads (0 for the number of hardware
+ *  threads).
+ *
+ * @return 0 on success, and -1 on failure.
+ */
+int Signal::
+LowpassIIR(double T,double fc,int N,const std::vector<const double*>& sig,
+        const std::vector<double*>& sigf,int numThreads)
+{
+    // ERROR CHECK
+    if(T==0) return(-1);
+    if(N<4) return(-1);
+    if(sig.size()!=sigf.size()) return(-1);
+    for(size_t i=0;i<sig.size();i++)
+        if(sig[i]==NULL || sigf[i]==NULL) return(-1);
+    if(sig.empty()) return(0);
+
+    double a[4],b[4];
+    calcLowpassIIRCoefficients(T,fc,a,b);
+
+    // DISTRIBUTE THE BLOCKS OF SIGNALS OVER THE THREADS. SMALL PROBLEMS ARE
+    // NOT WORTH THE OVERHEAD OF THREADS.
+    const int numSignals = (int)sig.size();
+    const int numBlocks =
+            (numSignals + lowpassIIRBlockSize - 1) / lowpassIIRBlockSize;
+    const long long minPointsPerThread = 100000;
+    if(numThreads<=0)
+        numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    numThreads = (int)std::max(1LL, std::min({(long long)numThreads,
+            (long long)numBlocks,
+            (long long)N * numSignals / minPointsPerThread}));
+
+    std::vector<std::exception_ptr> errors(numThreads);
+    auto filterBlocks = [&](int thread) {
+        const int begin = lowpassIIRBlockSize * (numBlocks*thread/numThreads);
+        const int end = std::min(numSignals,
+                lowpassIIRBlockSize * (numBlocks*(thread+1)/numThreads));
+        try {
+            lowpassIIRSignals(a,b,N,sig,sigf,begin,end);
+        } catch(...) {
+            errors[thread] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for(int thread=1;thread<numThreads;thread++)
+        threads.emplace_back(filterBlocks,thread);
+    filterBlocks(0);
+    for(auto& thread : threads) thread.join();
+    for(const auto& error : errors)
+        if(error) std::rethrow_exception(error);
+
+    return(0);
+}
+
 //-----------------------------------------------------------------------------
 // FIR
 //-----------------------------------------------------------------------------
@@ -280,18 +420,22 @@ LowpassFIR(int M,double T,double f,int N,double *sig,double *sigf)
     // CALCULATE THE ANGULAR CUTOFF FREQUENCY
     w = 2.0*SimTK_PI*f;
 
+    // COMPUTE THE COEFFICIENTS, WHICH ARE THE SAME FOR ALL POINTS
+    std::vector<double> coefs(M+M+1);
+    double sum_coef = 0.0;
+    for(k=-M;k<=M;k++) {
+        x = (double)k*w*T; // k*T = time (seconds) and w scales sinc input argument using filter cutoff
+        coefs[M+k] = (sinc(x)*T*w/SimTK_PI)*hamming(k,M); // scale lowpass sinc amplitude by 2*f*T = T*w/pi
+        sum_coef = sum_coef + coefs[M+k];
+    }
+
     // FILTER THE DATA
-    double sum_coef,coef;
     for(n=0;n<N;n++) {
-        sum_coef = 0.0;
-        sigf[n] = 0.0;
-        for(k=-M;k<=M;k++) {   
-            x = (double)k*w*T; // k*T = time (seconds) and w scales sinc input argument using filter cutoff
-            coef = (sinc(x)*T*w/SimTK_PI)*hamming(k,M); // scale lowpass sinc amplitude by 2*f*T = T*w/pi
-            sigf[n] = sigf[n] + coef*s[M+n-k]; 
-            sum_coef = sum_coef + coef;
+        double sum = 0.0;
+        for(k=-M;k<=M;k++) {
+            sum = sum + coefs[M+k]*s[M+n-k];
         }
-        sigf[n] = sigf[n] / sum_coef; // normalize for unity gain at DC
+        sigf[n] = sum / sum_coef; // normalize for unity gain at DC
     }
 
     // Filter check derived from http://www.dspguide.com/CH16.PDF
@@ -339,11 +483,9 @@ int Signal::
 BandpassFIR(int M,double T,double f1,double f2,int N,double *sig,
     double *sigf)
 {
-size_t size;
 int i,j;
 int n,k;
 double w1,w2,x1,x2;
-double *s;
 
 
     // CHECK THAT M IS NOT TOO LARGE RELATIVE TO N
@@ -355,13 +497,7 @@ double *s;
     }
 
     // ALLOCATE MEMORY FOR s
-    size = N + M + M;
-    s = (double *) calloc(size,sizeof(double));
-    if (s == NULL) {
-        log_error(
-                "lowpass() -> Not enough memory to process your sampled data.");
-        return(-1);
-    }
+    std::vector<double> s(N + M + M);
 
     // CALCULATE THE ANGULAR CUTOFF FREQUENCY
     w1 = 2*SimTK_PI*f1;
@@ -373,24 +509,25 @@ double *s;
     for (i=M+N,j=N-2;i<M+M+N;i++,j--)  s[i] = sig[j];
   
 
+    // COMPUTE THE COEFFICIENTS, WHICH ARE THE SAME FOR ALL POINTS
+    std::vector<double> coefs(M+M+1);
+    double sum_coef = 0.0;
+    for (k=-M;k<=M;k++) {
+        x1 = (double)k*w1*T;  // k*T = time (seconds) and w scales sinc input argument using filter cutoff
+        x2 = (double)k*w2*T;  // k*T = time (seconds) and w scales sinc input argument using filter cutoff
+        coefs[M+k] = (sinc(x2)*T*w2/SimTK_PI - sinc(x1)*T*w1/SimTK_PI)*hamming(k,M); // scale lowpass sinc amplitude by 2*f*T = T*w/pi
+        sum_coef = sum_coef + coefs[M+k];
+    }
+
     // FILTER THE DATA
-    double sum_coef,coef;
     for (n=0;n<N;n++) {
-        sum_coef = 0.0;
-        sigf[n] = 0.0;
-        for (k=-M;k<=M;k++) {   
-            x1 = (double)k*w1*T;  // k*T = time (seconds) and w scales sinc input argument using filter cutoff
-            x2 = (double)k*w2*T;  // k*T = time (seconds) and w scales sinc input argument using filter cutoff
-            coef = (sinc(x2)*T*w2/SimTK_PI - sinc(x1)*T*w1/SimTK_PI)*hamming(k,M); // scale lowpass sinc amplitude by 2*f*T = T*w/pi
-            sigf[n] = sigf[n] + coef*s[M+n-k];
-            sum_coef = sum_coef + coef;
+        double sum = 0.0;
+        for (k=-M;k<=M;k++) {
+            sum = sum + coefs[M+k]*s[M+n-k];
         }
-        sigf[n] = sigf[n] / sum_coef; // normalize for unity gain at DC
+        sigf[n] = sum / sum_coef; // normalize for unity gain at DC
     }
 
-    // CLEANUP
-    if(s!=NULL) delete s;
-
   return(0);
 }
 
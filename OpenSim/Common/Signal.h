@@ -64,6 +64,20 @@ public:
     static int
         LowpassIIR(double aDeltaT,double aCutOffFrequency,
         int aN,const double *aSignal,double *rFilteredSignal);
+    /// Same as LowpassIIR() above, but filters several signals with the same
+    /// number of points at once, e.g., the columns of a table. Signals are
+    /// filtered in interleaved blocks so that the filter recursion is
+    /// vectorized across signals, and the blocks are distributed over up to
+    /// aNumThreads threads (0 uses the number of hardware threads). The
+    /// results are the same as those of filtering each signal separately (to
+    /// within roundoff). rFilteredSignals[i] may equal aSignals[i].
+    ///
+    /// @return 0 on success, and -1 on failure (including aN < 4).
+    static int
+        LowpassIIR(double aDeltaT,double aCutOffFrequency,int aN,
+        const std::vector<const double*>& aSignals,
+        const std::vector<double*>& rFilteredSignals,
+        int aNumThreads = 1);
     static int
         LowpassFIR(int aOrder,double aDeltaT,double aCutoffFrequency,
         int aN,double *aSignal,double *rFilteredSignal);
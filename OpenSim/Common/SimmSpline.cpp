@@ -509,6 +509,17 @@ int SimmSpline::addPoint(double aX, double aY)
 }
 
 double SimmSpline::calcValue(const Vector& x) const
+{
+    return calcValue(x[0]);
+}
+
+double SimmSpline::calcValue(double aX) const
+{
+    int hint = -1;
+    return calcValue(aX, hint);
+}
+
+double SimmSpline::calcValue(double aX, int& hint) const
 {
     // NOT A NUMBER
     if(!_y.getSize()) return(SimTK::NaN);
@@ -516,11 +527,10 @@ double SimmSpline::calcValue(const Vector& x) const
     if(!_c.getSize()) return(SimTK::NaN);
     if(!_d.getSize()) return(SimTK::NaN);
 
-    int i, j, k;
+    int k;
     double dx;
 
     int n = _x.getSize();
-    double aX = x[0];
 
    /* Check if the abscissa is out of range of the function. If it is,
     * then use the slope of the function at the appropriate end point to
@@ -556,19 +566,8 @@ double SimmSpline::calcValue(const Vector& x) const
     }
     else
     {
-        /* Do a binary search to find which two points the abscissa is between. */
-        i = 0;
-        j = n;
-        while (1)
-        {
-            k = (i+j)/2;
-            if (aX < _x[k])
-                j = k;
-            else if (aX > _x[k+1])
-                i = k;
-            else
-                break;
-        }
+        /* Find which two points the abscissa is between. */
+        k = findInterval(&_x[0], n, aX, hint);
     }
 
    dx = aX - _x[k];
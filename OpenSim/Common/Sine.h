@@ -85,6 +85,7 @@ public:
     //--------------------------------------------------------------------------
     // EVALUATION
     //--------------------------------------------------------------------------
+    using Function::calcValue;
     double calcValue(const SimTK::Vector& x) const override {
         return get_amplitude()*sin(get_omega()*x[0] + get_phase())
             + get_offset();
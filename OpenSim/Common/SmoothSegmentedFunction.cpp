@@ -39,6 +39,8 @@ static double UTOL = (double)SimTK::Eps*1e2;
 static double INTTOL = (double)SimTK::Eps*1e2;
 static int MAXITER = 20;
 static int NUM_SAMPLE_PTS = 100;
+//Number of doubles stored per lookup table point: y, dy/dx, d2y/dx2, d3y/dx3
+static const int TABLE_STRIDE = 4;
 //=============================================================================
 // UTILITY FUNCTIONS
 //=============================================================================
@@ -95,7 +97,9 @@ SmoothSegmentedFunction::
           double x0, double x1, double y0, double y1,double dydx0, double dydx1,
           bool computeIntegral, bool intx0x1, const std::string& name):
 _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
-     _computeIntegral(computeIntegral),_intx0x1(intx0x1),_name(name)
+     _computeIntegral(computeIntegral),_intx0x1(intx0x1),_name(name),
+     _useLookupTable(false),_tableNumIntervals(0),_tableStep(SimTK::NaN),
+     _tableInvStep(SimTK::NaN),_tableMaxError(SimTK::NaN)
 {
     
 
@@ -166,7 +170,9 @@ _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
  SmoothSegmentedFunction::SmoothSegmentedFunction():
  _x0(SimTK::NaN),_x1(SimTK::NaN),_y0(SimTK::NaN)
      ,_y1(SimTK::NaN),_dydx0(SimTK::NaN),_dydx1(SimTK::NaN),
-     _computeIntegral(false),_intx0x1(false),_name("NOT_YET_SET")
+     _computeIntegral(false),_intx0x1(false),_name("NOT_YET_SET"),
+     _useLookupTable(false),_tableNumIntervals(0),_tableStep(SimTK::NaN),
+     _tableInvStep(SimTK::NaN),_tableMaxError(SimTK::NaN)
  {
         _arraySplineUX.resize(0);        
         _mXVec.resize(0);
@@ -202,11 +208,11 @@ double SmoothSegmentedFunction::calcValue(double x) const
     double yVal = 0;
     if(x >= _x0 && x <= _x1 )
     {
-        int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
-        double u = SegmentedQuinticBezierToolkit::
-                 calcU(x,_mXVec[idx], _arraySplineUX[idx], UTOL,MAXITER);
-        yVal = SegmentedQuinticBezierToolkit::
-                 calcQuinticBezierCurveVal(u,_mYVec[idx]);
+        if(_useLookupTable){
+            yVal = calcLookupTableDerivative(x,0);
+        }else{
+            yVal = calcBezierDerivative(x,0);
+        }
     }else{
         if(x < _x0){
             yVal = _y0 + _dydx0*(x-_x0);            
@@ -270,16 +276,11 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
                 yVal = calcValue(x);
     }else{
             if(x >= _x0 && x <= _x1){        
-                int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
-                double u = SegmentedQuinticBezierToolkit::
-                                calcU(x,_mXVec[idx], _arraySplineUX[idx], 
-                                UTOL,MAXITER);
-                yVal = SegmentedQuinticBezierToolkit::
-                            calcQuinticBezierCurveDerivDYDX(u, _mXVec[idx], 
-                            _mYVec[idx], order);
-/*
-                            std::cout << _mX(3, idx) << std::endl;
-                            std::cout << _mX(idx) << std::endl;*/
+                if(_useLookupTable && order <= 2){
+                    yVal = calcLookupTableDerivative(x,order);
+                }else{
+                    yVal = calcBezierDerivative(x,order);
+                }
             }else{
                     if(order == 1){
                         if(x < _x0){
@@ -296,6 +297,107 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
 
 
 
+double SmoothSegmentedFunction::calcBezierDerivative(double x, int order) const
+{
+    int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
+    double u = SegmentedQuinticBezierToolkit::
+                    calcU(x,_mXVec[idx], _arraySplineUX[idx], UTOL,MAXITER);
+    if(order == 0){
+        return SegmentedQuinticBezierToolkit::
+                    calcQuinticBezierCurveVal(u,_mYVec[idx]);
+    }
+    return SegmentedQuinticBezierToolkit::
+                calcQuinticBezierCurveDerivDYDX(u, _mXVec[idx], _mYVec[idx], 
+                order);
+}
+
+/*
+ The lookup table stores f = d^n y/dx^n and f' = d^(n+1) y/dx^n+1 at each
+ table point, so f can be interpolated with a cubic Hermite polynomial on each
+ interval: no search, no iteration, and a single branch to clamp the index at
+ x = _x1.
+*/
+double SmoothSegmentedFunction::
+    calcLookupTableDerivative(double x, int order) const
+{
+    const double s = (x - _x0)*_tableInvStep;
+    int i = (int)s;
+    if(i >= _tableNumIntervals) i = _tableNumIntervals - 1;
+    const double t  = s - i;
+    const double t2 = t*t;
+    const double t3 = t2*t;
+
+    const double* p0 = &_table[TABLE_STRIDE*i + order];
+    const double* p1 = p0 + TABLE_STRIDE;
+
+    const double h00 =  2*t3 - 3*t2 + 1;
+    const double h10 =    t3 - 2*t2 + t;
+    const double h01 = -2*t3 + 3*t2;
+    const double h11 =    t3 -   t2;
+    return h00*p0[0] + h10*_tableStep*p0[1] + h01*p1[0] + h11*_tableStep*p1[1];
+}
+
+void SmoothSegmentedFunction::buildLookupTable(int numIntervals)
+{
+    SimTK_ERRCHK2_ALWAYS(numIntervals >= 1,
+        "SmoothSegmentedFunction::setUseLookupTable",
+        "%s: numIntervals must be at least 1, but it is %i.",
+        _name.c_str(), numIntervals);
+    SimTK_ERRCHK1_ALWAYS(!_mXVec.empty(),
+        "SmoothSegmentedFunction::setUseLookupTable",
+        "%s: Cannot build a lookup table for an empty curve.",
+        _name.c_str());
+
+    _tableNumIntervals = numIntervals;
+    _tableStep = (_x1 - _x0)/numIntervals;
+    _tableInvStep = 1.0/_tableStep;
+    _table.resize(TABLE_STRIDE*(numIntervals + 1));
+    for(int i=0; i <= numIntervals; i++){
+        // Avoid roundoff error pushing the last point outside the domain.
+        const double x = (i == numIntervals) ? _x1 : _x0 + i*_tableStep;
+        for(int order=0; order < TABLE_STRIDE; order++){
+            _table[TABLE_STRIDE*i + order] = calcBezierDerivative(x,order);
+        }
+    }
+
+    _tableMaxError = SimTK::Vec3(0);
+    for(int i=0; i < numIntervals; i++){
+        for(double t : {0.25, 0.5, 0.75}){
+            const double x = _x0 + (i + t)*_tableStep;
+            for(int order=0; order <= 2; order++){
+                const double err = std::abs(
+                        calcLookupTableDerivative(x,order) 
+                      - calcBezierDerivative(x,order));
+                _tableMaxError[order] = std::max(_tableMaxError[order], err);
+            }
+        }
+    }
+}
+
+void SmoothSegmentedFunction::setUseLookupTable(bool useLookupTable,
+                                                int numIntervals)
+{
+    if(useLookupTable && 
+            (_table.empty() || numIntervals != _tableNumIntervals)){
+        buildLookupTable(numIntervals);
+    }
+    _useLookupTable = useLookupTable;
+}
+
+bool SmoothSegmentedFunction::getUseLookupTable() const
+{
+    return _useLookupTable;
+}
+
+SimTK::Vec3 SmoothSegmentedFunction::getLookupTableMaxError() const
+{
+    SimTK_ERRCHK1_ALWAYS(_useLookupTable,
+        "SmoothSegmentedFunction::getLookupTableMaxError",
+        "%s: This curve does not use a lookup table; call "
+        "setUseLookupTable(true) first.", _name.c_str());
+    return _tableMaxError;
+}
+
 double SmoothSegmentedFunction::
     calcDerivative(const SimTK::Array_<int>& derivComponents,
                  const SimTK::Vector& ax) const
@@ -197,6 +197,54 @@ namespace OpenSim {
                   derivative) linear extrapolation*/
        SimTK::Vec2 getCurveDomain() const;
 
+       /**
+       Evaluate the curve, and its first and second derivatives, using a
+       precomputed lookup table rather than the quintic Bezier curves. The
+       table samples y(x) and its first three derivatives at
+       numIntervals+1 evenly-spaced points across the curve domain, and each
+       quantity is evaluated by cubic Hermite interpolation between the two
+       neighboring points. This replaces the section search and the Newton
+       iterations used to invert x(u) with an O(1) lookup.
+
+       Derivatives of order 3 and higher, the integral, and the linear
+       extrapolation regions outside the curve domain are always evaluated
+       exactly.
+
+       @param useLookupTable If true, build the table (if necessary) and use it
+                             in calcValue() and calcDerivative().
+       @param numIntervals   The number of table intervals across the curve
+                             domain; the memory cost is 4*(numIntervals+1)
+                             doubles.
+       @throws SimTK::Exception if numIntervals < 1.
+
+       Use getLookupTableMaxError() to check the accuracy of the table against
+       the exact curve. The interpolation error decreases with the 4th power
+       of the table spacing; with the default resolution, the relative error
+       of the value of the muscle curves created by
+       SmoothSegmentedFunctionFactory is typically below 1e-7.
+
+       <B>Computational Costs</B>
+       \verbatim
+            Building the table: ~(numIntervals+1)*(4 exact evaluations)
+            x in curve domain : ~25 flops
+       \endverbatim
+       */
+       void setUseLookupTable(bool useLookupTable, int numIntervals = 500);
+
+       /** @returns true if calcValue() and calcDerivative() use a lookup
+       table. @see setUseLookupTable() */
+       bool getUseLookupTable() const;
+
+       /**
+       @returns the maximum absolute difference between the lookup table and
+       the exact curve for the value (element 0), and the first (element 1)
+       and second (element 2) derivatives. The difference is sampled at the
+       quarter points of each table interval when the table is built, so the
+       returned values are estimates of the error bounds.
+       @throws SimTK::Exception if the lookup table is not in use.
+       */
+       SimTK::Vec3 getLookupTableMaxError() const;
+
        /**This function will generate a csv file (of 'name_curveName.csv', where 
        name is the one used in the constructor) of the muscle curve, and 
        'curveName' corresponds to the function that was called from
@@ -344,6 +392,28 @@ namespace OpenSim {
         bool _intx0x1;
         /**The name of the function**/
         std::string _name;
+
+        /**When true, calcValue() and calcDerivative() (up to 2nd order)
+        interpolate _table rather than evaluating the Bezier curves*/
+        bool _useLookupTable;
+        /**The number of intervals in the lookup table*/
+        int _tableNumIntervals;
+        /**The spacing of the table points, and its reciprocal*/
+        double _tableStep;
+        double _tableInvStep;
+        /**The table: y, dy/dx, d2y/dx2, and d3y/dx3 at each table point,
+        stored contiguously for each point*/
+        std::vector<double> _table;
+        /**Estimated maximum error of the table for orders 0, 1, and 2*/
+        SimTK::Vec3 _tableMaxError;
+
+        /**Evaluate the Bezier curves (x must be in the curve domain)*/
+        double calcBezierDerivative(double x, int order) const;
+        /**Interpolate the lookup table (x must be in the curve domain, and
+        order must be 0, 1, or 2)*/
+        double calcLookupTableDerivative(double x, int order) const;
+        /**Sample the curve and fill in _table and _tableMaxError*/
+        void buildLookupTable(int numIntervals);
             
         /**No human should be constructing a SmoothSegmentedFunction, so the
         constructor is made private so that mere mortals cannot look at it. 
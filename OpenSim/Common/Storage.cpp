@@ -418,7 +418,6 @@ setNull()
     setHeaderToken(DEFAULT_HEADER_TOKEN);
     _stepInterval = 1;
     _lastI = 0;
-    _fp = 0;
     _inDegrees = false;
 }
 //_____________________________________________________________________________
@@ -1202,15 +1201,21 @@ getDataColumn(int aStateIndex,Array<double> &rData) const
 void Storage::
 getDataColumn(const std::string& columnName, Array<double>& rData, double aStartTime)
 {
-    if(_storage.getSize()<=0) return;
+    int n = _storage.getSize();
+    if(n<=0) return;
 
     int startIndex = findIndex(aStartTime);
     int colIndex = getStateIndex(columnName);
-    double *dataVec=0;
-    getDataColumn(colIndex, dataVec);
-    for(int i=startIndex; i<_storage.getSize(); i++)
-        rData.append(dataVec[i]);
-    delete[] dataVec;
+
+    // ASSIGNMENT
+    // Gather only the rows from startIndex, rather than copying the entire
+    // column first.
+    rData.ensureCapacity(rData.getSize() + n - startIndex);
+    double value;
+    for(int i=startIndex; i<n; i++) {
+        if(_storage[i].getDataValue(colIndex,value))
+            rData.append(value);
+    }
 }
 
 //_____________________________________________________________________________
@@ -1346,6 +1351,7 @@ TimeSeriesTable Storage::exportToTable() const {
                 _columnLabels.get() + _columnLabels.getSize());
     }
 
+    table.reserve(_storage.getSize());
     for(int i = 0; i < _storage.getSize(); ++i) {
         const auto& row = getStateVector(i)->getData();
         const auto time = getStateVector(i)->getTime();
@@ -1447,9 +1453,10 @@ append(const StateVector &aStateVector,bool aCheckForDuplicateTime)
     else
         _storage.append(aStateVector);
 
-    if (_fp!=0){
-        aStateVector.print(_fp);
-        fflush(_fp);
+    if (_outputWriter && _outputWriter->isOpen()) {
+        const Array<double>& data = aStateVector.getData();
+        _outputWriter->appendRow(aStateVector.getTime(), data.getSize(),
+                                 data.get());
     }
     return(_storage.getSize());
 }
@@ -1673,7 +1680,7 @@ add(Storage *aStorage)
         nN = (n<N) ? n : N;
 
         // ADD
-        _storage[i].add(SimTK::Vector_<double>(nN, Y));
+        _storage[i].add(SimTK::Vector_<double>(nN, Y, true));
     }
 
     // CLEANUP
@@ -1755,7 +1762,7 @@ subtract(Storage *aStorage)
         nN = (n<N) ? n : N;
 
         // SUBTRACT
-        _storage[i].subtract(SimTK::Vector_<double>(nN, Y));
+        _storage[i].subtract(SimTK::Vector_<double>(nN, Y, true));
     }
 
     // CLEANUP
@@ -1838,7 +1845,7 @@ multiply(Storage *aStorage)
         nN = (n<N) ? n : N;
 
         // MULTIPLY
-        _storage[i].multiply(SimTK::Vector_<double>(nN, Y));
+        _storage[i].multiply(SimTK::Vector_<double>(nN, Y, true));
     }
 
     // CLEANUP
@@ -1935,7 +1942,7 @@ divide(Storage *aStorage)
         nN = (n<N) ? n : N;
 
         // DIVIDE
-        _storage[i].divide(SimTK::Vector_<double>(nN, Y));
+        _storage[i].divide(SimTK::Vector_<double>(nN, Y, true));
     }
 
     // CLEANUP
@@ -2415,18 +2422,26 @@ lowpassIIR(double aCutoffFrequency)
         return;
     }
 
-    // LOOP OVER COLUMNS
+    // GATHER THE COLUMNS IN ONE PASS OVER THE ROWS
     int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassIIR(dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
+    std::vector<double> signals((size_t)nc*size);
+    std::vector<double*> columns(nc);
+    for(int i=0;i<nc;i++) columns[i] = &signals[(size_t)i*size];
+    for(int r=0;r<size;r++) {
+        const Array<double>& data = getStateVector(r)->getData();
+        for(int i=0;i<nc;i++) columns[i][r] = data[i];
     }
 
-    // CLEANUP
-    delete[] signal;
+    // FILTER ALL COLUMNS AT ONCE
+    Signal::LowpassIIR(dtmin,aCutoffFrequency,size,
+            std::vector<const double*>(columns.begin(),columns.end()),
+            columns,0);
+
+    // SCATTER THE FILTERED COLUMNS
+    for(int r=0;r<size;r++) {
+        Array<double>& data = getStateVector(r)->getData();
+        for(int i=0;i<nc;i++) data[i] = columns[i][r];
+    }
 }
 
 void Storage::
@@ -2476,9 +2491,11 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
  * or at time aT ( aT <= getTime(index) ).
  *
  * This method can be much more efficient than findIndex(aT) if a good guess
- * is made for aI.
- * If aI corresponds to a state which occurred later than aT, an exhaustive
- * search is performed by calling findIndex(aT).
+ * is made for aI: the search gallops forward from aI, so finding a time a
+ * few states after aI (e.g., when interpolating at increasing times) takes
+ * only a few comparisons, and distant times are found in O(log n).
+ * If aI corresponds to a state which occurred later than aT, the whole
+ * storage is searched by calling findIndex(aT).
  *
  * @param aI Index at which to start searching.
  * @param aT Time.
@@ -2489,18 +2506,21 @@ int Storage::
 findIndex(int aI,double aT) const
 {
     // MAKE SURE aI IS VALID
-    if(_storage.getSize()<=0) return(-1);
-    if((aI>=_storage.getSize())||(aI<0)) aI=0;
-    if(getStateVector(aI)->getTime()>aT) aI=0;
+    int n = _storage.getSize();
+    if(n<=0) return(-1);
+    if((aI>=n)||(aI<0)) aI=0;
+    if(_storage.get(aI).getTime()>aT) return(findIndex(aT));
 
-    // SEARCH
-    //cout << "Storage.findIndex: starting at " << aI << endl;
-    int i;
-    for(i=aI;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
+    // GALLOP FORWARD UNTIL aT IS BRACKETED
+    int lo=aI, hi=aI+1, step=1;
+    while((hi<n)&&!(aT<_storage.get(hi).getTime())) {
+        lo = hi;
+        step *= 2;
+        hi = (step<n-lo) ? lo+step : n;
     }
-    _lastI = i-1;
-    if(_lastI<0) _lastI=0;
+
+    // SEARCH
+    _lastI = findIndexOfFirstStateAfter(lo+1,hi,aT) - 1;
     return(_lastI);
 }
 //_____________________________________________________________________________
@@ -2508,8 +2528,8 @@ findIndex(int aI,double aT) const
  * Find the index of the storage element that occurred immediately before
  * or at a specified time ( getTime(index) <= aT ).
  *
- * This method is not very efficient because it always starts its search
- * with the first stored state.
+ * The times of the stored states are assumed to be nondecreasing, so a
+ * binary search is used.
  *
  * @param aT Time.
  * @return Index preceding or at time aT.  If aT is less than the earliest
@@ -2519,15 +2539,29 @@ int Storage::
 findIndex(double aT) const
 {
     if(_storage.getSize()<=0) return(-1);
-    int i;
-    for(i=0;i<_storage.getSize();i++) {
-        if(aT<getStateVector(i)->getTime()) break;
-    }
-    _lastI = i-1;
+    _lastI = findIndexOfFirstStateAfter(0,_storage.getSize(),aT) - 1;
     if(_lastI<0) _lastI=0;
     return(_lastI);
 }
 //_____________________________________________________________________________
+/**
+ * Binary search for the first stored state in the range [aBegin, aEnd) whose
+ * time is greater than aT.
+ *
+ * @return Index of that state, or aEnd if all states in the range occurred
+ * at or before aT.
+ */
+int Storage::
+findIndexOfFirstStateAfter(int aBegin,int aEnd,double aT) const
+{
+    while(aBegin<aEnd) {
+        int mid = aBegin + (aEnd-aBegin)/2;
+        if(aT<_storage.get(mid).getTime()) aEnd = mid;
+        else aBegin = mid+1;
+    }
+    return(aBegin);
+}
+//_____________________________________________________________________________
 /**
  * Find the range of frames that is between start time and end time
  * (inclusive). Return the indices of the bounding frames.
@@ -2669,23 +2703,59 @@ void Storage::interpolateAt(const Array<double> &targetTimes)
 //_____________________________________________________________________________
 /**
  * Set name of output file to be written into.
- * This has the side effect of opening the file for writing. The header will not have the correct
- * number of rows but this may not be an issue for version 2 of the Storage class
+ * This has the side effect of opening the file for writing and writing the
+ * rows already in the storage. Rows appended afterwards are written to the
+ * file as well.
  */
 void Storage::
 setOutputFileName(const std::string& aFileName)
 {
-    assert(_fileName=="");
+    setOutputFileName(aFileName, false);
+}
+void Storage::
+setOutputFileName(const std::string& aFileName, bool useBackgroundThread,
+        int flushInterval)
+{
+    closeOutputFile();
+    _outputWriter.reset();
     _fileName = aFileName;
-
-    // OPEN THE FILE
-    _fp = IO::OpenFile(aFileName,"w");
-    if(_fp==NULL) throw(Exception("Could not open file "+aFileName));
-    // WRITE THE HEADER
-    writeHeader(_fp);
-    writeDescription(_fp);
-    // WRITE THE COLUMN LABELS
-    writeColumnLabels(_fp);
+    if(aFileName.empty()) return;
+    OPENSIM_THROW_IF_FRMOBJ(_columnLabels.getSize() < 1, Exception,
+            "Expected column labels to be set before writing to file '" +
+            aFileName + "'.");
+
+    // Same metadata as exportToTable(). The first column label is 'time'.
+    TableMetaData metaData;
+    metaData.setValueForKey("header", getName());
+    metaData.setValueForKey("inDegrees",
+            std::string{_inDegrees ? "yes" : "no"});
+    if(!getDescription().empty())
+        metaData.setValueForKey("description", getDescription());
+    const std::vector<std::string> labels(_columnLabels.get() + 1,
+            _columnLabels.get() + _columnLabels.getSize());
+
+    _outputWriter.reset(new TableFileWriter(aFileName, labels, metaData,
+            useBackgroundThread));
+    // With a flush interval, the rows already in the storage are written at
+    // once, including the last one.
+    if(flushInterval > 0)
+        _outputWriter->setFlushInterval(std::max(_storage.getSize(), 1));
+    for(int i = 0; i < _storage.getSize(); ++i) {
+        const Array<double>& data = _storage[i].getData();
+        _outputWriter->appendRow(_storage[i].getTime(), data.getSize(),
+                                 data.get());
+    }
+    if(flushInterval > 0) _outputWriter->setFlushInterval(flushInterval);
+}
+//_____________________________________________________________________________
+/**
+ * Write the remaining rows to the output file set with setOutputFileName(),
+ * if any, and close the file.
+ */
+void Storage::
+closeOutputFile() const
+{
+    if(_outputWriter) _outputWriter->close();
 }
 //_____________________________________________________________________________
 /**
@@ -2707,6 +2777,9 @@ setOutputFileName(const std::string& aFileName)
 bool Storage::
 print(const string &aFileName,const string &aMode, const string& aComment) const
 {
+    // COMPLETE THE OUTPUT FILE IF IT IS THE SAME FILE
+    if(aFileName == _fileName) closeOutputFile();
+
     // OPEN THE FILE
     FILE *fp = IO::OpenFile(aFileName,aMode);
     if(fp==NULL) return(false);
@@ -2784,7 +2857,9 @@ print(const string &aFileName,double aDT,const string &aMode) const
     // CHECK FOR VALID DT
     if(aDT<=0) return(0);
 
-    if (_fp!= NULL) fclose(_fp);
+    // COMPLETE THE OUTPUT FILE IF IT IS THE SAME FILE
+    if(aFileName == _fileName) closeOutputFile();
+
     // OPEN THE FILE
     FILE *fp = IO::OpenFile(aFileName,aMode);
     if(fp==NULL) return(-1);
@@ -30,6 +30,7 @@
 #include "StateVector.h"
 #include "Units.h"
 #include "StorageInterface.h"
+#include "TableFileWriter.h"
 #include "TimeSeriesTable.h"
 
 const int Storage_DEFAULT_CAPACITY = 256;
@@ -58,6 +59,12 @@ typedef std::map<std::string, std::string, std::less<std::string> > MapKeysToVal
  * TimeIndex, and a particular state (or column) is indexed by the
  * StateIndex.
  *
+ * The statevectors are stored row by row, and there is no columnar copy of
+ * the data: getStateVector() returns rows that callers may modify, so such a
+ * copy could not be kept up to date. Column accessors such as getDataColumn()
+ * therefore gather the values from each row. Use exportToTable() to work
+ * with the data in a contiguous, column-accessible matrix.
+ *
  * @version 1.0
  * @author Frank C. Anderson
  */
@@ -95,9 +102,10 @@ protected:
     bool _inDegrees;
     /** Map between keys in file header and values */
     MapKeysToValues _keyValueMap;
-    /** Cache for fileName and file pointer when the file is opened so we can flush and write intermediate files if needed */
+    /** Name of the file to which rows are written as they are appended, and
+    the writer for this file (see setOutputFileName()). */
     std::string _fileName;
-    FILE *_fp;
+    std::unique_ptr<TableFileWriter> _outputWriter;
     /** Name and Description */
     std::string _name;
     std::string _description;
@@ -362,7 +370,29 @@ public:
     //--------------------------------------------------------------------------
     bool print(const std::string &aFileName,const std::string &aMode="w", const std::string& aComment="") const;
     int print(const std::string &aFileName,double aDT,const std::string &aMode="w") const;
+    /** Write the rows of this storage to a file as they are appended, so
+    that a file is available even if, e.g., a simulation does not finish. The
+    rows already in the storage are written first. The file is written with a
+    TableFileWriter (see there for the format), which buffers the rows and
+    keeps the number of rows in the header up to date. A row with the same
+    time as the previous row replaces the previous row in the file, even if
+    both are kept in the storage. The column labels must be set, and the rows
+    must have one value per column label (excluding time).
+    The file is complete once closeOutputFile() is called, the storage is
+    destroyed, the storage is printed to the same file with print(), or
+    setOutputFileName() is called again. An empty file name only closes the
+    current file. */
     void setOutputFileName(const std::string& aFileName) override ;
+    /** Same as setOutputFileName(), but optionally formats and writes the
+    rows in a background thread. If flushInterval is positive, the rows
+    already in the storage are written to the file immediately, and then the
+    rows are written and the file is flushed every flushInterval appended
+    rows (see TableFileWriter::setFlushInterval()); e.g., CMCTool and RRATool
+    use 1, so that their states files are up to date if the run stops. */
+    void setOutputFileName(const std::string& aFileName,
+                           bool useBackgroundThread, int flushInterval = 0);
+    /** Write the remaining rows to the output file, if any, and close it. */
+    void closeOutputFile() const;
     // convenience function for Analyses and DerivCallbacks
     static void printResult(const Storage *aStorage,const std::string &aName,
         const std::string &aDir,double aDT,const std::string &aExtension);
@@ -374,6 +404,7 @@ private:
     int writeColumnLabels(FILE *rFP) const;
     int integrate(double aTI,double aTF,int aN,double *rArea,Storage *rStorage) const;
     int integrate(int aI1,int aI2,int aN,double *rArea,Storage *rStorage) const;
+    int findIndexOfFirstStateAfter(int aBegin,int aEnd,double aT) const;
 
 //=============================================================================
 };  // END of class Storage
@@ -0,0 +1,292 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  TableFileWriter.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "TableFileWriter.h"
+
+#include "About.h"
+#include "IO.h"
+#include "Logger.h"
+
+#include <cstdio>
+#include <limits>
+
+namespace OpenSim {
+
+namespace {
+
+// The rows are written to the file in blocks of at least this many values
+// (about 1 MB of text).
+const size_t minNumValuesPerWrite = 1 << 16;
+
+// Room reserved in the header for the number of rows; enough for any
+// size_t. The number is padded with trailing spaces, which the readers trim.
+const size_t numRowsWidth = 20;
+
+// Same precision as DelimFileAdapter::extendWrite().
+const int precision = std::numeric_limits<double>::digits10 + 1;
+
+std::string formatNumRows(size_t numRows) {
+    std::string text = std::to_string(numRows);
+    text.resize(numRowsWidth, ' ');
+    return text;
+}
+
+bool isCSVFileName(const std::string& fileName) {
+    const auto dot = fileName.rfind('.');
+    if (dot == std::string::npos) return false;
+    return IO::Lowercase(fileName.substr(dot)) == ".csv";
+}
+
+} // anonymous namespace
+
+TableFileWriter::TableFileWriter(const std::string& fileName,
+                                 const std::vector<std::string>& columnLabels,
+                                 const TableMetaData& metaData,
+                                 bool useBackgroundThread) {
+    open(fileName, columnLabels, metaData, "double", 1, useBackgroundThread);
+}
+
+TableFileWriter::~TableFileWriter() {
+    try {
+        close();
+    } catch (const std::exception& e) {
+        log_error("TableFileWriter: {}", e.what());
+    }
+}
+
+void TableFileWriter::open(const std::string& fileName,
+                           const std::vector<std::string>& columnLabels,
+                           const TableMetaData& metaData,
+                           const std::string& dataType,
+                           int numComponents,
+                           bool useBackgroundThread) {
+    OPENSIM_THROW_IF(fileName.empty(),
+                     EmptyFileName);
+    const bool isCSV = isCSVFileName(fileName);
+    OPENSIM_THROW_IF(isCSV && numComponents != 1,
+                     IncorrectTableType,
+                     "CSV files can only be written for tables of doubles.");
+
+    _fileName = fileName;
+    _dataType = dataType;
+    _delimiter = isCSV ? "," : "\t";
+    _numColumns = int(columnLabels.size());
+    _numComponents = numComponents;
+
+    // Binary mode, so that the position of the number of rows is exact.
+    _stream.open(fileName, std::ios::out | std::ios::trunc | std::ios::binary);
+    OPENSIM_THROW_IF(!_stream.good(), Exception,
+                     "Could not open file '{}' for writing.", fileName);
+    _isOpen = true;
+
+    // Header, in the same order as DelimFileAdapter::extendWrite(), except
+    // that the number of rows and columns come first.
+    if (metaData.hasKey("header")) {
+        const auto* header = dynamic_cast<const SimTK::Value<std::string>*>(
+                &metaData.getValueForKey("header"));
+        if (header) _stream << header->get() << "\n";
+    }
+    _stream << "nRows=";
+    _numRowsPosition = _stream.tellp();
+    _stream << formatNumRows(0) << "\n";
+    _stream << "nColumns=" << _numColumns + 1 << "\n";
+    for (const auto& key : metaData.getKeys()) {
+        if (key == "header" || key == "nRows" || key == "nColumns") continue;
+        const auto* value = dynamic_cast<const SimTK::Value<std::string>*>(
+                &metaData.getValueForKey(key));
+        if (value) _stream << key << "=" << value->get() << "\n";
+    }
+    _stream << "DataType=" << dataType << "\n";
+    _stream << "version=3\n";
+    _stream << "OpenSimVersion=" << GetVersion() << "\n";
+    _stream << "endheader\n";
+
+    _stream << "time";
+    for (const auto& label : columnLabels) _stream << _delimiter << label;
+    _stream << "\n";
+    _stream.flush();
+    OPENSIM_THROW_IF(!_stream.good(), Exception,
+                     "Could not write to file '{}'.", fileName);
+
+    if (useBackgroundThread)
+        _thread = std::thread(&TableFileWriter::runWriterThread, this);
+}
+
+void TableFileWriter::appendRow(double time, int numValues,
+                                const double* values) {
+    OPENSIM_THROW_IF(!_isOpen, Exception,
+                     "Cannot append a row to file '{}' after it is closed.",
+                     _fileName);
+    OPENSIM_THROW_IF(numValues != _numColumns * _numComponents,
+                     IncorrectNumColumns,
+                     _numColumns * _numComponents,
+                     numValues);
+    if (_lastRow.empty() || _lastRow[0] != time) {
+        queueLastRow();
+        ++_numRows;
+    }
+    _lastRow.assign(1, time);
+    _lastRow.insert(_lastRow.end(), values, values + numValues);
+
+    if (_flushInterval > 0 && ++_numRowsSinceFlush >= _flushInterval) {
+        // Write the most recent row as well; it can no longer be replaced.
+        _rows.insert(_rows.end(), _lastRow.begin(), _lastRow.end());
+        _lastRow.clear();
+        flush();
+        _numRowsSinceFlush = 0;
+    }
+}
+
+void TableFileWriter::setFlushInterval(int numRows) {
+    OPENSIM_THROW_IF(numRows < 0, Exception,
+                     "Expected the flush interval to be non-negative, but got "
+                     "{}.", numRows);
+    _flushInterval = numRows;
+    _numRowsSinceFlush = 0;
+}
+
+void TableFileWriter::queueLastRow() {
+    if (_lastRow.empty()) return;
+    _rows.insert(_rows.end(), _lastRow.begin(), _lastRow.end());
+    _lastRow.clear();
+    if (_rows.size() >= minNumValuesPerWrite) handOffRows();
+}
+
+void TableFileWriter::handOffRows() {
+    if (_rows.empty()) return;
+    if (!_thread.joinable()) {
+        writeRows(_rows);
+        _rows.clear();
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait(lock, [this] { return _rowsToWrite.empty(); });
+    if (_writerError) std::rethrow_exception(_writerError);
+    // _rowsToWrite is empty, so _rows is empty after the swap.
+    _rowsToWrite.swap(_rows);
+    _condition.notify_all();
+}
+
+void TableFileWriter::flush() {
+    if (!_isOpen) return;
+    handOffRows();
+    if (_thread.joinable()) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock,
+                [this] { return _rowsToWrite.empty() && !_writing; });
+        if (_writerError) std::rethrow_exception(_writerError);
+    }
+}
+
+void TableFileWriter::close() {
+    if (!_isOpen) return;
+    std::exception_ptr error;
+    try {
+        if (!_lastRow.empty()) {
+            _rows.insert(_rows.end(), _lastRow.begin(), _lastRow.end());
+            _lastRow.clear();
+        }
+        handOffRows();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    if (_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _condition.notify_all();
+        // The thread writes the remaining rows before it returns.
+        _thread.join();
+        if (!error) error = _writerError;
+    }
+    _stream.close();
+    _isOpen = false;
+    if (error) std::rethrow_exception(error);
+}
+
+void TableFileWriter::writeRows(const std::vector<double>& rows) {
+    const size_t rowLength = 1 + _numColumns * _numComponents;
+    char buffer[32];
+    const auto appendNumber = [&](double value) {
+        const int length = std::snprintf(buffer, sizeof(buffer), "%.*g",
+                                         precision, value);
+        _text.append(buffer, length);
+    };
+
+    _text.clear();
+    for (size_t start = 0; start < rows.size(); start += rowLength) {
+        appendNumber(rows[start]);
+        const double* values = rows.data() + start + 1;
+        for (int col = 0; col < _numColumns; ++col) {
+            _text += _delimiter;
+            for (int comp = 0; comp < _numComponents; ++comp) {
+                if (comp > 0) _text += ',';
+                appendNumber(values[col * _numComponents + comp]);
+            }
+        }
+        _text += '\n';
+    }
+    _stream.write(_text.data(), _text.size());
+    _numRowsWritten += rows.size() / rowLength;
+
+    // Update the number of rows in the header.
+    const auto end = _stream.tellp();
+    _stream.seekp(_numRowsPosition);
+    _stream << formatNumRows(_numRowsWritten);
+    _stream.seekp(end);
+    _stream.flush();
+    OPENSIM_THROW_IF(!_stream.good(), Exception,
+                     "Could not write to file '{}'.", _fileName);
+}
+
+void TableFileWriter::runWriterThread() {
+    std::vector<double> rows;
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _condition.wait(lock,
+                [this] { return !_rowsToWrite.empty() || _stopping; });
+        if (_rowsToWrite.empty()) return;
+        rows.swap(_rowsToWrite);
+        _writing = true;
+        // Let the appending thread queue the next block while these rows
+        // are written.
+        _condition.notify_all();
+        const bool failed = bool(_writerError);
+        lock.unlock();
+        std::exception_ptr error;
+        if (!failed) {
+            try {
+                writeRows(rows);
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+        rows.clear();
+        lock.lock();
+        if (error) _writerError = error;
+        _writing = false;
+        _condition.notify_all();
+    }
+}
+
+} // namespace OpenSim
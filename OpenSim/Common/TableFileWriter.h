@@ -0,0 +1,257 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  TableFileWriter.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_TABLE_FILE_WRITER_H_
+#define OPENSIM_TABLE_FILE_WRITER_H_
+
+#include "DelimFileAdapter.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace OpenSim {
+
+/** Whether TableFileWriter can write tables with elements of type T; these
+are the element types supported by STOFileAdapter_.                          */
+template<typename T>
+struct IsTableFileWriterElementType : std::integral_constant<bool,
+        std::is_same<T, double           >::value ||
+        is_SimTK_Vec<T                   >::value ||
+        std::is_same<T, SimTK::UnitVec3  >::value ||
+        std::is_same<T, SimTK::Quaternion>::value ||
+        std::is_same<T, SimTK::SpatialVec>::value> {};
+
+/** TableFileWriter writes a time series to a STO or CSV file one row at a
+time, while the rows are produced (e.g., during a simulation), instead of
+writing a complete table at the end like STOFileAdapter::write(). The file
+is written in the CSV format if its name ends with ".csv" and in the STO
+format otherwise; the files have the same layout as those written by
+STOFileAdapter and CSVFileAdapter and can be read by these adapters and by
+Storage.
+
+The header of the file contains the number of rows ("nRows"), which is
+unknown when the header is written. The header reserves room for this number,
+and the number is updated each time rows are written to the file, so that the
+header is correct even if the program stops before the file is closed.
+
+The rows are formatted into a buffer that is written to the file once it
+holds many rows, when flush() is called, and when the writer is closed (or
+destroyed). Use setFlushInterval() to write the rows (and flush the file)
+more often, e.g., after every row. Optionally, the rows are formatted and
+written by a background thread, so that the thread appending the rows (e.g.,
+the thread integrating a simulation) only copies the values.
+
+As with Storage::append(), a row whose time is equal to the time of the
+previous row replaces the previous row. Therefore, the most recent row is
+only written to the file once the next row is appended or the writer is
+closed, unless a flush interval is set (see setFlushInterval()).
+
+@code
+TableFileWriter writer("long_trial_angles.sto", {"hip", "knee"},
+                       TableMetaData(), true);
+for (int i = 0; i < numSteps; ++i) {
+    // ...
+    const double angles[] = {hip, knee};
+    writer.appendRow(time, 2, angles);
+}
+writer.close();
+@endcode
+
+The rows must be appended from a single thread.                              */
+class OSIMCOMMON_API TableFileWriter {
+public:
+    /** Open the file and write the header for a table of doubles.
+    @param fileName Name of the file; existing files are overwritten.
+    @param columnLabels Labels of the columns, excluding the time column.
+    @param metaData Metadata written to the header. As with
+           STOFileAdapter, the value for the key "header" is written first
+           and only values of type std::string are written. The values for the
+           keys "nRows" and "nColumns" are ignored; the writer writes its own.
+    @param useBackgroundThread Format and write the rows in a background
+           thread.
+    \throws EmptyFileName If the file name is empty.
+    \throws Exception If the file cannot be opened.                          */
+    TableFileWriter(const std::string& fileName,
+                    const std::vector<std::string>& columnLabels,
+                    const TableMetaData& metaData = TableMetaData(),
+                    bool useBackgroundThread = false);
+
+    /** Open the file, write the header for the column labels and the
+    metadata of the given table, and write the rows already in the table.
+    \tparam T Any element type supported by STOFileAdapter_. Only double is
+            supported for CSV files.                                         */
+    template<typename T>
+    TableFileWriter(const std::string& fileName,
+                    const TimeSeriesTable_<T>& table,
+                    bool useBackgroundThread = false);
+
+    TableFileWriter(const TableFileWriter&)            = delete;
+    TableFileWriter& operator=(const TableFileWriter&) = delete;
+
+    /** Closes the file (see close()). Errors are logged, not thrown.        */
+    ~TableFileWriter();
+
+    /** Append a row with the given time and values. There are
+    getNumColumns() values, or, if the elements of the table are not doubles,
+    getNumColumns() times the number of components of an element (e.g., 3 for
+    SimTK::Vec3), stored one element after the other.
+    \throws IncorrectNumColumns If the number of values is incorrect.
+    \throws Exception If the writer is closed or writing to the file
+            failed.                                                          */
+    void appendRow(double time, int numValues, const double* values);
+
+    /** Append a row with the given time and elements.
+    \throws IncorrectTableType If the type of the elements does not match the
+            type of the table this writer was created for.                   */
+    template<typename T>
+    void appendRow(double time, const SimTK::RowVectorBase<T>& row);
+
+    /** Write all rows appended so far to the file, except the most recent
+    row (see the class description), and wait until they are written.      */
+    void flush();
+
+    /** Write the rows to the file, including the most recent row, and flush
+    the file each time numRows rows have been appended since the rows were
+    last written. For example, with numRows = 1, each row is in the file as
+    soon as appendRow() returns. Rows that have been written this way can no
+    longer be replaced: a later row with the same time is written as a
+    separate row. The default, 0, writes the rows only in large blocks (see
+    the class description).
+    \throws Exception If numRows is negative.                                */
+    void setFlushInterval(int numRows);
+    int getFlushInterval() const { return _flushInterval; }
+
+    /** Write all rows, update the number of rows in the header, and close the
+    file. Further calls have no effect.
+    \throws Exception If writing to the file failed; the file is closed
+            nonetheless.                                                     */
+    void close();
+
+    bool isOpen() const { return _isOpen; }
+    const std::string& getFileName() const { return _fileName; }
+    /** Number of columns, excluding the time column.                        */
+    int getNumColumns() const { return _numColumns; }
+    /** Number of rows appended so far (not counting replaced rows), including
+    those not yet written to the file.                                       */
+    size_t getNumRows() const { return _numRows; }
+
+private:
+    void open(const std::string& fileName,
+              const std::vector<std::string>& columnLabels,
+              const TableMetaData& metaData,
+              const std::string& dataType,
+              int numComponents,
+              bool useBackgroundThread);
+    // Move the most recent row to the rows that are ready to be written.
+    void queueLastRow();
+    // Write the rows that are ready to be written, or hand them to the
+    // background thread.
+    void handOffRows();
+    // Format the rows, append them to the file, and update the number of rows
+    // in the header.
+    void writeRows(const std::vector<double>& rows);
+    void runWriterThread();
+
+    std::string _fileName;
+    bool _isOpen{false};
+    std::ofstream _stream;
+    // Position of the number of rows in the header.
+    std::streamoff _numRowsPosition{};
+    std::string _dataType;
+    std::string _delimiter;
+    int _numColumns{};
+    int _numComponents{};
+    size_t _numRows{};
+    // See setFlushInterval().
+    int _flushInterval{};
+    int _numRowsSinceFlush{};
+    // Accessed only by the thread writing to the file.
+    size_t _numRowsWritten{};
+    std::string _text;
+
+    // The most recent row (time followed by the values), which may still be
+    // replaced, and the rows that are ready to be written.
+    std::vector<double> _lastRow;
+    std::vector<double> _rows;
+    std::vector<double> _elements;
+
+    // Background thread. _rowsToWrite holds at most one block of rows waiting
+    // for the thread; all members below are guarded by _mutex.
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::vector<double> _rowsToWrite;
+    bool _writing{false};
+    bool _stopping{false};
+    std::exception_ptr _writerError;
+};
+
+template<typename T>
+TableFileWriter::TableFileWriter(const std::string& fileName,
+                                 const TimeSeriesTable_<T>& table,
+                                 bool useBackgroundThread) {
+    static_assert(sizeof(T) % sizeof(double) == 0,
+                  "Element type must consist of doubles.");
+    open(fileName, table.hasColumnLabels() ? table.getColumnLabels()
+                                           : std::vector<std::string>{},
+         table.getTableMetaData(), DelimFileAdapter<T>::dataTypeName(),
+         int(sizeof(T) / sizeof(double)), useBackgroundThread);
+    const auto& times = table.getIndependentColumn();
+    try {
+        for (size_t row = 0; row < table.getNumRows(); ++row)
+            appendRow(times[row], table.getRowAtIndex(row));
+    } catch (...) {
+        // The destructor is not called if the constructor throws; stop the
+        // background thread.
+        try { close(); } catch (...) {}
+        throw;
+    }
+}
+
+template<typename T>
+void TableFileWriter::appendRow(double time,
+                                const SimTK::RowVectorBase<T>& row) {
+    OPENSIM_THROW_IF(DelimFileAdapter<T>::dataTypeName() != _dataType,
+                     IncorrectTableType,
+                     "Expected elements of type " + _dataType + ", but got " +
+                     DelimFileAdapter<T>::dataTypeName() + ".");
+    OPENSIM_THROW_IF(row.size() != _numColumns,
+                     IncorrectNumColumns,
+                     _numColumns,
+                     row.size());
+    const size_t numComponents = sizeof(T) / sizeof(double);
+    _elements.resize(_numColumns * numComponents);
+    for (int col = 0; col < _numColumns; ++col) {
+        const auto* components = reinterpret_cast<const double*>(&row[col]);
+        std::copy(components, components + numComponents,
+                  _elements.begin() + col * numComponents);
+    }
+    appendRow(time, int(_elements.size()), _elements.data());
+}
+
+} // namespace OpenSim
+
+#endif // OPENSIM_TABLE_FILE_WRITER_H_
@@ -147,14 +147,15 @@ void TableUtilities::filterLowpass(
         table = resampleWithInterval(table, dtMin);
     }
 
-    SimTK::Vector filtered(numRows);
-    for (int icol = 0; icol < (int)table.getNumColumns(); ++icol) {
-        SimTK::VectorView column = table.getDependentColumnAtIndex(icol);
-        Signal::LowpassIIR(dtMin, cutoffFreq, numRows,
-                column.getContiguousScalarData(),
-                filtered.updContiguousScalarData());
-        table.updDependentColumnAtIndex(icol) = filtered;
+    // Filter all columns in place at once.
+    SimTK::Matrix& matrix = table.updMatrix();
+    std::vector<double*> columns(matrix.ncol());
+    for (int icol = 0; icol < matrix.ncol(); ++icol) {
+        columns[icol] = matrix.updCol(icol).updContiguousScalarData();
     }
+    Signal::LowpassIIR(dtMin, cutoffFreq, numRows,
+            std::vector<const double*>(columns.begin(), columns.end()),
+            columns, 0);
 }
 
 void TableUtilities::pad(
@@ -166,20 +167,22 @@ void TableUtilities::pad(
             "got {}.",
             numRowsToPrependAndAppend);
 
-    table._indData = Signal::Pad(numRowsToPrependAndAppend,
-            (int)table._indData.size(), table._indData.data());
-
-    size_t numColumns = table.getNumColumns();
-
-    // _indData.size() is now the number of rows after padding.
-    SimTK::Matrix newMatrix((int)table._indData.size(), (int)numColumns);
-    for (size_t icol = 0; icol < numColumns; ++icol) {
-        SimTK::Vector column = table.getDependentColumnAtIndex(icol);
-        const std::vector<double> newColumn =
-                Signal::Pad(numRowsToPrependAndAppend, column.size(),
-                        column.getContiguousScalarData());
-        newMatrix.updCol((int)icol) =
-                SimTK::Vector((int)newColumn.size(), newColumn.data(), true);
+    const int pad = numRowsToPrependAndAppend;
+    const int numRows = (int)table._indData.size();
+    table._indData = Signal::Pad(pad, numRows, table._indData.data());
+
+    // Pad each column directly into the new matrix, in the same way as
+    // Signal::Pad().
+    const auto matrix = table.getMatrix();
+    SimTK::Matrix newMatrix(numRows + 2 * pad, matrix.ncol());
+    for (int icol = 0; icol < matrix.ncol(); ++icol) {
+        const double* x = matrix.col(icol).getContiguousScalarData();
+        double* s = newMatrix.updCol(icol).updContiguousScalarData();
+        for (int i = 0; i < pad; ++i) s[i] = 2.0 * x[0] - x[pad - i];
+        std::copy_n(x, numRows, s + pad);
+        for (int i = 0; i < pad; ++i) {
+            s[pad + numRows + i] = 2.0 * x[numRows - 1] - x[numRows - 2 - i];
+        }
     }
     table.updMatrix() = newMatrix;
 }
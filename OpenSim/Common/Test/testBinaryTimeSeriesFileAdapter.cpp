@@ -0,0 +1,212 @@
+/* -------------------------------------------------------------------------- *
+ *               OpenSim:  testBinaryTimeSeriesFileAdapter.cpp                *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "OpenSim/Common/Adapters.h"
+#include "OpenSim/Common/CommonUtilities.h"
+#include <cstring>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+
+using namespace OpenSim;
+
+namespace {
+
+void makeElt(double x, double& elt) { elt = x; }
+void makeElt(double x, SimTK::Vec3& elt) { elt = SimTK::Vec3(x, 2 * x, -x); }
+void makeElt(double x, SimTK::Quaternion& elt) {
+    elt = SimTK::Quaternion(std::cos(x), std::sin(x), 0, 0);
+}
+void makeElt(double x, SimTK::SpatialVec& elt) {
+    elt = SimTK::SpatialVec(SimTK::Vec3(x, 1, 0), SimTK::Vec3(0, -x, x * x));
+}
+
+// A table sampled at 100 Hz with a NaN, constant and slowly-varying columns,
+// and metadata.
+template<typename T>
+TimeSeriesTable_<T> createTable(int numRows) {
+    TimeSeriesTable_<T> table;
+    table.setColumnLabels({"constant", "sine", "ramp"});
+    table.reserve(numRows);
+    SimTK::RowVector_<T> row(3);
+    for (int i = 0; i < numRows; ++i) {
+        makeElt(1.5, row[0]);
+        makeElt(std::sin(0.01 * i), row[1]);
+        makeElt(i == 7 ? SimTK::NaN : 0.25 * i, row[2]);
+        table.appendRow(0.01 * i, row);
+    }
+    table.addTableMetaData("inDegrees", std::string("no"));
+    table.addTableMetaData("DataRate", std::string("100"));
+    // Only metadata with string values is stored.
+    table.addTableMetaData("numTrials", 3);
+    auto dependentsMetaData = table.getDependentsMetaData();
+    ValueArray<std::string> units{};
+    for (const auto& unit : {"m", "rad", "N"})
+        units.upd().push_back(SimTK::Value<std::string>{unit});
+    dependentsMetaData.setValueArrayForKey("units", units);
+    table.setDependentsMetaData(dependentsMetaData);
+    return table;
+}
+
+template<typename T>
+bool sameBits(const T& a, const T& b) {
+    return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+// Compare the rows of actual to the rows of expected starting at firstRow.
+template<typename T>
+void checkRows(const TimeSeriesTable_<T>& expected,
+               const TimeSeriesTable_<T>& actual,
+               size_t firstRow) {
+    REQUIRE(actual.getColumnLabels() == expected.getColumnLabels());
+    REQUIRE(firstRow + actual.getNumRows() <= expected.getNumRows());
+    bool same = true;
+    for (size_t i = 0; i < actual.getNumRows(); ++i) {
+        same = same && sameBits(actual.getIndependentColumn()[i],
+                expected.getIndependentColumn()[firstRow + i]);
+        for (size_t c = 0; c < actual.getNumColumns(); ++c) {
+            same = same && sameBits(actual.getMatrix()(int(i), int(c)),
+                    expected.getMatrix()(int(firstRow + i), int(c)));
+        }
+    }
+    CHECK(same);
+}
+
+template<typename T>
+void testRoundTrip(bool compressed) {
+    const std::string fileName = "testBinaryTimeSeriesFileAdapter_" +
+            std::to_string(sizeof(T)) + "_" + std::to_string(compressed) +
+            ".bsto";
+    FileRemover fileRemover(fileName);
+    const auto table = createTable<T>(1000);
+
+    BinaryTimeSeriesFileAdapter adapter;
+    adapter.setCompressionEnabled(compressed);
+    adapter.setNumRowsPerBlock(64);
+    adapter.writeTable(table, fileName);
+
+    // Read the entire table through the extension.
+    TimeSeriesTable_<T> read(fileName);
+    REQUIRE(read.getNumRows() == table.getNumRows());
+    checkRows(table, read, 0);
+    CHECK(read.template getTableMetaData<std::string>("inDegrees") == "no");
+    CHECK(read.template getTableMetaData<std::string>("DataRate") == "100");
+    CHECK_FALSE(read.hasTableMetaDataKey("numTrials"));
+    const auto& units = dynamic_cast<const ValueArray<std::string>&>(
+            read.getDependentsMetaData().getValueArrayForKey("units"));
+    REQUIRE(units.size() == 3);
+    CHECK(units[2].get() == "N");
+
+    // A table of another type cannot be read from this file.
+    if (std::is_same<T, double>::value) {
+        CHECK_THROWS_AS(BinaryTimeSeriesFileAdapter::readTimeRange<
+                SimTK::Vec3>(fileName, 0, 1), IncorrectTableType);
+    } else {
+        CHECK_THROWS_AS(BinaryTimeSeriesFileAdapter::readTimeRange<double>(
+                fileName, 0, 1), IncorrectTableType);
+    }
+}
+
+} // anonymous namespace
+
+TEST_CASE("BinaryTimeSeriesFileAdapter round trip") {
+    for (bool compressed : {true, false}) {
+        CAPTURE(compressed);
+        testRoundTrip<double>(compressed);
+        testRoundTrip<SimTK::Vec3>(compressed);
+        testRoundTrip<SimTK::Quaternion>(compressed);
+        testRoundTrip<SimTK::SpatialVec>(compressed);
+    }
+}
+
+TEST_CASE("BinaryTimeSeriesFileAdapter reads time ranges") {
+    const std::string fileName = "testBinaryTimeSeriesFileAdapter_range.bsto";
+    FileRemover fileRemover(fileName);
+    const auto table = createTable<SimTK::Vec3>(10000);
+    BinaryTimeSeriesFileAdapter adapter;
+    adapter.setNumRowsPerBlock(100);
+    adapter.writeTable(table, fileName);
+    CHECK(BinaryTimeSeriesFileAdapter::readDataType(fileName) == "Vec3");
+
+    SECTION("Window within the table") {
+        // The times are not exactly multiples of 0.01, so choose bounds
+        // between samples.
+        const auto window = BinaryTimeSeriesFileAdapter::readTimeRange<
+                SimTK::Vec3>(fileName, 30.005, 40.005);
+        REQUIRE(window.getNumRows() == 1000);
+        checkRows(table, window, 3001);
+        CHECK(window.getTableMetaData<std::string>("DataRate") == "100");
+    }
+    SECTION("Window bounds at sample times") {
+        const auto& times = table.getIndependentColumn();
+        const auto window = BinaryTimeSeriesFileAdapter::readTimeRange<
+                SimTK::Vec3>(fileName, times[99], times[200]);
+        REQUIRE(window.getNumRows() == 102);
+        checkRows(table, window, 99);
+    }
+    SECTION("Window overlapping the ends of the table") {
+        const auto all = BinaryTimeSeriesFileAdapter::readTimeRange<
+                SimTK::Vec3>(fileName, -5, 500);
+        REQUIRE(all.getNumRows() == table.getNumRows());
+        checkRows(table, all, 0);
+    }
+    SECTION("Window outside the table") {
+        const auto none = BinaryTimeSeriesFileAdapter::readTimeRange<
+                SimTK::Vec3>(fileName, 200, 300);
+        CHECK(none.getNumRows() == 0);
+        CHECK(none.getNumColumns() == 3);
+    }
+    SECTION("Invalid window") {
+        CHECK_THROWS_AS(BinaryTimeSeriesFileAdapter::readTimeRange<
+                SimTK::Vec3>(fileName, 2, 1), InvalidArgument);
+    }
+}
+
+TEST_CASE("BinaryTimeSeriesFileAdapter with FileAdapter interface") {
+    const std::string fileName =
+            "testBinaryTimeSeriesFileAdapter_generic.bsto";
+    FileRemover fileRemover(fileName);
+    const auto table = createTable<double>(50);
+    DataAdapter::InputTables tables{};
+    tables.emplace(BinaryTimeSeriesFileAdapter::_table, &table);
+    FileAdapter::writeFile(tables, fileName);
+
+    auto outputTables =
+            FileAdapter::createAdapterFromExtension(fileName)->read(fileName);
+    REQUIRE(outputTables.size() == 1);
+    const auto read = dynamic_cast<TimeSeriesTable*>(
+            outputTables.at(BinaryTimeSeriesFileAdapter::_table).get());
+    REQUIRE(read != nullptr);
+    checkRows(table, *read, 0);
+
+    // An empty table.
+    TimeSeriesTable empty;
+    empty.setColumnLabels({"a", "b"});
+    BinaryTimeSeriesFileAdapter::write(empty, fileName);
+    TimeSeriesTable readEmpty(fileName);
+    CHECK(readEmpty.getNumRows() == 0);
+    CHECK(readEmpty.getColumnLabels() == empty.getColumnLabels());
+
+    CHECK_THROWS_AS(BinaryTimeSeriesFileAdapter::readDataType(
+            "testBinaryTimeSeriesFileAdapter_missing.bsto"),
+            FileDoesNotExist);
+}
@@ -194,9 +194,74 @@ void test(const std::string filename) {
     cout << "\tcop_" << forces_file << " is equivalent to its standard."<< endl;
 }
 
+void testParallelRead() {
+    using namespace OpenSim;
+    using namespace std;
+
+    const vector<string> filenames{"walking2.c3d", "walking5.c3d"};
+    for(const auto location : {C3DFileAdapter::ForceLocation::OriginOfForcePlate,
+                               C3DFileAdapter::ForceLocation::CenterOfPressure}) {
+        C3DFileAdapter serialAdapter{};
+        serialAdapter.setLocationForForceExpression(location);
+        C3DFileAdapter parallelAdapter{serialAdapter};
+        parallelAdapter.setMaxNumThreads(4);
+
+        vector<DataAdapter::OutputTables> serialTables{};
+        for(const auto& filename : filenames) {
+            serialTables.push_back(serialAdapter.read(filename));
+            auto parallelTables = parallelAdapter.read(filename);
+            // Reading with multiple threads gives the same tables.
+            compare_tables<SimTK::Vec3>(
+                    *serialAdapter.getMarkersTable(serialTables.back()),
+                    *parallelAdapter.getMarkersTable(parallelTables), 0);
+            compare_tables<SimTK::Vec3>(
+                    *serialAdapter.getForcesTable(serialTables.back()),
+                    *parallelAdapter.getForcesTable(parallelTables), 0);
+        }
+
+        // Read each file several times in a batch.
+        vector<string> batch{};
+        for(int i = 0; i < 3; ++i)
+            batch.insert(batch.end(), filenames.begin(), filenames.end());
+        vector<int> numMarkerRows(batch.size(), -1);
+        vector<int> numForceRows(batch.size(), -1);
+        serialAdapter.readFiles(batch,
+                [&](size_t i, DataAdapter::OutputTables& tables) {
+                    numMarkerRows[i] = (int)tables.at(C3DFileAdapter::_markers)
+                                                ->getNumRows();
+                    numForceRows[i] = (int)tables.at(C3DFileAdapter::_forces)
+                                               ->getNumRows();
+                }, 3);
+        for(size_t i = 0; i < batch.size(); ++i) {
+            auto& tables = serialTables[i % filenames.size()];
+            ASSERT_EQUAL(numMarkerRows[i], (int)serialAdapter
+                    .getMarkersTable(tables)->getNumRows(),
+                    __FILE__, __LINE__);
+            ASSERT_EQUAL(numForceRows[i], (int)serialAdapter
+                    .getForcesTable(tables)->getNumRows(),
+                    __FILE__, __LINE__);
+        }
+    }
+
+    // The error for the first failing file (by index) is reported.
+    try {
+        C3DFileAdapter{}.readFiles(filenames,
+                [](size_t i, DataAdapter::OutputTables&) {
+                    OPENSIM_THROW(Exception,
+                                  "Failed file " + std::to_string(i) + ".");
+                }, 2);
+        ASSERT(false, __FILE__, __LINE__, "Expected an exception.");
+    } catch(const OpenSim::Exception& e) {
+        ASSERT(string(e.what()).find("Failed file 0.") != string::npos,
+               __FILE__, __LINE__,
+               "Expected the error for file 0, got: " + string(e.what()));
+    }
+}
+
 int main() {
     SimTK_START_TEST("testC3DFileAdapter");
         SimTK_SUBTEST1(test, "walking2.c3d");
         SimTK_SUBTEST1(test, "walking5.c3d");
+        SimTK_SUBTEST(testParallelRead);
     SimTK_END_TEST();
 }
@@ -969,6 +969,33 @@ void testComponentPathNames()
     std::string absPathE = E->getAbsolutePathString();
     ASSERT(absPathE == "/A/D/E");
 
+    // The absolute path is stored when connections are finalized, and a
+    // rename along it is reflected immediately, without finalizing the tree
+    // again.
+    top.connect();
+    ASSERT(E->getAbsolutePathString() == absPathE);
+    ASSERT(E->getAbsolutePath() == ComponentPath(absPathE));
+    D->setName("D2");
+    ASSERT(E->getAbsolutePathString() == "/A/D2/E");
+    ASSERT(E->getAbsolutePath() == ComponentPath("/A/D2/E"));
+    ASSERT(D->getAbsolutePathString() == "/A/D2");
+    E->setName("E2");
+    ASSERT(E->getAbsolutePathString() == "/A/D2/E2");
+    ASSERT(E->getAbsolutePath() == ComponentPath("/A/D2/E2"));
+    // A rename to a name that is a suffix of the stored one.
+    E->setName("2");
+    ASSERT(E->getAbsolutePathString() == "/A/D2/2");
+    E->setName("E");
+    D->setName("D");
+    ASSERT(E->getAbsolutePathString() == absPathE);
+    ASSERT(E->getAbsolutePath() == ComponentPath(absPathE));
+    top.connect();
+    D->setName("D2");
+    top.connect();
+    ASSERT(E->getAbsolutePathString() == "/A/D2/E");
+    D->setName("D");
+    ASSERT(E->getAbsolutePathString() == absPathE);
+
     // Specific tests to relative path name facilities
     std::string EWrtB = E->getRelativePathString(*B);
     ASSERT(EWrtB == "../D/E"); // "/A/B/" as common
@@ -1276,6 +1303,57 @@ void testGetStateVariableValueComponentPath() {
             OpenSim::Exception);
 }
 
+void testStateVariableHandle() {
+
+    TheWorld top;
+    top.setName("top");
+    Sub* a = new Sub();
+    a->setName("a");
+    Sub* b = new Sub();
+    b->setName("b");
+
+    top.add(a);
+    a->addComponent(b);
+
+    MultibodySystem system;
+    top.buildUpSystem(system);
+    State s = system.realizeTopology();
+
+    s.updY()[0] = 10; // "top/internalSub/subState"
+    s.updY()[1] = 20; // "top/a/subState"
+    s.updY()[2] = 30; // "top/a/b/subState"
+
+    const auto hInternal = top.getStateVariableHandle("internalSub/subState");
+    const auto hA = top.getStateVariableHandle("/a/subState");
+    const auto hB = b->getStateVariableHandle("subState");
+    SimTK_TEST(hA.isValid());
+    SimTK_TEST(hA.getName() == "subState");
+    SimTK_TEST(&hB.getOwner() == b);
+
+    SimTK_TEST(top.getStateVariableValue(s, hInternal) == 10);
+    SimTK_TEST(top.getStateVariableValue(s, hA) == 20);
+    SimTK_TEST(a->getStateVariableValue(s, hB) == 30);
+
+    top.setStateVariableValue(s, hB, 40);
+    SimTK_TEST(s.getY()[2] == 40);
+    SimTK_TEST(top.getStateVariableValue(s, "a/b/subState") == 40);
+
+    // getStateVariableValues() lists the state variables in the same order
+    // as getStateVariableNames().
+    const auto names = top.getStateVariableNames();
+    const auto values = top.getStateVariableValues(s);
+    for (int i = 0; i < names.size(); ++i) {
+        SimTK_TEST(values[i] == top.getStateVariableValue(s, names[i]));
+    }
+
+    SimTK_TEST_MUST_THROW_EXC(top.getStateVariableHandle("typo/b/subState"),
+            OpenSim::Exception);
+    SimTK_TEST_MUST_THROW_EXC(
+            top.getStateVariableValue(s, Component::StateVariableHandle()),
+            OpenSim::Exception);
+
+}
+
 void testInputOutputConnections()
 {
     {
@@ -2556,6 +2634,7 @@ int main() {
         SimTK_SUBTEST(testTraversePathToComponent);
         SimTK_SUBTEST(testGetStateVariableValue);
         SimTK_SUBTEST(testGetStateVariableValueComponentPath);
+        SimTK_SUBTEST(testStateVariableHandle);
         SimTK_SUBTEST(testInputOutputConnections);
         SimTK_SUBTEST(testInputConnecteePaths);
         SimTK_SUBTEST(testExceptionsForConnecteeTypeMismatch);
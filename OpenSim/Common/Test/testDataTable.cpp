@@ -27,6 +27,7 @@
 #include <OpenSim/Auxiliary/catch.hpp>
 #include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/PiecewiseLinearFunction.h>
+#include <OpenSim/Common/Signal.h>
 #include <OpenSim/Common/TableUtilities.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
@@ -785,6 +786,109 @@ TEST_CASE("DataTable") {
     }
 }
 
+TEST_CASE("DataTable appendRow with reserved rows") {
+    const int numRows = 1000;
+    const auto rowValue = [](int irow, int icol) {
+        return 10.0 * irow + icol;
+    };
+
+    SECTION("Appending without reserve()") {
+        TimeSeriesTable table;
+        table.setColumnLabels({"a", "b", "c"});
+        for (int irow = 0; irow < numRows; ++irow) {
+            table.appendRow(0.01 * irow, {rowValue(irow, 0),
+                                          rowValue(irow, 1),
+                                          rowValue(irow, 2)});
+            // Rows reserved by appendRow() are not part of the table.
+            REQUIRE(table.getNumRows() == (size_t)(irow + 1));
+            CHECK(table.getRowAtIndex(irow)[2] == rowValue(irow, 2));
+        }
+        REQUIRE(table.getMatrix().nrow() == numRows);
+        REQUIRE(table.getMatrix().ncol() == 3);
+        REQUIRE(table.getDependentColumn("b").size() == numRows);
+        for (int irow = 0; irow < numRows; ++irow) {
+            for (int icol = 0; icol < 3; ++icol) {
+                CHECK(table.getMatrix()(irow, icol) == rowValue(irow, icol));
+            }
+        }
+
+        // Appending after accessing the matrix.
+        table.appendRow(0.01 * numRows, {1, 2, 3});
+        REQUIRE(table.getNumRows() == (size_t)(numRows + 1));
+        CHECK(table.getMatrix().nrow() == numRows + 1);
+        CHECK(table.getMatrix()(numRows, 2) == 3);
+    }
+
+    SECTION("Appending after reserve()") {
+        TimeSeriesTable_<Vec3> table;
+        table.setColumnLabels({"a", "b"});
+        table.reserve(numRows);
+        CHECK(table.getNumRows() == 0);
+        for (int irow = 0; irow < numRows; ++irow) {
+            table.appendRow(0.01 * irow, {Vec3(rowValue(irow, 0)),
+                                          Vec3(rowValue(irow, 1))});
+        }
+        REQUIRE(table.getNumRows() == (size_t)numRows);
+        CHECK(table.getMatrix().nrow() == numRows);
+        CHECK(table.getRowAtIndex(numRows - 1)[1] ==
+                Vec3(rowValue(numRows - 1, 1)));
+
+        // Reserving fewer rows than the table has is a no-op.
+        table.reserve(10);
+        CHECK(table.getNumRows() == (size_t)numRows);
+    }
+
+    SECTION("Reserved rows are not copied into modifications") {
+        TimeSeriesTable table;
+        table.setColumnLabels({"a", "b"});
+        table.reserve(2 * numRows);
+        for (int irow = 0; irow < numRows; ++irow) {
+            table.appendRow(0.01 * irow, {rowValue(irow, 0),
+                                          rowValue(irow, 1)});
+        }
+
+        TimeSeriesTable copy = table;
+        REQUIRE(copy.getNumRows() == (size_t)numRows);
+        CHECK(copy.getMatrix().nrow() == numRows);
+
+        table.removeRowAtIndex(0);
+        REQUIRE(table.getNumRows() == (size_t)(numRows - 1));
+        CHECK(table.getMatrix()(0, 1) == rowValue(1, 1));
+
+        copy.appendColumn("c", Vector(numRows, 1.0));
+        REQUIRE(copy.getNumColumns() == 3);
+        CHECK(copy.getMatrix().nrow() == numRows);
+
+        copy.trim(0.1, 0.2);
+        CHECK(copy.getMatrix().nrow() == (int)copy.getNumRows());
+    }
+
+    SECTION("Read-only accessors do not release reserved rows") {
+        TimeSeriesTable table;
+        table.setColumnLabels({"a", "b"});
+        table.reserve(numRows);
+        for (int irow = 0; irow < 3; ++irow) {
+            table.appendRow(0.01 * irow, {rowValue(irow, 0),
+                                          rowValue(irow, 1)});
+        }
+        const TimeSeriesTable& constTable = table;
+        const auto matrix = constTable.getMatrix();
+        const auto column = constTable.getDependentColumn("b");
+        CHECK(matrix.nrow() == 3);
+        CHECK(column.size() == 3);
+        CHECK(constTable.getDependentColumnAtIndex(0).size() == 3);
+        CHECK(constTable.getMatrixBlock(1, 0, 2, 2).nrow() == 2);
+
+        // Appending into the reserved rows does not reallocate, so the views
+        // above still refer to the table's data.
+        table.appendRow(0.03, {rowValue(3, 0), rowValue(3, 1)});
+        CHECK(matrix(2, 1) == rowValue(2, 1));
+        CHECK(column[0] == rowValue(0, 1));
+        CHECK(constTable.getMatrix().nrow() == 4);
+        CHECK(constTable.getDependentColumn("a")[3] == rowValue(3, 0));
+    }
+}
+
 TEST_CASE("TableUtilities::checkNonUniqueLabels") {
     CHECK_THROWS_AS(TableUtilities::checkNonUniqueLabels({"a", "a"}),
                     NonUniqueLabels);
@@ -861,6 +965,44 @@ TEST_CASE("TableUtilities::filterLowpass") {
     }
 }
 
+TEST_CASE("TableUtilities::filterLowpass with many columns") {
+    // Enough rows and columns to filter the columns in blocks on multiple
+    // threads, with a partial last block.
+    const int numRows = 5000;
+    const int numColumns = 43;
+    // The time step is exact in binary, so that the table is not resampled.
+    const double dt = 1.0 / 1024.0;
+    std::vector<double> time(numRows);
+    for (int i = 0; i < numRows; ++i) time[i] = dt * i;
+    TimeSeriesTable table(time);
+    for (int icol = 0; icol < numColumns; ++icol) {
+        table.appendColumn(std::to_string(icol),
+                SimTK::Test::randVector(numRows));
+    }
+    const TimeSeriesTable original = table;
+
+    TableUtilities::filterLowpass(table, 6.0);
+
+    // Compare to filtering each column separately.
+    SimTK::Vector expected(numRows);
+    for (int icol = 0; icol < numColumns; ++icol) {
+        CAPTURE(icol);
+        Signal::LowpassIIR(dt, 6.0, numRows,
+                original.getDependentColumnAtIndex(icol)
+                        .getContiguousScalarData(),
+                expected.updContiguousScalarData());
+        const auto& filtered = table.getDependentColumnAtIndex(icol);
+        for (int i = 0; i < numRows; ++i) {
+            REQUIRE(filtered[i] == Approx(expected[i]).margin(1e-12));
+        }
+    }
+
+    // Too few points.
+    std::vector<const double*> signals(1, expected.getContiguousScalarData());
+    std::vector<double*> filtered(1, expected.updContiguousScalarData());
+    CHECK(Signal::LowpassIIR(dt, 6.0, 3, signals, filtered) == -1);
+}
+
 TEST_CASE("TableUtilities::pad") {
     Storage sto("test.sto");
     TimeSeriesTable paddedTable = sto.exportToTable();
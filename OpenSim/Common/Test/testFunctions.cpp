@@ -24,9 +24,12 @@
 #include "ComponentsForTesting.h"
 
 #include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/GCVSpline.h>
 #include <OpenSim/Common/MultivariatePolynomialFunction.h>
+#include <OpenSim/Common/PiecewiseLinearFunction.h>
 #include <OpenSim/Common/Reporter.h>
 #include <OpenSim/Common/SignalGenerator.h>
+#include <OpenSim/Common/SimmSpline.h>
 #include <OpenSim/Common/Sine.h>
 
 #define CATCH_CONFIG_MAIN
@@ -92,6 +95,67 @@ TEST_CASE("Interpolate using PiecewiseLinearFunction") {
     SimTK_TEST(SimTK::isNaN(newY[3]));
 }
 
+TEST_CASE("calcValue() with a scalar argument and interval hint") {
+    // Unevenly spaced abscissae.
+    const int n = 20;
+    std::vector<double> x(n), y(n);
+    for (int i = 0; i < n; ++i) {
+        x[i] = 0.1 * i + 0.01 * i * i;
+        y[i] = std::sin(3 * x[i]);
+    }
+    PiecewiseLinearFunction plf(n, x.data(), y.data());
+    SimmSpline simm(n, x.data(), y.data());
+    GCVSpline gcv(5, n, x.data(), y.data());
+    const std::vector<const Function*> functions{&plf, &simm, &gcv};
+
+    // Increasing (including knots and extrapolation), then decreasing, then
+    // random arguments, all with the same hint.
+    std::vector<double> args;
+    for (int i = -10; i <= 450; ++i) args.push_back(0.01 * i);
+    for (int i = 0; i < n; ++i) args.push_back(x[i]);
+    for (int i = 450; i >= -10; --i) args.push_back(0.01 * i);
+    SimTK::Random::Uniform random(x[0], x[n-1]);
+    random.setSeed(0);
+    for (int i = 0; i < 200; ++i) args.push_back(random.getValue());
+
+    for (const auto* f : functions) {
+        CAPTURE(f->getConcreteClassName());
+        int hint = 0;
+        for (const double arg : args) {
+            const double expected = f->calcValue(SimTK::Vector(1, arg));
+            CHECK(f->calcValue(arg) == expected);
+            // At the knots, the hinted interval may differ from the interval
+            // found by the binary search.
+            CHECK(f->calcValue(arg, hint) == Approx(expected).margin(1e-12));
+        }
+    }
+
+    // Any initial hint is valid.
+    for (int hint : {-5, 0, n - 2, n - 1, 100}) {
+        CHECK(plf.calcValue(1.234, hint) == plf.calcValue(1.234));
+        CHECK(simm.calcValue(1.234, hint) == simm.calcValue(1.234));
+        CHECK(gcv.calcValue(1.234, hint) ==
+                Approx(gcv.calcValue(1.234)).margin(1e-12));
+    }
+
+    // GCVSpline uses the hint for each supported degree, and a copy (whose
+    // coefficients are computed on first use) gives the same values.
+    for (int degree : {1, 3, 5, 7}) {
+        CAPTURE(degree);
+        GCVSpline spline(degree, n, x.data(), y.data());
+        const GCVSpline copy(spline);
+        int hint = 0;
+        int copyHint = n;
+        for (const double arg : args) {
+            const double expected = spline.calcValue(arg);
+            CHECK(spline.calcValue(arg, hint) ==
+                    Approx(expected).margin(1e-12));
+            CHECK(copy.calcValue(arg, copyHint) ==
+                    Approx(expected).margin(1e-12));
+        }
+    }
+}
+
 TEST_CASE("MultivariatePolynomialFunction") {
     SECTION("Input errors") {
         {
@@ -141,7 +205,8 @@ TEST_CASE("MultivariatePolynomialFunction") {
                           c[8]*y*y*z + c[9]*y*y*y + c[10]*x + c[11]*x*z +
                           c[12]*x*z*z + c[13]*x*y + c[14]*x*y*z + c[15]*x*y*y +
                           c[16]*x*x + c[17]*x*x*z + c[18]*x*x*y + c[19]*x*x*x;
-        CHECK(f.calcValue(input) == expected);
+        // The Horner scheme sums the terms in a different order.
+        CHECK(f.calcValue(input) == Approx(expected).epsilon(1e-12));
     }
     SECTION("Test 4-dimensional 1st order polynomial") {
         SimTK::Vector c = SimTK::Test::randVector(5);
@@ -149,7 +214,66 @@ TEST_CASE("MultivariatePolynomialFunction") {
         SimTK::Vector input = createVector({0.3, 7.3, 0.8, 6.4});
         double expected = c[0] + c[1] * input[3] + c[2] * input[2] +
                           c[3] * input[1] + c[4] * input[0];
-        CHECK(f.calcValue(input) == expected);
+        CHECK(f.calcValue(input) == Approx(expected).epsilon(1e-12));
+    }
+    SECTION("Value and gradient match term-by-term evaluation") {
+        for (int dimension = 1; dimension <= 4; ++dimension) {
+            for (int order = 0; order <= 4; ++order) {
+                CAPTURE(dimension, order);
+                // Exponents of each term, in the order of the coefficients.
+                std::vector<std::array<int, 4>> exponents;
+                std::array<int, 4> e{{0, 0, 0, 0}};
+                for (e[0] = 0; e[0] <= order; ++e[0]) {
+                    const int n1 = dimension < 2 ? 0 : order - e[0];
+                    for (e[1] = 0; e[1] <= n1; ++e[1]) {
+                        const int n2 =
+                                dimension < 3 ? 0 : order - e[0] - e[1];
+                        for (e[2] = 0; e[2] <= n2; ++e[2]) {
+                            const int n3 = dimension < 4
+                                    ? 0 : order - e[0] - e[1] - e[2];
+                            for (e[3] = 0; e[3] <= n3; ++e[3])
+                                exponents.push_back(e);
+                        }
+                    }
+                }
+
+                SimTK::Vector c = SimTK::Test::randVector(
+                        (int)exponents.size());
+                MultivariatePolynomialFunction f(c, dimension, order);
+                SimTK::Vector input = createVector({0.3, -1.7, 0.8, 1.4});
+                input.resizeKeep(dimension);
+
+                double expected = 0;
+                SimTK::Vector expectedGradient(dimension, 0.0);
+                for (int t = 0; t < (int)exponents.size(); ++t) {
+                    double term = c[t];
+                    for (int i = 0; i < dimension; ++i)
+                        term *= std::pow(input[i], exponents[t][i]);
+                    expected += term;
+                    for (int k = 0; k < dimension; ++k) {
+                        if (exponents[t][k] == 0) continue;
+                        double dterm = c[t] * exponents[t][k];
+                        for (int i = 0; i < dimension; ++i) {
+                            dterm *= std::pow(input[i],
+                                    exponents[t][i] - (i == k ? 1 : 0));
+                        }
+                        expectedGradient[k] += dterm;
+                    }
+                }
+
+                SimTK::Vector gradient;
+                const double value = f.calcValueAndGradient(input, gradient);
+                CHECK(value == Approx(expected).margin(1e-12));
+                CHECK(f.calcValue(input) == Approx(expected).margin(1e-12));
+                REQUIRE(gradient.size() == dimension);
+                for (int k = 0; k < dimension; ++k) {
+                    CHECK(gradient[k] ==
+                            Approx(expectedGradient[k]).margin(1e-12));
+                    CHECK(f.calcDerivative({k}, input) ==
+                            Approx(expectedGradient[k]).margin(1e-12));
+                }
+            }
+        }
     }
 }
 
@@ -22,8 +22,11 @@
 
 #include <OpenSim/Common/GCVSpline.h>
 #include <OpenSim/Common/GCVSplineSet.h>
+#include <OpenSim/Common/Storage.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
+#include <memory>
+
 using namespace OpenSim;
 using namespace std;
 
@@ -82,6 +85,113 @@ int main() {
                 SimTK::Eps, __FILE__, __LINE__,
                 "Duplicate GCVSpline failed to reproduce identical first derivative.");
         }
+
+        // evaluateAll() must match evaluating each spline individually, also
+        // for splines whose knots differ from those of the other splines.
+        TimeSeriesTable table(std::vector<double>(x, x + size));
+        for (int icol = 0; icol < 4; ++icol) {
+            SimTK::Vector column(size);
+            for (int i = 0; i < size; ++i)
+                column[i] = sin((icol + 1)*omega*x[i]) + 0.1*icol;
+            table.appendColumn("col" + std::to_string(icol), column);
+        }
+        GCVSplineSet splineSet(table);
+        double xOther[size];
+        for (int i = 0; i < size; ++i) xOther[i] = 1.2*T*i/(size - 1) - 0.1;
+        splineSet.adoptAndAppend(new GCVSpline(3, size, xOther, y, "other"));
+        splineSet.adoptAndAppend(new GCVSpline(5, size, x, y, "last"));
+
+        SimTK::Vector values;
+        for (int derivOrder = 0; derivOrder <= 2; ++derivOrder) {
+            const std::vector<int> derivs(derivOrder, 0);
+            for (int i = 0; i < (2*size-1); ++i) {
+                t[0] = dt / 2 * i;
+                splineSet.evaluateAll(t[0], derivOrder, values);
+                ASSERT(values.size() == splineSet.getSize());
+                for (int j = 0; j < splineSet.getSize(); ++j) {
+                    const GCVSpline& s = *splineSet.getGCVSpline(j);
+                    const double expected = derivOrder == 0 ?
+                            s.calcValue(t) : s.calcDerivative(derivs, t);
+                    ASSERT_EQUAL(expected, values[j],
+                        1e-10*(1 + std::abs(expected)), __FILE__, __LINE__,
+                        "GCVSplineSet::evaluateAll() does not match the "
+                        "individual splines.");
+                }
+            }
+        }
+        cout << "GCVSplineSet::evaluateAll() matches the individual splines."
+             << endl;
+
+        // With a hint, at increasing and then decreasing arguments, the
+        // values are the same as without a hint. Storage::resample() uses
+        // the hint through constructStorage().
+        {
+            SimTK::Vector hinted;
+            int hint = 0;
+            for (int i = -2; i < 2*(2*size-1); ++i) {
+                t[0] = dt / 2 * (i < 2*size-1 ? i : 2*(2*size-1) - i);
+                splineSet.evaluateAll(t[0], 0, values);
+                splineSet.evaluateAll(t[0], 0, hinted, hint);
+                for (int j = 0; j < splineSet.getSize(); ++j) {
+                    ASSERT_EQUAL(values[j], hinted[j], 0.0, __FILE__,
+                        __LINE__, "GCVSplineSet::evaluateAll() with a hint "
+                        "does not match evaluateAll() without a hint.");
+                }
+            }
+            std::unique_ptr<Storage> resampled(
+                    splineSet.constructStorage(0, dt / 3));
+            ASSERT(resampled->getSize() > size);
+            for (int i = 0; i < resampled->getSize(); ++i) {
+                const StateVector& row = *resampled->getStateVector(i);
+                splineSet.evaluateAll(row.getTime(), 0, values);
+                for (int j = 0; j < splineSet.getSize(); ++j) {
+                    ASSERT_EQUAL(values[j], row.getData()[j], 0.0, __FILE__,
+                        __LINE__, "GCVSplineSet::constructStorage() does not "
+                        "match evaluateAll().");
+                }
+            }
+        }
+
+        // Splines fit in parallel (and with the shared factorization for
+        // errorVariance = 0) must match splines fit one at a time.
+        const int numRows = 2001;
+        const int numCols = 60;
+        std::vector<double> bigTime(numRows);
+        for (int i = 0; i < numRows; ++i) bigTime[i] = 0.001*i;
+        TimeSeriesTable bigTable(bigTime);
+        const auto& time = bigTable.getIndependentColumn();
+        for (int icol = 0; icol < numCols; ++icol) {
+            SimTK::Vector column(numRows);
+            for (int i = 0; i < numRows; ++i)
+                column[i] = sin((1 + 0.1*icol)*omega*time[i]) +
+                            0.01*cos(97.0*i + icol);
+            bigTable.appendColumn("col" + std::to_string(icol), column);
+        }
+        for (const double errorVariance : {0.0, 1e-4, -1.0}) {
+            for (const int degree : {3, 5}) {
+                GCVSplineSet parallelSet(
+                        bigTable, {}, degree, errorVariance, 4);
+                ASSERT(parallelSet.getSize() == numCols);
+                for (int icol = 0; icol < numCols; icol += 7) {
+                    const auto& column =
+                            bigTable.getDependentColumnAtIndex(icol);
+                    GCVSpline serial(degree, numRows, time.data(), &column[0],
+                            "", errorVariance);
+                    const GCVSpline& parallel =
+                            *parallelSet.getGCVSpline(icol);
+                    for (int i = 0; i < numRows - 1; i += 13) {
+                        t[0] = 0.5*(time[i] + time[i + 1]);
+                        const double expected = serial.calcValue(t);
+                        ASSERT_EQUAL(expected, parallel.calcValue(t),
+                            1e-10*(1 + std::abs(expected)), __FILE__, __LINE__,
+                            "GCVSplineSet fit in parallel does not match "
+                            "GCVSpline.");
+                    }
+                }
+            }
+        }
+        cout << "GCVSplineSet fit in parallel matches the individual splines."
+             << endl;
     }
     catch(const Exception& e) {
         e.print(cerr);
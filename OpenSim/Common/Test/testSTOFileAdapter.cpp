@@ -22,6 +22,8 @@
 
 #include "OpenSim/Common/Adapters.h"
 #include "OpenSim/Common/CommonUtilities.h"
+#include "OpenSim/Common/Stopwatch.h"
+#include "OpenSim/Common/Storage.h"
 #include <cstdio>
 #include <fstream>
 #include <unordered_set>
@@ -353,3 +355,448 @@ TEST_CASE("Trimming whitespace in metadata values") {
 
 
 
+
+namespace {
+// Write an STO file with numRows rows and numColumns data columns. The numbers
+// use a variety of formats.
+void writeLargeSTOFile(const std::string& filename, int numRows,
+        int numColumns) {
+    std::ofstream out(filename);
+    out << "largeFile\nversion=1\nnRows=" << numRows
+        << "\nnColumns=" << numColumns + 1
+        << "\ninDegrees=no\nendheader\ntime";
+    for (int icol = 0; icol < numColumns; ++icol) out << "\tc" << icol;
+    out << "\n";
+    SimTK::Random::Uniform random(-1000, 1000);
+    random.setSeed(0);
+    char number[64];
+    for (int irow = 0; irow < numRows; ++irow) {
+        out << 0.01 * irow;
+        for (int icol = 0; icol < numColumns; ++icol) {
+            const double value = random.getValue();
+            switch (icol % 4) {
+            case 0: snprintf(number, sizeof(number), "%.17g", value); break;
+            case 1: snprintf(number, sizeof(number), "%.6e", value); break;
+            case 2: snprintf(number, sizeof(number), " %.9f ", value); break;
+            default: snprintf(number, sizeof(number), "%g", value); break;
+            }
+            out << "\t" << number;
+        }
+        // Mix line endings.
+        out << (irow % 3 == 0 ? "\r\n" : "\n");
+    }
+}
+
+// Read the data of an STO file line by line with FileAdapter::tokenize() and
+// std::stod() (the approach used before the rows were parsed in place).
+SimTK::Matrix readSTOFileWithStod(const std::string& filename) {
+    std::ifstream in(filename);
+    std::string line;
+    while (std::getline(in, line) && line.find("endheader") != 0) {}
+    const auto labels = FileAdapter::getNextLine(in, "\t");
+    std::vector<std::vector<double>> rows;
+    auto tokens = FileAdapter::getNextLine(in, "\t");
+    while (!tokens.empty()) {
+        std::vector<double> row;
+        for (const auto& token : tokens) row.push_back(std::stod(token));
+        rows.push_back(row);
+        tokens = FileAdapter::getNextLine(in, "\t");
+    }
+    SimTK::Matrix matrix((int)rows.size(), (int)labels.size());
+    for (int irow = 0; irow < matrix.nrow(); ++irow) {
+        for (int icol = 0; icol < matrix.ncol(); ++icol) {
+            matrix(irow, icol) = rows[irow][icol];
+        }
+    }
+    return matrix;
+}
+} // namespace
+
+TEST_CASE("STOFileAdapter reads large files identically to std::stod") {
+    const std::string filename = "testSTOFileAdapter_large.sto";
+    FileRemover fileRemover(filename);
+    // Enough rows to be parsed by multiple threads.
+    const int numRows = 20000;
+    const int numColumns = 9;
+    writeLargeSTOFile(filename, numRows, numColumns);
+
+    TimeSeriesTable table(filename);
+    const SimTK::Matrix expected = readSTOFileWithStod(filename);
+    REQUIRE(table.getNumRows() == numRows);
+    REQUIRE(table.getNumColumns() == numColumns);
+    CHECK(table.getTableMetaDataAsString("inDegrees") == "no");
+    const auto& times = table.getIndependentColumn();
+    const auto& matrix = table.getMatrix();
+    int numMismatches = 0;
+    for (int irow = 0; irow < numRows; ++irow) {
+        if (times[irow] != expected(irow, 0)) ++numMismatches;
+        for (int icol = 0; icol < numColumns; ++icol) {
+            if (matrix(irow, icol) != expected(irow, icol + 1))
+                ++numMismatches;
+        }
+    }
+    CHECK(numMismatches == 0);
+
+    SECTION("Errors are reported for the first invalid row") {
+        {
+            std::ofstream out(filename, std::ios::app);
+            out << "1000\t1\n";
+            out << "1000.1\tx\n";
+        }
+        // The header has 6 lines and the column labels are on line 7.
+        const std::string expectedLine =
+                "line " + std::to_string(7 + numRows + 1) + ".";
+        try {
+            TimeSeriesTable invalid(filename);
+            FAIL("Expected RowLengthMismatch.");
+        } catch (const RowLengthMismatch& e) {
+            CHECK(std::string(e.what()).find(expectedLine) !=
+                    std::string::npos);
+        }
+    }
+
+    SECTION("Data ends at the first empty line") {
+        {
+            std::ofstream out(filename, std::ios::app);
+            out << "\n1000\t1\n";
+        }
+        TimeSeriesTable truncated(filename);
+        CHECK(truncated.getNumRows() == numRows);
+    }
+
+    SECTION("Invalid numbers") {
+        {
+            std::ofstream out(filename, std::ios::app);
+            out << "1000";
+            for (int icol = 0; icol < numColumns; ++icol) out << "\tabc";
+            out << "\n";
+        }
+        CHECK_THROWS_AS(TimeSeriesTable(filename), std::invalid_argument);
+    }
+}
+
+TEST_CASE("STOFileAdapter reads files in blocks") {
+    const std::string filename = "testSTOFileAdapter_blocks.sto";
+    FileRemover fileRemover(filename);
+    const int numRows = 2500;
+    const int numColumns = 5;
+    writeLargeSTOFile(filename, numRows, numColumns);
+    const TimeSeriesTable table(filename);
+
+    STOFileAdapter adapter;
+    STOFileAdapter::BlockReader reader(adapter, filename);
+    CHECK(reader.getColumnLabels() == table.getColumnLabels());
+    CHECK(reader.getTableMetaData().getValueForKey("inDegrees")
+                    .getValue<std::string>() == "no");
+
+    TimeSeriesTable block;
+    std::vector<size_t> blockSizes;
+    int irow = 0;
+    int numMismatches = 0;
+    while (reader.readBlock(block, 1000)) {
+        blockSizes.push_back(block.getNumRows());
+        CHECK(block.getColumnLabels() == table.getColumnLabels());
+        CHECK(block.getTableMetaDataAsString("inDegrees") == "no");
+        for (size_t i = 0; i < block.getNumRows(); ++i, ++irow) {
+            if (block.getIndependentColumn()[i] !=
+                    table.getIndependentColumn()[irow])
+                ++numMismatches;
+            for (int icol = 0; icol < numColumns; ++icol) {
+                if (block.getMatrix()((int)i, icol) !=
+                        table.getMatrix()(irow, icol))
+                    ++numMismatches;
+            }
+        }
+    }
+    CHECK(numMismatches == 0);
+    const std::vector<size_t> expectedBlockSizes{1000, 1000, 500};
+    CHECK(blockSizes == expectedBlockSizes);
+    CHECK(reader.getNumRowsRead() == (size_t)numRows);
+    // The last block is left unchanged.
+    CHECK(block.getNumRows() == 500);
+    CHECK_FALSE(reader.readBlock(block, 1000));
+
+    CHECK_THROWS_AS(reader.readBlock(block, 0), InvalidArgument);
+    CHECK_THROWS_AS(STOFileAdapter::BlockReader(adapter, "nonexistent.sto"),
+            FileDoesNotExist);
+}
+
+TEST_CASE("STOFileAdapter reads a time range in blocks") {
+    const std::string filename = "testSTOFileAdapter_timerange.sto";
+    FileRemover fileRemover(filename);
+    const int numRows = 2500;
+    const int numColumns = 5;
+    writeLargeSTOFile(filename, numRows, numColumns);
+    const TimeSeriesTable table(filename);
+    STOFileAdapter adapter;
+
+    // Check that the rows of `range` are rows [first, last] of the table.
+    const auto checkRows = [&](const TimeSeriesTable& range, int first,
+                                int last) {
+        REQUIRE(range.getNumRows() == (size_t)(last - first + 1));
+        CHECK(range.getColumnLabels() == table.getColumnLabels());
+        CHECK(range.getTableMetaDataAsString("inDegrees") == "no");
+        int numMismatches = 0;
+        for (int i = 0; i < (int)range.getNumRows(); ++i) {
+            if (range.getIndependentColumn()[i] !=
+                    table.getIndependentColumn()[first + i])
+                ++numMismatches;
+            for (int icol = 0; icol < numColumns; ++icol) {
+                if (range.getMatrix()(i, icol) !=
+                        table.getMatrix()(first + i, icol))
+                    ++numMismatches;
+            }
+        }
+        CHECK(numMismatches == 0);
+    };
+
+    SECTION("Range spanning several blocks, with padding") {
+        // Times are 0.01 * row, so the range contains rows 501 to 1200.
+        STOFileAdapter::BlockReader reader(adapter, filename);
+        checkRows(reader.readTimeRange(5.005, 12.005, 3, 128), 498, 1203);
+        // Reading stopped with the block containing row 1204.
+        CHECK(reader.getNumRowsRead() == 1280);
+    }
+    SECTION("Without padding") {
+        STOFileAdapter::BlockReader reader(adapter, filename);
+        checkRows(reader.readTimeRange(5.005, 12.005, 0, 128), 501, 1200);
+    }
+    SECTION("Padding is limited by the start of the file") {
+        STOFileAdapter::BlockReader reader(adapter, filename);
+        checkRows(reader.readTimeRange(0, 0.015, 5, 4), 0, 6);
+    }
+    SECTION("Range extends past the end of the file") {
+        STOFileAdapter::BlockReader reader(adapter, filename);
+        checkRows(reader.readTimeRange(24.905, 100, 10, 1000),
+                  numRows - 10 - 9, numRows - 1);
+        CHECK(reader.getNumRowsRead() == (size_t)numRows);
+    }
+    SECTION("Range after the end of the file") {
+        STOFileAdapter::BlockReader reader(adapter, filename);
+        CHECK(reader.readTimeRange(30, 40, 10).getNumRows() == 0);
+    }
+    SECTION("Invalid arguments") {
+        STOFileAdapter::BlockReader reader(adapter, filename);
+        CHECK_THROWS_AS(reader.readTimeRange(1, 0), InvalidArgument);
+        CHECK_THROWS_AS(reader.readTimeRange(0, 1, 0, 0), InvalidArgument);
+    }
+}
+
+TEST_CASE("STOFileAdapter reads Vec3 files in blocks") {
+    const std::string filename = "testSTOFileAdapter_blocks_vec3.sto";
+    FileRemover fileRemover(filename);
+    TimeSeriesTableVec3 table;
+    table.setColumnLabels({"a", "b"});
+    for (int irow = 0; irow < 10; ++irow) {
+        table.appendRow(0.1 * irow, {SimTK::Vec3(double(irow), 1, 2),
+                                     SimTK::Vec3(double(-irow), 3, 4)});
+    }
+    STOFileAdapterVec3::write(table, filename);
+
+    STOFileAdapterVec3 adapter;
+    STOFileAdapterVec3::BlockReader reader(adapter, filename);
+    TimeSeriesTableVec3 block;
+    int numBlocks = 0;
+    int irow = 0;
+    while (reader.readBlock(block, 4)) {
+        ++numBlocks;
+        for (size_t i = 0; i < block.getNumRows(); ++i, ++irow) {
+            CHECK(block.getRowAtIndex(i)[1] ==
+                    SimTK::Vec3(double(-irow), 3, 4));
+        }
+    }
+    CHECK(numBlocks == 3);
+    CHECK(irow == 10);
+}
+
+TEST_CASE("TableFileWriter") {
+    const int numColumns = 3;
+    const std::vector<std::string> labels{"a", "b", "c"};
+    TableMetaData metaData;
+    metaData.setValueForKey("header", std::string("streamed"));
+    metaData.setValueForKey("inDegrees", std::string("yes"));
+    const auto value = [](int irow, int icol) { return irow + 0.25 * icol; };
+
+    SECTION("Round trip") {
+        for (const bool useBackgroundThread : {false, true}) {
+        for (const std::string extension : {".sto", ".csv"}) {
+            CAPTURE(useBackgroundThread);
+            CAPTURE(extension);
+            const std::string filename = "testTableFileWriter" + extension;
+            FileRemover fileRemover(filename);
+            // Enough rows for several blocks.
+            const int numRows = 50000;
+            {
+                TableFileWriter writer(filename, labels, metaData,
+                                       useBackgroundThread);
+                double row[numColumns];
+                for (int irow = 0; irow < numRows; ++irow) {
+                    for (int icol = 0; icol < numColumns; ++icol)
+                        row[icol] = value(irow, icol);
+                    writer.appendRow(0.125 * irow, numColumns, row);
+                    // Replaces the row above.
+                    if (irow == 10) {
+                        row[0] = -1;
+                        writer.appendRow(0.125 * irow, numColumns, row);
+                    }
+                }
+                CHECK(writer.getNumRows() == (size_t)numRows);
+                CHECK_THROWS_AS(writer.appendRow(1e6, 2, row),
+                                IncorrectNumColumns);
+                writer.close();
+                CHECK_FALSE(writer.isOpen());
+                CHECK_THROWS(writer.appendRow(1e6, numColumns, row));
+            }
+
+            const TimeSeriesTable table(filename);
+            CHECK(table.getColumnLabels() == labels);
+            REQUIRE(table.getNumRows() == (size_t)numRows);
+            CHECK(table.getTableMetaDataAsString("nRows") ==
+                    std::to_string(numRows));
+            if (extension == ".sto") {
+                CHECK(table.getTableMetaDataAsString("header") == "streamed");
+                CHECK(table.getTableMetaDataAsString("inDegrees") == "yes");
+            }
+            int numMismatches = 0;
+            for (int irow = 0; irow < numRows; ++irow) {
+                if (table.getIndependentColumn()[irow] != 0.125 * irow)
+                    ++numMismatches;
+                for (int icol = 0; icol < numColumns; ++icol) {
+                    const double expected =
+                            irow == 10 && icol == 0 ? -1 : value(irow, icol);
+                    if (table.getMatrix()(irow, icol) != expected)
+                        ++numMismatches;
+                }
+            }
+            CHECK(numMismatches == 0);
+        }
+        }
+    }
+
+    SECTION("The header is up to date before the file is closed") {
+        const std::string filename = "testTableFileWriter_flush.sto";
+        FileRemover fileRemover(filename);
+        TableFileWriter writer(filename, labels, metaData, true);
+        const double row[numColumns] = {1, 2, 3};
+        for (int irow = 0; irow < 5; ++irow)
+            writer.appendRow(irow, numColumns, row);
+        writer.flush();
+        // The last row is held back until the next row is appended.
+        const TimeSeriesTable table(filename);
+        CHECK(table.getNumRows() == 4);
+        CHECK(table.getTableMetaDataAsString("nRows") == "4");
+    }
+
+    SECTION("Flush interval") {
+        for (const bool useBackgroundThread : {false, true}) {
+            CAPTURE(useBackgroundThread);
+            const std::string filename = "testTableFileWriter_interval.sto";
+            FileRemover fileRemover(filename);
+            TableFileWriter writer(filename, labels, metaData,
+                                   useBackgroundThread);
+            CHECK_THROWS(writer.setFlushInterval(-1));
+            writer.setFlushInterval(2);
+            double row[numColumns] = {1, 2, 3};
+            for (int irow = 0; irow < 3; ++irow)
+                writer.appendRow(irow, numColumns, row);
+            // The first two rows are written, including the most recent row
+            // at the time.
+            CHECK(TimeSeriesTable(filename).getNumRows() == 2);
+
+            writer.setFlushInterval(1);
+            writer.appendRow(3, numColumns, row);
+            CHECK(TimeSeriesTable(filename).getNumRows() == 4);
+            // A row that has been written is not replaced. The time of the
+            // file is no longer strictly increasing, so we read the lines.
+            row[0] = -1;
+            writer.appendRow(3, numColumns, row);
+            CHECK(writer.getNumRows() == 5);
+            std::ifstream file(filename);
+            std::string line, lastLine;
+            bool isData = false;
+            int numLines = 0;
+            while (std::getline(file, line)) {
+                if (isData) {
+                    ++numLines;
+                    lastLine = line;
+                }
+                if (line == "endheader") isData = true;
+            }
+            // Column labels and 5 rows.
+            CHECK(numLines == 6);
+            CHECK(lastLine.substr(0, 5) == "3\t-1\t");
+        }
+    }
+
+    SECTION("Vec3 table") {
+        const std::string filename = "testTableFileWriter_vec3.sto";
+        FileRemover fileRemover(filename);
+        TimeSeriesTableVec3 table;
+        table.setColumnLabels({"m1", "m2"});
+        table.appendRow(0, {SimTK::Vec3(1, 2, 3), SimTK::Vec3(4, 5, 6)});
+        {
+            TableFileWriter writer(filename, table);
+            writer.appendRow(0.5, SimTK::RowVector_<SimTK::Vec3>(
+                    2, SimTK::Vec3(7, 8, 9)));
+            CHECK_THROWS_AS(writer.appendRow(1, SimTK::RowVector(6, 0.0)),
+                            IncorrectTableType);
+        }
+        const TimeSeriesTableVec3 read(filename);
+        REQUIRE(read.getNumRows() == 2);
+        CHECK(read.getRowAtIndex(0)[1] == SimTK::Vec3(4, 5, 6));
+        CHECK(read.getRowAtIndex(1)[0] == SimTK::Vec3(7, 8, 9));
+        CHECK_THROWS_AS(TableFileWriter("testTableFileWriter_vec3.csv", table),
+                        IncorrectTableType);
+    }
+
+    SECTION("Storage") {
+        const std::string filename = "testTableFileWriter_storage.sto";
+        FileRemover fileRemover(filename);
+        Storage storage;
+        storage.setName("streamed");
+        Array<std::string> columnLabels;
+        columnLabels.append("time");
+        for (const auto& label : labels) columnLabels.append(label);
+        storage.setColumnLabels(columnLabels);
+        const double row[numColumns] = {1, 2, 3};
+        storage.append(0, numColumns, row);
+        // With a flush interval of 1, each row is in the file as soon as it
+        // is appended.
+        storage.setOutputFileName(filename, false, 1);
+        CHECK(Storage(filename).getSize() == 1);
+        storage.append(1, numColumns, row);
+        CHECK(Storage(filename).getSize() == 2);
+        storage.append(2, numColumns, row);
+        CHECK(Storage(filename).getSize() == 3);
+        storage.closeOutputFile();
+        storage.append(3, numColumns, row);
+
+        Storage read(filename);
+        CHECK(read.getSize() == 3);
+        CHECK(read.getName() == "streamed");
+        CHECK(read.getLastTime() == 2);
+    }
+}
+
+// This benchmark is not run by default; run it with the argument
+// "[benchmark]".
+TEST_CASE("STOFileAdapter read benchmark", "[.][benchmark]") {
+    const std::string filename = "testSTOFileAdapter_benchmark.mot";
+    FileRemover fileRemover(filename);
+    // About 50 MB.
+    writeLargeSTOFile(filename, 80000, 40);
+
+    Stopwatch watch;
+    const SimTK::Matrix expected = readSTOFileWithStod(filename);
+    const auto stodTime = watch.getElapsedTimeInNs();
+
+    watch.reset();
+    TimeSeriesTable table(filename);
+    const auto adapterTime = watch.getElapsedTimeInNs();
+
+    std::cout << "tokenize() and std::stod(): "
+              << Stopwatch::formatNs(stodTime) << std::endl;
+    std::cout << "STOFileAdapter: " << Stopwatch::formatNs(adapterTime)
+              << std::endl;
+    CHECK(table.getNumRows() == expected.nrow());
+}
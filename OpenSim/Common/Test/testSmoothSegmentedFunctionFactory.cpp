@@ -1118,6 +1118,50 @@ void testMuscleCurveC2Continuity(SmoothSegmentedFunction mcf,
     cout << endl;
 }
 
+/*
+ 5. The lookup table of a SmoothSegmentedFunction will be compared against
+    the exact curve (up to the 2nd derivative) at the sample points.
+*/
+void testMuscleCurveLookupTable(SmoothSegmentedFunction mcf,
+                                SimTK::Matrix mcfSample)
+{
+    cout << "   TEST: Lookup table " << endl;
+    //Relative tolerances for the value and the 1st and 2nd derivatives.
+    SimTK::Vec3 tol(1e-7, 1e-6, 1e-5);
+
+    mcf.setUseLookupTable(true);
+    SimTK_TEST(mcf.getUseLookupTable());
+    SimTK::Vec3 maxError = mcf.getLookupTableMaxError();
+
+    double maxSampleError = 0;
+    for(int i=0; i < mcfSample.nrow(); i++){
+        double x = mcfSample(i,0);
+        for(int order=0; order <= 2; order++){
+            double exact = mcfSample(i,order+1);
+            double approx = mcf.calcDerivative(x,order);
+            double err = abs(approx-exact)/max(1.0,abs(exact));
+            maxSampleError = max(maxSampleError,err);
+            SimTK_TEST_EQ_TOL(approx,exact,tol[order]*max(1.0,abs(exact)));
+        }
+        //Higher derivatives are always evaluated exactly.
+        SimTK_TEST_EQ(mcf.calcDerivative(x,3),mcfSample(i,4));
+    }
+
+    //Turning the table off restores the exact evaluation.
+    mcf.setUseLookupTable(false);
+    SimTK_TEST(!mcf.getUseLookupTable());
+    SimTK_TEST_MUST_THROW(mcf.getLookupTableMaxError());
+    for(int i=0; i < mcfSample.nrow(); i++){
+        SimTK_TEST_EQ(mcf.calcValue(mcfSample(i,0)),mcfSample(i,1));
+    }
+
+    printf("   passed: lookup table error estimates (y, dy/dx, d2y/dx2): "
+           "%e, %e, %e\n"
+           "           maximum relative error at the sample points: %e\n",
+           maxError[0],maxError[1],maxError[2],maxSampleError);
+    cout << endl;
+}
+
 /*
  4. The MuscleCurveFunctions which are supposed to be monotonic will be
     tested for monotonicity.
@@ -1217,6 +1261,7 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(tendonCurve,tendonCurveSample);
+            testMuscleCurveLookupTable(tendonCurve,tendonCurveSample);
         //4. Test for monotonicity where appropriate
             testMonotonicity(tendonCurveSample);
 
@@ -1842,6 +1887,7 @@ int main(int argc, char* argv[])
 
         //3. Test numerically to see if the curve is C2 continuous
             testMuscleCurveC2Continuity(fiberfalCurve,fiberfalCurveSample);
+            testMuscleCurveLookupTable(fiberfalCurve,fiberfalCurveSample);
 
             //fiberfalCurve.MuscleCurveToCSVFile("C:/mjhmilla/Stanford/dev");
        
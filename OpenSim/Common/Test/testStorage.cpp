@@ -170,6 +170,89 @@ void testStorageGetStateIndexBackwardsCompatibility() {
     // TODO: Put XML document version in Storage header.
 }
 
+void testStorageFindIndex() {
+    // Each time appears twice.
+    Storage sto;
+    Array<double> row(0.0, 2);
+    for (int i = 0; i < 200; ++i) {
+        const double t = 0.01 * (i / 2);
+        row[0] = t;
+        row[1] = 2 * t;
+        sto.append(t, row, false);
+    }
+
+    // Index of the last state at or before time t (0 if t is before the
+    // first state), found by a linear scan.
+    auto findIndexLinear = [&sto](double t) {
+        int index = 0;
+        for (int i = 0; i < sto.getSize(); ++i) {
+            double ti;
+            sto.getTime(i, ti);
+            if (t < ti) break;
+            index = i;
+        }
+        return index;
+    };
+
+    for (double t = -0.1; t < 1.2; t += 0.0025) {
+        const int expected = findIndexLinear(t);
+        ASSERT(sto.findIndex(t) == expected, __FILE__, __LINE__,
+                "findIndex() does not match linear search.");
+        for (int hint : {-1, 0, 37, 100, 199, 500}) {
+            ASSERT(sto.findIndex(hint, t) == expected, __FILE__, __LINE__,
+                    "findIndex() with hint does not match linear search.");
+        }
+    }
+
+    // Interpolation at decreasing times (restarts the search from the
+    // beginning) and increasing times (gallops forward from the last index).
+    SimTK::Vector y(2);
+    for (double t = 0.99; t > 0; t -= 0.0137) {
+        sto.getDataAtTime(t, 2, y);
+        ASSERT_EQUAL(t, y[0], 1e-12, __FILE__, __LINE__);
+        ASSERT_EQUAL(2 * t, y[1], 1e-12, __FILE__, __LINE__);
+    }
+    for (double t = 0; t < 0.99; t += 0.0137) {
+        sto.getDataAtTime(t, 2, y);
+        ASSERT_EQUAL(t, y[0], 1e-12, __FILE__, __LINE__);
+        ASSERT_EQUAL(2 * t, y[1], 1e-12, __FILE__, __LINE__);
+    }
+
+    Storage empty;
+    ASSERT(empty.findIndex(0.5) == -1);
+    ASSERT(empty.findIndex(3, 0.5) == -1);
+}
+
+void testStorageGetDataColumnWithStartTime() {
+    Storage sto;
+    Array<std::string> labels;
+    labels.append("time");
+    labels.append("a");
+    labels.append("b");
+    sto.setColumnLabels(labels);
+    Array<double> row(0.0, 2);
+    for (int i = 0; i < 100; ++i) {
+        row[0] = i;
+        row[1] = -i;
+        sto.append(0.01 * i, row);
+    }
+
+    // The values are appended to those already in the array.
+    Array<double> column;
+    column.append(1000);
+    sto.getDataColumn("b", column, 0.255);
+    ASSERT(column.getSize() == 1 + 100 - 25);
+    ASSERT(column[0] == 1000);
+    for (int i = 1; i < column.getSize(); ++i) {
+        ASSERT(column[i] == -(24 + i));
+    }
+
+    Array<double> all;
+    sto.getDataColumn("a", all);
+    ASSERT(all.getSize() == 100);
+    ASSERT(all[0] == 0 && all[99] == 99);
+}
+
 int main() {
     SimTK_START_TEST("testStorage");
 
@@ -194,6 +277,10 @@ int main() {
         SimTK_SUBTEST(testStorageLegacy);
 
         SimTK_SUBTEST(testStorageGetStateIndexBackwardsCompatibility);
+
+        SimTK_SUBTEST(testStorageFindIndex);
+
+        SimTK_SUBTEST(testStorageGetDataColumnWithStartTime);
     SimTK_END_TEST();
 }
 
@@ -351,10 +351,13 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
         log_info(std::string(72, '-'));
         getProblemRep().printDescription();
     }
+    const Stopwatch setupStopwatch;
     auto casProblem = createCasOCProblem();
     auto casSolver = createCasOCSolver(*casProblem);
     if (get_verbosity()) {
         log_info("Number of threads: {}", casProblem->getJarSize());
+        log_info("Problem setup time: {}.",
+                setupStopwatch.getElapsedTimeFormatted());
     }
 
     MocoTrajectory guess = getGuess();
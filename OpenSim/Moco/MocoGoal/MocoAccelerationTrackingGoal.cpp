@@ -88,6 +88,8 @@ void MocoAccelerationTrackingGoal::initializeOnModelImpl(
 
     m_ref_splines = GCVSplineSet(accelerationTable.flatten(
         {"/acceleration_x", "/acceleration_y", "/acceleration_z"}));
+    m_refValues.resize(m_ref_splines.getSize());
+    m_refSplinesHint = 1;
 
     setRequirements(1, 1);
 }
@@ -99,7 +101,9 @@ void MocoAccelerationTrackingGoal::calcIntegrandImpl(
     getModel().realizeAcceleration(state);
     const auto& ground = getModel().getGround();
     const auto& gravity = getModel().getGravity();
-    SimTK::Vector timeVec(1, time);
+    // Spline the acceleration reference data of all frames at once.
+    m_ref_splines.evaluateAll(time, 0, m_refValues, m_refSplinesHint);
+    const SimTK::Vector& refValues = m_refValues;
 
     integrand = 0;
     Vec3 acceleration_ref(0.0);
@@ -107,10 +111,8 @@ void MocoAccelerationTrackingGoal::calcIntegrandImpl(
         auto acceleration_model =
                 m_model_frames[iframe]->getLinearAccelerationInGround(state);
 
-        // Spline the acceleration reference data.
         for (int ia = 0; ia < acceleration_ref.size(); ++ia) {
-            acceleration_ref[ia] =
-                    m_ref_splines[3*iframe + ia].calcValue(timeVec);
+            acceleration_ref[ia] = refValues[3*iframe + ia];
         }
 
         // Gravity offset.
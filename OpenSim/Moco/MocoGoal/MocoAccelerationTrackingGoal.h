@@ -185,6 +185,10 @@ private:
 
     TimeSeriesTableVec3 m_acceleration_table;
     mutable GCVSplineSet m_ref_splines;
+    // Workspace and interval hint for evaluating the reference splines, so
+    // that calcIntegrandImpl() does not allocate.
+    mutable SimTK::Vector m_refValues;
+    mutable int m_refSplinesHint = 1;
     mutable std::vector<std::string> m_frame_paths;
     mutable std::vector<SimTK::ReferencePtr<const Frame>> m_model_frames;
     mutable std::vector<double> m_acceleration_weights;
@@ -95,6 +95,7 @@ void MocoAngularVelocityTrackingGoal::initializeOnModelImpl(
 
         // Use the StatesTrajectory to create the table of angular velocity data
         // to be used in the cost.
+        angularVelocityTable.reserve(statesTraj.getSize());
         for (auto state : statesTraj) {
             // This realization ignores any SimTK::Motions prescribed in the
             // model.
@@ -127,6 +127,10 @@ protected:
             "not in the model (such data would be ignored). Default: false.");
 
     mutable GCVSplineSet m_refsplines;
+    // Workspace and interval hint for evaluating the reference splines, so
+    // that calcIntegrandImpl() does not allocate.
+    mutable SimTK::Vector m_refValues;
+    mutable int m_refSplinesHint = 1;
     mutable std::vector<SimTK::ReferencePtr<const Marker>> m_model_markers;
     mutable std::vector<int> m_refindices;
     mutable SimTK::Array_<double> m_marker_weights;
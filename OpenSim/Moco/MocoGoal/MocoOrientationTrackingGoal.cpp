@@ -94,6 +94,7 @@ void MocoOrientationTrackingGoal::initializeOnModelImpl(const Model& model)
 
         // Use the StatesTrajectory to create the table of rotation data to
         // be used in the cost.
+        rotationTable.reserve(statesTraj.getSize());
         for (auto state : statesTraj) {
             // This realization ignores any SimTK::Motions prescribed in the
             // model.
@@ -135,6 +135,8 @@ void MocoStateTrackingGoal::initializeOnModelImpl(const Model& model) const {
             m_scaleFactorRefs.emplace_back(nullptr);
         }
     }
+    m_refValues.resize(m_refsplines.getSize());
+    m_refSplinesHint = 1;
 
     setRequirements(1, 1, SimTK::Stage::Time);
 }
@@ -143,14 +145,15 @@ void MocoStateTrackingGoal::calcIntegrandImpl(
         const IntegrandInput& input, SimTK::Real& integrand) const {
     const auto& time = input.time;
 
-    SimTK::Vector timeVec(1, time);
-
     // TODO cache the reference coordinate values at the mesh points, rather
     // than evaluating the spline.
+    // Spline all reference states at once.
+    m_refsplines.evaluateAll(time, 0, m_refValues, m_refSplinesHint);
+
     integrand = 0;
     for (int iref = 0; iref < m_refsplines.getSize(); ++iref) {
         const auto& modelValue = input.state.getY()[m_sysYIndices[iref]];
-        const auto& refValue = m_refsplines[iref].calcValue(timeVec);
+        const auto& refValue = m_refValues[iref];
 
         // If a scale factor exists for this state, retrieve its value.
         double scaleFactor = 1.0;
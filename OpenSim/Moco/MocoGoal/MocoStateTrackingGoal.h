@@ -195,6 +195,10 @@ private:
     }
 
     mutable GCVSplineSet m_refsplines;
+    // Workspace and interval hint for evaluating the reference splines, so
+    // that calcIntegrandImpl() does not allocate.
+    mutable SimTK::Vector m_refValues;
+    mutable int m_refSplinesHint = 1;
     /// The indices in Y corresponding to the provided reference coordinates.
     mutable std::vector<int> m_sysYIndices;
     mutable std::vector<double> m_state_weights;
@@ -95,6 +95,7 @@ void MocoTranslationTrackingGoal::initializeOnModelImpl(const Model& model)
 
         // Use the StatesTrajectory to create the table of translation data to
         // be used in the cost.
+        translationTable.reserve(statesTraj.getSize());
         for (auto state : statesTraj) {
             // This realization ignores any SimTK::Motions prescribed in the
             // model.
@@ -522,6 +522,15 @@ public:
     std::unique_ptr<MocoProblemRep> createRepHeap() const {
         return std::unique_ptr<MocoProblemRep>(new MocoProblemRep(*this));
     }
+#ifndef SWIG
+    /// Same as createRepHeap(), but use processedModel as the model instead
+    /// of processing the ModelProcessor of the phase. Solvers use this to
+    /// process the model once when creating many MocoProblemRep%s.
+    std::unique_ptr<MocoProblemRep> createRepHeap(Model processedModel) const {
+        return std::unique_ptr<MocoProblemRep>(
+                new MocoProblemRep(*this, std::move(processedModel)));
+    }
+#endif
 
     friend MocoProblemRep;
 
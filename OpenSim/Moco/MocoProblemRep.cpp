@@ -39,7 +39,12 @@ MocoProblemRep::MocoProblemRep(const MocoProblem& problem)
         : m_problem(&problem) {
     initialize();
 }
-void MocoProblemRep::initialize() {
+MocoProblemRep::MocoProblemRep(
+        const MocoProblem& problem, Model processedModel)
+        : m_problem(&problem) {
+    initialize(&processedModel);
+}
+void MocoProblemRep::initialize(Model* processedModel) {
 
     // Clear member variables.
     m_model_base = Model();
@@ -69,8 +74,12 @@ void MocoProblemRep::initialize() {
     }
 
     const auto& ph0 = m_problem->getPhase(0);
-    // TODO: Provide directory from which to load model file.
-    m_model_base = ph0.getModelProcessor().process();
+    if (processedModel) {
+        m_model_base = std::move(*processedModel);
+    } else {
+        // TODO: Provide directory from which to load model file.
+        m_model_base = ph0.getModelProcessor().process();
+    }
 
     auto discreteControllerBaseUPtr = make_unique<DiscreteController>();
     m_discrete_controller_base.reset(discreteControllerBaseUPtr.get());
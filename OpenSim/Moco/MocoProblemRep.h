@@ -324,9 +324,13 @@ public:
 
 private:
     explicit MocoProblemRep(const MocoProblem& problem);
+    /// Use processedModel instead of processing the problem's ModelProcessor.
+    MocoProblemRep(const MocoProblem& problem, Model processedModel);
     friend MocoProblem;
 
-    void initialize();
+    /// If processedModel is not null, it is moved into ModelBase instead of
+    /// processing the problem's ModelProcessor.
+    void initialize(Model* processedModel = nullptr);
 
     /// Get a list of reference pointers to all outputs whose names (not paths)
     /// match a substring defined by a provided regex string pattern. The regex
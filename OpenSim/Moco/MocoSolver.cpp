@@ -19,10 +19,26 @@
 
 #include "MocoProblem.h"
 
+#include <future>
+
 #include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/Model/ContactMesh.h>
+#include <OpenSim/Simulation/Model/ExternalLoads.h>
 
 using namespace OpenSim;
 
+namespace {
+// ExternalLoads and ContactMesh read files relative to the working directory,
+// which they may change, when the model is connected. Models containing them
+// cannot be initialized concurrently.
+bool readsFilesWhenConnected(const Model& model) {
+    for (const auto& loads : model.getComponentList<ExternalLoads>()) {
+        if (!loads.getDataFileName().empty()) return true;
+    }
+    return model.countNumComponents<ContactMesh>() > 0;
+}
+} // namespace
+
 MocoTrajectory MocoSolver::createGuessTimeStepping() const {
     const auto& probrep = getProblemRep();
     const auto& initialTime = probrep.getTimeInitialBounds().getUpper();
@@ -104,8 +120,40 @@ void MocoSolver::setSolutionStats(MocoSolution& sol, bool success,
 std::unique_ptr<ThreadsafeJar<const MocoProblemRep>>
         MocoSolver::createProblemRepJar(int size) const {
     auto jar = OpenSim::make_unique<ThreadsafeJar<const MocoProblemRep>>();
-    for (int i = 0; i < size; ++i) {
-        jar->leave(std::unique_ptr<MocoProblemRep>(m_problem->createRepHeap()));
+    if (size <= 0) return jar;
+
+    // ModelProcessor::process() is not thread-safe: loading a model from a
+    // file changes the working directory of the process, and model operators
+    // may read other files relative to it. Process the model once, on this
+    // thread, and give each copy its own copy of the result.
+    Model processedModel = m_problem->getPhase(0).getModelProcessor().process();
+    processedModel.finalizeFromProperties();
+
+    // Create the first copy on this thread so that errors in the problem are
+    // reported once, rather than once per copy.
+    jar->leave(m_problem->createRepHeap(processedModel));
+    if (size == 1) return jar;
+
+    if (readsFilesWhenConnected(processedModel)) {
+        for (int i = 1; i < size; ++i) {
+            jar->leave(m_problem->createRepHeap(processedModel));
+        }
+        return jar;
+    }
+
+    // Each copy calls initSystem() on its models, which dominates solver
+    // startup when there are many threads. The copies only read from
+    // m_problem, and the models are copied here, so we can initialize the
+    // remaining copies concurrently. Exceptions thrown on a worker thread are
+    // rethrown by future::get().
+    std::vector<Model> models(size - 1, processedModel);
+    std::vector<std::future<std::unique_ptr<MocoProblemRep>>> futures;
+    futures.reserve(models.size());
+    for (auto& model : models) {
+        futures.push_back(std::async(std::launch::async, [this, &model] {
+            return m_problem->createRepHeap(std::move(model));
+        }));
     }
+    for (auto& future : futures) { jar->leave(future.get()); }
     return jar;
 }
@@ -94,6 +94,9 @@ protected:
     }
 
     /// Create a library of MocoProblemRep%s for use in parallelized code.
+    /// The problem's ModelProcessor is processed once, on the calling thread,
+    /// and the copies are initialized concurrently unless the model contains
+    /// components that read files when connected (e.g., ExternalLoads).
     // TODO SWIG ignore.
     std::unique_ptr<ThreadsafeJar<const MocoProblemRep>>
     createProblemRepJar(int size) const;
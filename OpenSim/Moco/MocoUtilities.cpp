@@ -93,13 +93,16 @@ MocoTrajectory OpenSim::simulateTrajectoryWithTimeStepping(
     prescribeControlsToModel(trajectory, model, "PiecewiseLinearFunction");
 
     // Add states reporter to the model.
+    const double reportTimeInterval = 0.001;
+    const SimTK::Vector& time = trajectory.getTime();
     auto* statesRep = new StatesTrajectoryReporter();
     statesRep->setName("states_reporter");
-    statesRep->set_report_time_interval(0.001);
+    statesRep->set_report_time_interval(reportTimeInterval);
+    statesRep->reserve(static_cast<size_t>(
+            (time[time.size() - 1] - time[0]) / reportTimeInterval) + 2);
     model.addComponent(statesRep);
 
     // Simulate!
-    const SimTK::Vector& time = trajectory.getTime();
     SimTK::State state = model.initSystem();
     state.setTime(time[0]);
     Manager manager(model);
@@ -280,6 +283,7 @@ TimeSeriesTable OpenSim::createExternalLoadsTableForGait(Model model,
         const std::vector<std::string>& forcePathsLeftFoot) {
     model.initSystem();
     TimeSeriesTableVec3 externalForcesTable;
+    externalForcesTable.reserve(trajectory.getSize());
     int count = 0;
     for (const auto& state : trajectory) {
         model.realizeVelocity(state);
@@ -611,3 +611,69 @@ TEST_CASE("Bhargava2004SmoothedMuscleMetabolics basics") {
 
     }
 }
+
+TEST_CASE("Bhargava2004SmoothedMuscleMetabolics per-muscle rates") {
+
+    Model model;
+    model.setName("muscles");
+    auto* body = new Body("body", 0.5, SimTK::Vec3(0), SimTK::Inertia(0));
+    model.addComponent(body);
+    auto* joint = new SliderJoint("joint", model.getGround(), *body);
+    auto& coord = joint->updCoordinate(SliderJoint::Coord::TranslationX);
+    coord.setName("x");
+    model.addComponent(joint);
+    // The first muscle does not apply force, so it is excluded from the
+    // metabolics model.
+    for (const std::string name : {"disabled", "muscle0", "muscle1"}) {
+        auto* musclePtr = new DeGrooteFregly2016Muscle();
+        musclePtr->setName(name);
+        musclePtr->set_ignore_tendon_compliance(true);
+        musclePtr->set_appliesForce(name != "disabled");
+        musclePtr->set_max_isometric_force(
+                name == "muscle1" ? 2000 : 1000);
+        musclePtr->addNewPathPoint("origin", model.updGround(), SimTK::Vec3(0));
+        musclePtr->addNewPathPoint("insertion", *body, SimTK::Vec3(0));
+        model.addComponent(musclePtr);
+    }
+
+    auto* allPtr = new Bhargava2004SmoothedMuscleMetabolics();
+    allPtr->setName("all");
+    auto* onlyMuscle1Ptr = new Bhargava2004SmoothedMuscleMetabolics();
+    onlyMuscle1Ptr->setName("only_muscle1");
+    for (const std::string name : {"disabled", "muscle0", "muscle1"}) {
+        allPtr->addMuscle(name, model.getComponent<Muscle>(name));
+    }
+    onlyMuscle1Ptr->addMuscle(
+            "muscle1", model.getComponent<Muscle>("muscle1"));
+    model.addComponent(allPtr);
+    model.addComponent(onlyMuscle1Ptr);
+    model.finalizeConnections();
+
+    auto state = model.initSystem();
+    const auto& all =
+            model.getComponent<Bhargava2004SmoothedMuscleMetabolics>("all");
+    const auto& onlyMuscle1 =
+            model.getComponent<Bhargava2004SmoothedMuscleMetabolics>(
+                    "only_muscle1");
+    const auto& muscle0 = model.getComponent<Muscle>("muscle0");
+    const auto& muscle1 = model.getComponent<Muscle>("muscle1");
+    coord.setValue(state, muscle0.get_optimal_fiber_length() +
+                                  muscle0.get_tendon_slack_length());
+    coord.setSpeedValue(state, -0.05);
+    model.realizeVelocity(state);
+    SimTK::Vector& controls(model.updControls(state));
+    muscle0.setControls(SimTK::Vector(1, 0.3), controls);
+    muscle1.setControls(SimTK::Vector(1, 0.8), controls);
+    model.setControls(state, controls);
+    model.realizeDynamics(state);
+
+    const double rate0 = all.getMuscleMetabolicRate(state, "/muscle0");
+    const double rate1 = all.getMuscleMetabolicRate(state, "/muscle1");
+    CHECK(rate0 != Approx(rate1));
+    CHECK(rate1 ==
+            Approx(onlyMuscle1.getMuscleMetabolicRate(state, "/muscle1")));
+    // The basal rate is the same for both metabolics models.
+    CHECK(all.getTotalMetabolicRate(state) ==
+            Approx(onlyMuscle1.getTotalMetabolicRate(state) + rate0));
+    CHECK_THROWS(all.getMuscleMetabolicRate(state, "/disabled"));
+}
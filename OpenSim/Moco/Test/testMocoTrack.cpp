@@ -67,3 +67,40 @@ TEST_CASE("MocoTrack gait10dof18musc", "[casadi]") {
     CHECK(std.compareContinuousVariablesRMS(
             solution, {{"controls",{}}}) < 1e-2);
 }
+
+TEST_CASE("Parallel solve with a model processed from files", "[casadi]") {
+    // The model is loaded from a file, which changes the working directory
+    // while it is read. ExternalLoads reads its data file relative to the
+    // working directory when the model is connected.
+    const auto solve = [](const ModelProcessor& modelProcessor, int parallel) {
+        MocoStudy study;
+        auto& problem = study.updProblem();
+        problem.setModelProcessor(modelProcessor);
+        problem.setTimeBounds(0.01, 0.5);
+        problem.addGoal<MocoControlGoal>();
+        auto& solver = study.initCasADiSolver();
+        solver.set_num_mesh_intervals(5);
+        solver.set_optim_max_iterations(3);
+        solver.set_parallel(parallel);
+        MocoSolution solution = study.solve();
+        solution.unseal();
+        return solution;
+    };
+
+    ModelProcessor modelProcessor =
+            ModelProcessor("testMocoTrack_subject01.osim") |
+            ModOpRemoveMuscles() | ModOpAddReserves(100);
+    SECTION("Problem copies initialized concurrently") {}
+    SECTION("Problem copies initialized serially") {
+        modelProcessor.append(
+                ModOpAddExternalLoads("walk_gait1018_subject01_grf.xml"));
+    }
+
+    const std::string cwd = IO::getCwd();
+    const MocoSolution serial = solve(modelProcessor, 0);
+    const MocoSolution parallel = solve(modelProcessor, 8);
+    CHECK(IO::getCwd() == cwd);
+    CHECK(parallel.getObjective() ==
+            Approx(serial.getObjective()).epsilon(1e-9));
+    CHECK(parallel.compareContinuousVariablesRMS(serial) < 1e-9);
+}
@@ -0,0 +1,142 @@
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  CompactStatesTrajectory.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CompactStatesTrajectory.h"
+
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <limits>
+
+using namespace OpenSim;
+
+CompactStatesTrajectory::CompactStatesTrajectory(const Model& model) :
+        m_discreteSubsystem(
+                model.getSystem().getDefaultSubsystem().getMySubsystemIndex()),
+        m_discreteIndices(model.getDiscreteVariableIndices()) {}
+
+void CompactStatesTrajectory::clear() {
+    m_template = SimTK::State();
+    m_numY = 0;
+    m_times.clear();
+    m_y.clear();
+    m_discrete.clear();
+}
+
+void CompactStatesTrajectory::reserve(size_t numStates) {
+    m_reserve = numStates;
+    m_times.reserve(numStates);
+    if (!m_times.empty()) {
+        m_y.reserve(numStates * m_numY);
+        m_discrete.reserve(numStates * m_discreteIndices.size());
+    }
+}
+
+void CompactStatesTrajectory::append(const SimTK::State& state) {
+    if (m_times.empty()) {
+        m_template = state;
+        m_numY = state.getNY();
+        m_y.reserve(m_reserve * m_numY);
+        m_discrete.reserve(m_reserve * m_discreteIndices.size());
+    } else {
+        SimTK_APIARGCHECK2_ALWAYS(m_times.back() <= state.getTime(),
+                "CompactStatesTrajectory", "append",
+                "New state's time (%f) must be equal to or greater than the "
+                "time for the last state in the trajectory (%f).",
+                state.getTime(), m_times.back()
+                );
+
+        // The template is consistent with all states in the trajectory.
+        OPENSIM_THROW_IF(!m_template.isConsistent(state),
+                StatesTrajectory::InconsistentState, state.getTime());
+    }
+
+    m_times.push_back(state.getTime());
+    const SimTK::Vector& y = state.getY();
+    for (int i = 0; i < m_numY; ++i) m_y.push_back(y[i]);
+    for (const auto& index : m_discreteIndices) {
+        m_discrete.push_back(SimTK::Value<double>::downcast(
+                state.getDiscreteVariable(m_discreteSubsystem, index)).get());
+    }
+}
+
+void CompactStatesTrajectory::copyToState(
+        size_t index, SimTK::State& state) const {
+    OPENSIM_THROW_IF(index >= getSize(), IndexOutOfRange, index, 0,
+            static_cast<unsigned>(getSize() - 1));
+    OPENSIM_THROW_IF(state.getNY() != m_numY, Exception,
+            "Expected the state to have {} continuous state variables, like "
+            "the states in the trajectory, but it has {}.",
+            m_numY, state.getNY());
+
+    state.setTime(m_times[index]);
+    SimTK::Vector& y = state.updY();
+    const double* values = &m_y[index * m_numY];
+    for (int i = 0; i < m_numY; ++i) y[i] = values[i];
+    const size_t numDiscrete = m_discreteIndices.size();
+    for (size_t i = 0; i < numDiscrete; ++i) {
+        SimTK::Value<double>::downcast(
+                state.updDiscreteVariable(m_discreteSubsystem,
+                        m_discreteIndices[i])).upd() =
+                m_discrete[index * numDiscrete + i];
+    }
+}
+
+SimTK::State CompactStatesTrajectory::getState(size_t index) const {
+    SimTK::State state = m_template;
+    copyToState(index, state);
+    return state;
+}
+
+CompactStatesTrajectory::const_iterator
+CompactStatesTrajectory::begin() const {
+    if (m_times.empty()) return end();
+    return const_iterator(this, 0,
+            std::make_shared<const_iterator::Buffer>(const_iterator::Buffer{
+                    m_template, std::numeric_limits<size_t>::max()}));
+}
+
+CompactStatesTrajectory::const_iterator CompactStatesTrajectory::end() const {
+    return const_iterator(this, getSize(), nullptr);
+}
+
+const SimTK::State& CompactStatesTrajectory::const_iterator::operator*() const {
+    if (m_buffer->index != m_index) {
+        m_trajectory->copyToState(m_index, m_buffer->state);
+        m_buffer->index = m_index;
+    }
+    return m_buffer->state;
+}
+
+bool CompactStatesTrajectory::isCompatibleWith(const Model& model) const {
+    // An empty trajectory is necessarily compatible.
+    if (m_times.empty()) return true;
+    // All states are consistent with the template, so it suffices to check
+    // the template (see StatesTrajectory::isCompatibleWith()).
+    return model.getNumSpeeds() == m_template.getNU();
+}
+
+StatesTrajectory CompactStatesTrajectory::toStatesTrajectory() const {
+    StatesTrajectory states;
+    states.reserve(getSize());
+    for (const auto& state : *this) states.append(state);
+    return states;
+}
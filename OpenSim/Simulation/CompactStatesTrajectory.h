@@ -0,0 +1,221 @@
+#ifndef OPENSIM_COMPACT_STATES_TRAJECTORY_H_
+#define OPENSIM_COMPACT_STATES_TRAJECTORY_H_
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  CompactStatesTrajectory.h                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "StatesTrajectory.h"
+
+#include <iterator>
+#include <memory>
+
+#include <SimTKcommon/internal/State.h>
+
+namespace OpenSim {
+
+class Model;
+
+/**
+ * This class holds a sequence of states, like StatesTrajectory, but stores
+ * only the values that change from one state to the next: the time, the
+ * continuous state variables (Y), and, optionally, the discrete variables
+ * that Component%s allocate with Component::addDiscreteVariable(). These
+ * values are kept in contiguous arrays. A copy of the first appended state
+ * serves as the template for everything else (modeling options, instance
+ * variables, other discrete variables), and SimTK::State%s are materialized
+ * from the template on demand.
+ *
+ * A StatesTrajectory stores a full copy of each SimTK::State, including every
+ * cache entry, which for a large model can amount to several megabytes per
+ * state. A CompactStatesTrajectory needs only a few bytes per state
+ * variable and state.
+ *
+ * Access the states by iterating through the trajectory, or by filling a
+ * state of your own with copyToState():
+ * @code{.cpp}
+ * auto states = CompactStatesTrajectory::createFromStatesTable(model, table);
+ * for (const auto& state : states) {
+ *     model.realizePosition(state);
+ *     std::cout << model.calcMassCenterPosition(state) << std::endl;
+ * }
+ * SimTK::State state = model.getWorkingState();
+ * states.copyToState(10, state);
+ * @endcode
+ *
+ * Each iterator obtained from begin() holds a single state buffer, which is
+ * overwritten with the values of the current state when the iterator is
+ * dereferenced. Therefore, a reference obtained by dereferencing an iterator
+ * is only valid until the iterator (or one of its copies) is advanced and
+ * dereferenced again; copy the state if you need to keep it.
+ *
+ * Discrete variables are stored only if the trajectory is constructed with
+ * a Model. Otherwise, and for discrete variables that are not allocated with
+ * Component::addDiscreteVariable(), the materialized states have the values
+ * from the first state in the trajectory.
+ */
+class OSIMSIMULATION_API CompactStatesTrajectory {
+public:
+    /** Create an empty trajectory that stores the time and the continuous
+     * state variables of each state. */
+    CompactStatesTrajectory() = default;
+    /** Create an empty trajectory that, in addition, stores the discrete
+     * variables of the Component%s in the model (see
+     * Component::getDiscreteVariableIndices()). The model's system must have
+     * been created (e.g., with Model::initSystem()). The trajectory does not
+     * keep a reference to the model. */
+    explicit CompactStatesTrajectory(const Model& model);
+
+    /** The number of states in the trajectory. */
+    size_t getSize() const { return m_times.size(); }
+    /** The number of continuous state variables (Y's) in each state. */
+    int getNumY() const { return m_numY; }
+    /** The time of the state at the given index. */
+    double getTime(size_t index) const { return m_times.at(index); }
+
+    /// @name Accessing individual SimTK::State%s
+    /// @{
+    /** Set the time, the continuous state variables, and the stored discrete
+     * variables of the given state to the values of the state at the given
+     * index. The given state must be consistent with the states in the
+     * trajectory (e.g., created from the same model). The state is
+     * invalidated as necessary, like with SimTK::State::updY().
+     * @throws IndexOutOfRange If the index is greater than the size of the
+     *                         trajectory. */
+    void copyToState(size_t index, SimTK::State& state) const;
+    /** Get a copy of the state at the given index. Prefer iterating through
+     * the trajectory or using copyToState() if you access many states. */
+    SimTK::State getState(size_t index) const;
+    /// @}
+
+    /** Iterator through the states in the trajectory; see the class
+     * description for the lifetime of the dereferenced states. */
+    class OSIMSIMULATION_API const_iterator {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef SimTK::State value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const SimTK::State* pointer;
+        typedef const SimTK::State& reference;
+
+        const_iterator() = default;
+        reference operator*() const;
+        pointer operator->() const { return &operator*(); }
+        const_iterator& operator++() { ++m_index; return *this; }
+        const_iterator operator++(int) {
+            const_iterator previous(*this);
+            ++m_index;
+            return previous;
+        }
+        bool operator==(const const_iterator& other) const {
+            return m_trajectory == other.m_trajectory &&
+                   m_index == other.m_index;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return !operator==(other);
+        }
+        /** The index of the current state in the trajectory. */
+        size_t getIndex() const { return m_index; }
+    private:
+        friend class CompactStatesTrajectory;
+        struct Buffer {
+            SimTK::State state;
+            // Index of the state whose values are in the buffer.
+            size_t index;
+        };
+        const_iterator(const CompactStatesTrajectory* trajectory, size_t index,
+                std::shared_ptr<Buffer> buffer)
+                : m_trajectory(trajectory), m_index(index),
+                  m_buffer(std::move(buffer)) {}
+        const CompactStatesTrajectory* m_trajectory = nullptr;
+        size_t m_index = 0;
+        std::shared_ptr<Buffer> m_buffer;
+    };
+
+    /// @name Iterating through the trajectory
+    /// @{
+    /** Iterator pointing to the first state. Each call creates a new state
+     * buffer. */
+    const_iterator begin() const;
+    /** Iterator pointing past the end of the trajectory. */
+    const_iterator end() const;
+    /// @}
+
+    /// @name Modify the contents of the trajectory
+    /// @{
+    /** Clear all the states in the trajectory. The discrete variables to
+     * store (if a model was given upon construction) are kept. */
+    void clear();
+    /** Append the values of a SimTK::State to this trajectory. The first
+     * state appended (after construction or clear()) is copied as the
+     * template for materializing states.
+     *
+     * As with StatesTrajectory::append(), the time of the new state must be
+     * greater than or equal to the time of the last state in the trajectory.
+     * @throws StatesTrajectory::InconsistentState If the state is not
+     *      consistent with the first state in the trajectory. */
+    void append(const SimTK::State& state);
+    /** Allocate memory for at least the given number of states. If no state
+     * has been appended yet, the memory is allocated when the first state is
+     * appended, since the number of state variables is unknown before. */
+    void reserve(size_t numStates);
+    /// @}
+
+    /** Returns true if the number of speeds in the model matches the number
+     * of U's in the states (see StatesTrajectory::isCompatibleWith()). */
+    bool isCompatibleWith(const Model& model) const;
+
+    /** Create a StatesTrajectory holding a full copy of each state. */
+    StatesTrajectory toStatesTrajectory() const;
+
+    /** Same as StatesTrajectory::exportToTable(). */
+    TimeSeriesTable exportToTable(const Model& model,
+            const std::vector<std::string>& stateVars = {}) const;
+
+    /** Same as StatesTrajectory::createFromStatesTable(), but creates a
+     * CompactStatesTrajectory. The discrete variables of the materialized
+     * states have their default values. */
+    static CompactStatesTrajectory createFromStatesTable(const Model& model,
+            const TimeSeriesTable& table,
+            bool allowMissingColumns = false,
+            bool allowExtraColumns = false,
+            bool assemble = false);
+
+private:
+    // Copy of the first state appended.
+    SimTK::State m_template;
+    int m_numY = 0;
+    size_t m_reserve = 0;
+
+    // The discrete variables to store, which are allocated in the default
+    // subsystem.
+    SimTK::SubsystemIndex m_discreteSubsystem;
+    std::vector<SimTK::DiscreteVariableIndex> m_discreteIndices;
+
+    std::vector<double> m_times;
+    // getNumY() values per state.
+    std::vector<double> m_y;
+    // m_discreteIndices.size() values per state.
+    std::vector<double> m_discrete;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COMPACT_STATES_TRAJECTORY_H_
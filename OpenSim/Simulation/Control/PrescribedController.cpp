@@ -161,14 +161,29 @@ void PrescribedController::extendConnectToModel(Model& model)
 }
 
 
+void PrescribedController::extendAddToSystem(
+        SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+    _controlFunctionHintsCV = addCacheVariable("control_function_hints",
+            std::vector<int>(getActuatorSet().getSize(), 0),
+            SimTK::Stage::Time);
+}
+
 // compute the control value for an actuator
 void PrescribedController::computeControls(const SimTK::State& s, SimTK::Vector& controls) const
 {
     SimTK::Vector actControls(1, 0.0);
-    SimTK::Vector time(1, s.getTime());
+    const double time = s.getTime();
+
+    const int nc = getActuatorSet().getSize();
+    // Only the value of the hints is used, not the validity of the cache
+    // entry.
+    std::vector<int>& hints = updCacheVariableValue(s, _controlFunctionHintsCV);
+    if ((int)hints.size() != nc) hints.assign(nc, 0);
 
-    for(int i=0; i<getActuatorSet().getSize(); i++){
-        actControls[0] = get_ControlFunctions()[i].calcValue(time);
+    for(int i=0; i<nc; i++){
+        actControls[0] = get_ControlFunctions()[i].calcValue(time, hints[i]);
         getActuatorSet()[i].addInControls(actControls, controls);
     }  
 }
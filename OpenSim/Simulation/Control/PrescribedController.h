@@ -119,6 +119,7 @@ public:
 protected:
     /** Model component interface */
     void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
 private:
     // construct and initialize properties
     void constructProperties();
@@ -130,6 +131,14 @@ private:
     // This method sets all member variables to default (e.g., NULL) values.
     void setNull();
 
+    // Interval hints for evaluating the control functions (see
+    // Function::calcValue(double, int&)), one per control function. Controls
+    // are usually computed at increasing times, so the hints make the
+    // interval search of spline control functions constant time. The hints
+    // are kept in the State, so that computeControls() can be called
+    // concurrently with different States.
+    mutable CacheVariable<std::vector<int>> _controlFunctionHintsCV;
+
 //=============================================================================
 };  // END of class PrescribedController
 
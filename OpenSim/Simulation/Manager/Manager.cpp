@@ -24,12 +24,14 @@
 /* Note: This code was originally developed by Realistic Dynamics Inc.
  * Author: Frank C. Anderson
  */
+#include <algorithm>
 #include <cstdio>
 #include "Manager.h"
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/AnalysisSet.h>
 #include <OpenSim/Simulation/Model/ControllerSet.h>
 #include <OpenSim/Common/Array.h>
+#include <OpenSim/Common/TableFileWriter.h>
 
 
 using namespace OpenSim;
@@ -99,6 +101,15 @@ setNull()
     _writeToStorage=true;
     _tArray.setSize(0);
     _dtArray.setSize(0);
+    _recordingPolicy = RecordingPolicy::AllSteps;
+    _recordingStepInterval = 1;
+    _recordingTimeInterval = SimTK::NaN;
+    _recordingStartTime = SimTK::NaN;
+    _numRecordingIntervals = 0;
+    _previousStepTime = SimTK::NaN;
+    _useStatesBuffer = false;
+    _statesBufferCapacity = 0;
+    _numBufferedStatesInStorage = 0;
 }
 
 //_____________________________________________________________________________
@@ -120,6 +131,12 @@ constructStorage()
     for(int i=0;i<ny;i++) columnLabels.append(stateNames[i]);
     _stateStore->setColumnLabels(columnLabels);
 
+    // STATES BUFFER
+    _stateNames.clear();
+    _stateNames.reserve(ny);
+    for(int i=0;i<ny;i++) _stateNames.push_back(stateNames[i]);
+    resetStatesBuffer();
+
     return(true);
 }
 
@@ -597,6 +614,112 @@ void Manager::setIntegratorInternalStepLimit(int nSteps)
     _integ->setInternalStepLimit(nSteps);
 }
 
+//-----------------------------------------------------------------------------
+// RECORDING
+//-----------------------------------------------------------------------------
+void Manager::setRecordingPolicy(RecordingPolicy policy)
+{
+    _recordingPolicy = policy;
+}
+
+Manager::RecordingPolicy Manager::getRecordingPolicy() const
+{
+    return _recordingPolicy;
+}
+
+void Manager::setRecordingStepInterval(int numSteps)
+{
+    OPENSIM_THROW_IF(numSteps < 1, Exception,
+        "Expected the recording step interval to be at least 1, "
+        "but got {}.", numSteps);
+    _recordingStepInterval = numSteps;
+}
+
+int Manager::getRecordingStepInterval() const
+{
+    return _recordingStepInterval;
+}
+
+void Manager::setRecordingTimeInterval(double interval)
+{
+    OPENSIM_THROW_IF(!(interval > 0), Exception,
+        "Expected the recording time interval to be positive, "
+        "but got {}.", interval);
+    _recordingTimeInterval = interval;
+}
+
+double Manager::getRecordingTimeInterval() const
+{
+    return _recordingTimeInterval;
+}
+
+void Manager::setUseStatesBuffer(bool useStatesBuffer, int initialCapacity)
+{
+    OPENSIM_THROW_IF(initialCapacity < 0, Exception,
+        "Expected a non-negative capacity for the states buffer, "
+        "but got {}.", initialCapacity);
+    OPENSIM_THROW_IF(_statesBuffer.getNumRows() > 0 || (_stateStore &&
+                         _stateStore->getSize() > 0), Exception,
+        "Cannot change where states are recorded after states have been "
+        "recorded.");
+    _useStatesBuffer = useStatesBuffer;
+    _statesBufferCapacity = initialCapacity;
+    resetStatesBuffer();
+}
+
+void Manager::resetStatesBuffer()
+{
+    _statesBuffer = TimeSeriesTable();
+    if (!_stateNames.empty()) _statesBuffer.setColumnLabels(_stateNames);
+    _statesBuffer.addTableMetaData("header",
+            _stateStore ? _stateStore->getName() : std::string("states"));
+    _statesBuffer.addTableMetaData("inDegrees", std::string("no"));
+    if (_useStatesBuffer) _statesBuffer.reserve(_statesBufferCapacity);
+    _numBufferedStatesInStorage = 0;
+}
+
+void Manager::setStatesOutputFileName(const std::string& fileName,
+                                      bool useBackgroundThread)
+{
+    closeStatesOutputFile();
+    if (fileName.empty()) return;
+
+    // Same metadata as getStatesTable().
+    TableMetaData metaData;
+    metaData.setValueForKey("header",
+            _stateStore ? _stateStore->getName() : std::string("states"));
+    metaData.setValueForKey("inDegrees", std::string("no"));
+    _statesWriter.reset(new TableFileWriter(fileName, _stateNames, metaData,
+            useBackgroundThread));
+
+    // States recorded so far.
+    const int ny = (int)_stateNames.size();
+    if (_useStatesBuffer) {
+        const auto& times = _statesBuffer.getIndependentColumn();
+        const auto matrix = _statesBuffer.getMatrix();
+        SimTK::Vector values(ny);
+        for (int i = 0; i < matrix.nrow(); ++i) {
+            values = ~matrix.row(i);
+            _statesWriter->appendRow(times[i], ny,
+                    values.size() ? &values[0] : nullptr);
+        }
+    } else if (_stateStore) {
+        for (int i = 0; i < _stateStore->getSize(); ++i) {
+            const StateVector& vec = *_stateStore->getStateVector(i);
+            _statesWriter->appendRow(vec.getTime(), vec.getSize(),
+                    vec.getData().get());
+        }
+    }
+}
+
+void Manager::closeStatesOutputFile()
+{
+    if (!_statesWriter) return;
+    // Release the writer even if closing throws.
+    std::unique_ptr<TableFileWriter> writer(std::move(_statesWriter));
+    writer->close();
+}
+
 //=============================================================================
 // EXECUTION
 //=============================================================================
@@ -622,11 +745,44 @@ getStateStorage() const
 {
     if(!_stateStore)
         throw Exception("Manager::getStateStorage(): Storage is not set");
+
+    // Bring the Storage up to date with the states buffer.
+    const int numBufferedStates = (int)_statesBuffer.getNumRows();
+    if(_useStatesBuffer && _numBufferedStatesInStorage < numBufferedStates) {
+        const auto& times = _statesBuffer.getIndependentColumn();
+        const auto matrix = _statesBuffer.getMatrix();
+        SimTK::Vector values(matrix.ncol());
+        for(int i = _numBufferedStatesInStorage; i < numBufferedStates; ++i) {
+            values = ~matrix.row(i);
+            _stateStore->append(times[i], values);
+        }
+        _numBufferedStatesInStorage = numBufferedStates;
+    }
     return *_stateStore;
 }
 
 TimeSeriesTable Manager::getStatesTable() const {
-    return getStateStorage().exportToTable();
+    if(!_useStatesBuffer) return getStateStorage().exportToTable();
+
+    // Only the recorded rows of the buffer are copied, not its reserved
+    // rows.
+    const auto matrix = _statesBuffer.getMatrix();
+    TimeSeriesTable table(_statesBuffer.getIndependentColumn(),
+            SimTK::Matrix(matrix), _stateNames);
+
+    table.addTableMetaData("header",
+            _stateStore ? _stateStore->getName() : std::string("states"));
+    table.addTableMetaData("inDegrees", std::string("no"));
+    table.addTableMetaData("nRows", std::to_string(matrix.nrow()));
+    table.addTableMetaData("nColumns", std::to_string(matrix.ncol() + 1));
+    return table;
+}
+
+const TimeSeriesTable& Manager::getStatesBuffer() const {
+    OPENSIM_THROW_IF(!_useStatesBuffer, Exception,
+        "The states buffer is not in use; call setUseStatesBuffer(true) "
+        "before integrating.");
+    return _statesBuffer;
 }
 
 //_____________________________________________________________________________
@@ -752,6 +908,9 @@ const SimTK::State& Manager::integrate(double finalTime)
 
     record(_integ->getState(), -1);
 
+    // Make the states recorded so far available in the file.
+    if (_statesWriter) _statesWriter->flush();
+
     return getState();
 }
 
@@ -785,6 +944,18 @@ double Manager::getFixedStepSize(int tArrayStep) const {
  */
 void Manager::initializeStorageAndAnalyses(const SimTK::State& s)
 {
+    // When recording at fixed time intervals, the output times continue
+    // from the previous call to integrate(), if any (see initialize()); the
+    // first state of this integration is not interpolated from a previous
+    // step.
+    if (_recordingPolicy == RecordingPolicy::FixedInterval) {
+        OPENSIM_THROW_IF(SimTK::isNaN(_recordingTimeInterval), Exception,
+            "Manager::initializeStorageAndAnalyses(): "
+            "Expected a recording time interval for the FixedInterval "
+            "recording policy. Call Manager::setRecordingTimeInterval().");
+        _previousStepTime = SimTK::NaN;
+    }
+
     if( _writeToStorage ) {
         // STORE STARTING CONTROLS
         if (_model->isControlled()){
@@ -822,6 +993,11 @@ void Manager::initialize(const SimTK::State& s)
         _timeStepper->setReportAllSignificantStates(true);
     }
 
+    // The FixedInterval output times start at the initial state.
+    _recordingStartTime = s.getTime();
+    _numRecordingIntervals = 0;
+    _previousStepTime = SimTK::NaN;
+
     // Here we call the constructStorage because it is possible that
     // the Model's control storage has already been appended in a
     // previous simulation since the Manager mutates the model
@@ -843,14 +1019,91 @@ void Manager::record(const SimTK::State& s, const int& step)
         else
             analysisSet.step(s, step);
     }
-    if (_writeToStorage) {
-        SimTK::Vector stateValues = _model->getStateVariableValues(s);
+    if (!_writeToStorage || _recordingPolicy == RecordingPolicy::None)
+        return;
+
+    // Decide whether this step is recorded. The initial (step = 0) and final
+    // (step = -1) states are always recorded.
+    const double time = s.getTime();
+    bool recordStep = step <= 0;
+    if (_recordingPolicy == RecordingPolicy::AllSteps) {
+        recordStep = true;
+    } else if (_recordingPolicy == RecordingPolicy::EveryNthStep) {
+        recordStep = recordStep || (step % _recordingStepInterval == 0);
+    }
+
+    SimTK::Vector stateValues = _model->getStateVariableValues(s);
+    const bool storeControls = _model->isControlled();
+    if (_recordingPolicy == RecordingPolicy::FixedInterval) {
+        // Interpolate states and controls linearly between the previous and
+        // the current step at each output time passed by this step.
+        SimTK::Vector controls;
+        if (storeControls) controls = _model->getControls(s);
+        double outputTime = _recordingStartTime +
+                _numRecordingIntervals * _recordingTimeInterval;
+        if (step == 0 && outputTime == time) {
+            recordStateValues(time, stateValues);
+            if (storeControls)
+                _controllerSet->storeControls(time, controls, 0);
+            outputTime = _recordingStartTime +
+                    (++_numRecordingIntervals) * _recordingTimeInterval;
+        } else if (!SimTK::isNaN(_previousStepTime)) {
+            while (outputTime <= time && outputTime > _previousStepTime) {
+                const double w = (outputTime - _previousStepTime) /
+                                 (time - _previousStepTime);
+                recordStateValues(outputTime, _previousStepValues +
+                        w * (stateValues - _previousStepValues));
+                if (storeControls) {
+                    _controllerSet->storeControls(outputTime,
+                            _previousStepControls +
+                            w * (controls - _previousStepControls),
+                            _numRecordingIntervals);
+                }
+                outputTime = _recordingStartTime +
+                        (++_numRecordingIntervals) * _recordingTimeInterval;
+            }
+        }
+        _previousStepTime = time;
+        _previousStepValues = stateValues;
+        _previousStepControls = controls;
+        // The final state is recorded even if it is not at an output time.
+        recordStep = step < 0;
+    }
+
+    if (recordStep) recordStateValues(time, stateValues);
+
+    if (recordStep && storeControls) {
+        const int numRecorded = _useStatesBuffer
+                ? (int)_statesBuffer.getNumRows()
+                : getStateStorage().getSize();
+        _controllerSet->storeControls(s, (step < 0) ? numRecorded : step);
+    }
+}
+
+void Manager::recordStateValues(double time, const SimTK::Vector& values)
+{
+    if (_statesWriter) {
+        _statesWriter->appendRow(time, values.size(),
+                values.size() ? &values[0] : nullptr);
+    }
+
+    if (!_useStatesBuffer) {
         StateVector vec;
-        vec.setStates(s.getTime(), stateValues);
+        vec.setStates(time, values);
         getStateStorage().append(vec);
-        if (_model->isControlled())
-            _controllerSet->storeControls(s,
-                (step < 0) ? getStateStorage().getSize() : step);
+        return;
+    }
+
+    // As in Storage::append(), a state at the time of the last recorded state
+    // replaces it. Otherwise, the row is appended into the table's reserved
+    // rows; the table grows geometrically once they are used up.
+    const int numRows = (int)_statesBuffer.getNumRows();
+    if (numRows > 0 && _statesBuffer.getIndependentColumn().back() == time) {
+        _statesBuffer.updRowAtIndex(numRows - 1) = ~values;
+        _numBufferedStatesInStorage =
+                std::min(_numBufferedStatesInStorage, numRows - 1);
+    } else {
+        _statesBuffer.appendRow(time, ~values);
     }
 }
 
@@ -45,6 +45,7 @@ namespace OpenSim {
 
 class Model;
 class Storage;
+class TableFileWriter;
 class ControllerSet;
 
 //=============================================================================
@@ -118,6 +119,38 @@ private:
     /** controllerSet used for the integration */
     SimTK::ReferencePtr<ControllerSet> _controllerSet;
 
+    /** Record every _recordingStepInterval-th step (EveryNthStep). */
+    int _recordingStepInterval;
+    /** Time between recorded states (FixedInterval). */
+    double _recordingTimeInterval;
+    /** Output times are _recordingStartTime + i * _recordingTimeInterval,
+    where i is the number of intervals recorded so far (FixedInterval).
+    initialize() sets _recordingStartTime to the time of the initial state. */
+    double _recordingStartTime;
+    int _numRecordingIntervals;
+    /** Time, state variable values and controls of the previous integration
+    step, used to interpolate at the FixedInterval output times. */
+    double _previousStepTime;
+    SimTK::Vector _previousStepValues;
+    SimTK::Vector _previousStepControls;
+
+    /** Flag indicating if states are recorded into the columnar buffer
+    instead of the Storage. */
+    bool _useStatesBuffer;
+    /** Number of rows reserved in the states buffer up front. */
+    int _statesBufferCapacity;
+    /** Table (time x state variable) of the recorded states. Rows are
+    appended in place into the table's reserved rows. */
+    TimeSeriesTable _statesBuffer;
+    /** Number of buffered rows already copied into _stateStore by
+    getStateStorage(). */
+    mutable int _numBufferedStatesInStorage;
+    std::vector<std::string> _stateNames;
+
+    /** Writer for the file to which the recorded states are written (see
+    setStatesOutputFileName()). */
+    std::unique_ptr<TableFileWriter> _statesWriter;
+
 
 //=============================================================================
 // METHODS
@@ -163,6 +196,67 @@ public:
     void setWriteToStorage(bool writeToStorage)
     { _writeToStorage =  writeToStorage; }
 
+    /** @name Configure state recording
+      * These settings control which states are written to the state storage
+      * (see setWriteToStorage()). Analyses are still invoked at every
+      * integration step (see setPerformAnalyses()).
+      * @note Call these functions before calling `Manager::integrate()`.
+      * @{ */
+
+    /** Supported recording policies. For MATLAB, int's must be used rather
+        than enum's (see setIntegratorMethod(IntegratorMethod)). */
+    enum class RecordingPolicy {
+        AllSteps      = 0, ///< 0 : Record every integration step (default).
+        EveryNthStep  = 1, ///< 1 : Record every N-th integration step
+                           ///<     (see setRecordingStepInterval()).
+        FixedInterval = 2, ///< 2 : Record states at evenly spaced times,
+                           ///<     linearly interpolated between integration
+                           ///<     steps (see setRecordingTimeInterval()).
+        None          = 3  ///< 3 : Do not record states.
+    };
+
+    /** Set which integration steps are recorded. The initial state and the
+    final state are recorded with every policy except None. */
+    void setRecordingPolicy(RecordingPolicy policy);
+    RecordingPolicy getRecordingPolicy() const;
+
+    /** Number of integration steps between recorded states when using
+    RecordingPolicy::EveryNthStep. The default is 1. */
+    void setRecordingStepInterval(int numSteps);
+    int getRecordingStepInterval() const;
+
+    /** Time between recorded states when using
+    RecordingPolicy::FixedInterval. The output times start at the time of the
+    state passed to initialize() and continue across calls to integrate(). */
+    void setRecordingTimeInterval(double interval);
+    double getRecordingTimeInterval() const;
+
+    /** Record states into a preallocated, column-major buffer instead of
+    a Storage. The buffer holds `initialCapacity` rows up front and grows
+    geometrically if the simulation records more states than that, so
+    recording does not reallocate on every step. Use getStatesBuffer() to
+    access the recorded states without a copy, or getStatesTable() to obtain
+    a copy; getStateStorage() remains available but creates the Storage from
+    the buffer when it is called. */
+    void setUseStatesBuffer(bool useStatesBuffer, int initialCapacity = 1024);
+    bool getUseStatesBuffer() const { return _useStatesBuffer; }
+
+    /** Also write the recorded states to a file while integrating, so that
+    they are not lost if the simulation does not finish. The file is written
+    with a TableFileWriter (STO format, or CSV if the file name ends with
+    ".csv"), which buffers the rows and keeps the number of rows in the header
+    up to date; optionally, the rows are formatted and written in a
+    background thread. The states recorded so far are written first. The file
+    is complete once closeStatesOutputFile() is called or the Manager is
+    destroyed. Pass an empty file name to stop writing to a file. */
+    void setStatesOutputFileName(const std::string& fileName,
+                                 bool useBackgroundThread = false);
+    /** Write the remaining states to the file set with
+    setStatesOutputFileName(), if any, and close it. */
+    void closeStatesOutputFile();
+
+    /** @} */
+
     /** @name Configure the Integrator
       * @note Call these functions before calling `Manager::initialize()`.
       * @{ */
@@ -342,7 +436,19 @@ public:
     ownership of the passed-in Storage. */
     void setStateStorage(Storage& aStorage);
     Storage& getStateStorage() const;
+    /** Get a copy of the recorded states as a table. If the states buffer is
+    in use (see setUseStatesBuffer()), the table's matrix is copied directly
+    from the buffer's contiguous columns, without a Storage. */
     TimeSeriesTable getStatesTable() const;
+    /** Get a reference to the table into which the states are recorded, to
+    read the recorded states without copying them. The table has the same
+    columns and "header" and "inDegrees" metadata as getStatesTable(). The
+    reference remains valid for the lifetime of the Manager, but its
+    contents change as states are recorded.
+
+    \throws Exception If the states buffer is not in use (see
+                      setUseStatesBuffer()). */
+    const TimeSeriesTable& getStatesBuffer() const;
 
    //--------------------------------------------------------------------------
    //  INTERRUPT
@@ -353,6 +459,9 @@ public:
 
 private:
 
+    /** Which integration steps are recorded as states. */
+    RecordingPolicy _recordingPolicy;
+
     // Handles common tasks of some of the other constructors.
     Manager(Model& model, bool dummyVar);
 
@@ -363,6 +472,13 @@ private:
     // step = 0 is the beginning, step = -1 used to denote the end/final step
     void record(const SimTK::State& s, const int& step);
 
+    // Helper to write one row of state variable values into the state storage
+    // or the states buffer.
+    void recordStateValues(double time, const SimTK::Vector& values);
+
+    // Helper to empty the states buffer and reserve its initial capacity.
+    void resetStatesBuffer();
+
 //=============================================================================
 };  // END of class Manager
 
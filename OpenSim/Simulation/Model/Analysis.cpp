@@ -31,6 +31,7 @@
 //=============================================================================
 #include "Analysis.h"
 #include "OpenSim/Common/XMLDocument.h"
+#include "OpenSim/Common/Logger.h"
 
 
 
@@ -165,6 +166,8 @@ setNull()
     _inDegrees=true;
     _storageList.setMemoryOwner(false);
     _printResultFiles=true;
+    _resultsFileExtension = ".sto";
+    _useBackgroundThreadForResults = false;
 }
 //_____________________________________________________________________________
 /**
@@ -222,6 +225,10 @@ operator=(const Analysis &aAnalysis)
 
     _inDegrees = aAnalysis._inDegrees;
     _printResultFiles = aAnalysis._printResultFiles;
+    _resultsFileBaseName = aAnalysis._resultsFileBaseName;
+    _resultsFileDir = aAnalysis._resultsFileDir;
+    _resultsFileExtension = aAnalysis._resultsFileExtension;
+    _useBackgroundThreadForResults = aAnalysis._useBackgroundThreadForResults;
 
     // Class Members
     setStepInterval(aAnalysis.getStepInterval());
@@ -352,6 +359,46 @@ ArrayPtrs<Storage>& Analysis::getStorageList()
     return _storageList;
 }
 
+void Analysis::setResultsOutputFiles(const string &aBaseName,
+        const string &aDir, const string &aExtension, bool useBackgroundThread)
+{
+    closeResultsOutputFiles();
+    _resultsFileBaseName = aBaseName;
+    _resultsFileDir = aDir;
+    _resultsFileExtension = aExtension;
+    _useBackgroundThreadForResults = useBackgroundThread;
+}
+
+void Analysis::openResultsOutputFiles()
+{
+    if(_resultsFileBaseName.empty()) return;
+    const string path = (_resultsFileDir == "") ? "." : _resultsFileDir;
+    ArrayPtrs<Storage>& storages = getStorageList();
+    for(int i=0;i<storages.getSize();i++) {
+        Storage* storage = storages[i];
+        if(!storage) continue;
+        if(storage->getColumnLabels().getSize() < 1) {
+            log_warn("Analysis {}: storage '{}' has no column labels and is "
+                     "not written to a file.", getName(), storage->getName());
+            continue;
+        }
+        const string storageName = storage->getName().empty()
+                ? std::to_string(i) : storage->getName();
+        storage->setOutputFileName(path + "/" + _resultsFileBaseName + "_" +
+                getName() + "_" + storageName + _resultsFileExtension,
+                _useBackgroundThreadForResults);
+    }
+}
+
+void Analysis::closeResultsOutputFiles()
+{
+    ArrayPtrs<Storage>& storages = getStorageList();
+    for(int i=0;i<storages.getSize();i++) {
+        Storage* storage = storages[i];
+        if(storage) storage->closeOutputFile();
+    }
+}
+
 // GET AND SET
 //=============================================================================
 //_____________________________________________________________________________
@@ -94,6 +94,13 @@ protected:
     ArrayPtrs<Storage> _storageList;
     bool _printResultFiles;
 
+    /** Settings for writing the storages to files while the analysis runs
+    (see setResultsOutputFiles()). */
+    std::string _resultsFileBaseName;
+    std::string _resultsFileDir;
+    std::string _resultsFileExtension;
+    bool _useBackgroundThreadForResults;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -231,6 +238,35 @@ public:
         printResults(const std::string &aBaseName,const std::string &aDir="",
         double aDT=-1.0,const std::string &aExtension=".sto");
 
+    /**
+     * Write the storages of the analysis (see getStorageList()) to files
+     * while the analysis runs, so that the results are available even if the
+     * simulation does not finish. The results are still kept in memory and
+     * can be printed with printResults() as before.
+     *
+     * Each storage is written to the file
+     * <aDir>/<aBaseName>_<analysis name>_<storage name><aExtension> with
+     * Storage::setOutputFileName(). AnalysisSet::begin() opens the files after
+     * calling begin(), which writes the rows recorded so far, and
+     * AnalysisSet::end() closes them after calling end().
+     *
+     * @param aBaseName Base name of the files; an empty name disables
+     *                  writing the files.
+     * @param aDir      Directory name.
+     * @param aExtension File extension: ".sto" or ".csv".
+     * @param useBackgroundThread Format and write the rows in a background
+     *                  thread.
+     */
+    void setResultsOutputFiles(const std::string &aBaseName,
+        const std::string &aDir="", const std::string &aExtension=".sto",
+        bool useBackgroundThread=false);
+    /** Open the files set with setResultsOutputFiles(), if any; storages
+     * without column labels are skipped. */
+    void openResultsOutputFiles();
+    /** Write the remaining rows to the files opened with
+     * openResultsOutputFiles() and close them. */
+    void closeResultsOutputFiles();
+
 //=============================================================================
 };  // END of class Analysis
 
@@ -201,7 +201,10 @@ void AnalysisSet::begin(const SimTK::State& s )
     int i;
     for(i=0;i<getSize();i++) {
         Analysis& analysis = get(i);
-        if (analysis.getOn()) analysis.begin(s);
+        if (analysis.getOn()) {
+            analysis.begin(s);
+            analysis.openResultsOutputFiles();
+        }
     }
 }
 //_____________________________________________________________________________
@@ -234,7 +237,10 @@ void AnalysisSet:: end(const SimTK::State& s)
     int i;
     for(i=0;i<getSize();i++) {
         Analysis& analysis = get(i);
-        if (analysis.getOn()) analysis.end(s);
+        if (analysis.getOn()) {
+            analysis.end(s);
+            analysis.closeResultsOutputFiles();
+        }
     }
 }
 
@@ -261,6 +267,22 @@ printResults(const string &aBaseName,const string &aDir,double aDT,
         if(analysis.getOn() && analysis.getPrintResultFiles()) analysis.printResults(aBaseName,aDir,aDT,aExtension);
     }
 }
+//_____________________________________________________________________________
+/**
+ * Write the results of all analyses in the set to files during the
+ * simulation (see Analysis::setResultsOutputFiles()).
+ */
+void AnalysisSet::
+setResultsOutputFiles(const string &aBaseName,const string &aDir,
+                      const string &aExtension,bool useBackgroundThread)
+{
+    int i;
+    int size = getSize();
+    for(i=0;i<size;i++) {
+        get(i).setResultsOutputFiles(aBaseName,aDir,aExtension,
+                                     useBackgroundThread);
+    }
+}
 //=============================================================================
 // UTILITY
 //=============================================================================
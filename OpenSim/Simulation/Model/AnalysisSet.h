@@ -106,6 +106,11 @@ public:
     virtual void
         printResults(const std::string &aBaseName,const std::string &aPath="",
         double aDT=-1.0,const std::string &aExtension=".sto");
+    /** Call Analysis::setResultsOutputFiles() for all analyses in the set,
+    so that their results are written to files during the simulation. */
+    void setResultsOutputFiles(const std::string &aBaseName,
+        const std::string &aPath="", const std::string &aExtension=".sto",
+        bool useBackgroundThread=false);
 
     //--------------------------------------------------------------------------
     // UTILITY
@@ -71,7 +71,7 @@ public:
     Bhargava2004SmoothedMuscleMetabolics_MuscleParameters();
 
     double getMuscleMass() const { return muscleMass; }
-    void setMuscleMass();
+    void setMuscleMass() const;
 
     const Muscle& getMuscle() const { return getConnectee<Muscle>("muscle"); }
 
@@ -368,7 +368,23 @@ private:
             SimTK::Vector& maintenanceRatesForMuscles,
             SimTK::Vector& shorteningRatesForMuscles,
             SimTK::Vector& mechanicalWorkRatesForMuscles) const;
+    // Maps the path of each muscle that applies force to its index in
+    // m_muscles and in the cached rate vectors.
     mutable std::unordered_map<std::string, int> m_muscleIndices;
+    // The parameters of the muscles that apply force, gathered from the
+    // muscle_parameters property in extendRealizeTopology() so that
+    // calcMetabolicRate() does not access properties for each muscle.
+    struct MuscleEntry {
+        SimTK::ReferencePtr<const Muscle> muscle;
+        std::string name;
+        double mass;
+        double ratioSlowTwitchFibers;
+        double activationConstantSlowTwitch;
+        double activationConstantFastTwitch;
+        double maintenanceConstantSlowTwitch;
+        double maintenanceConstantFastTwitch;
+    };
+    mutable std::vector<MuscleEntry> m_muscles;
     using ConditionalFunction =
             double(const double&, const double&, const double&, const double&,
                     const int&);
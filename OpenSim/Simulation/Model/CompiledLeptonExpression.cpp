@@ -0,0 +1,84 @@
+/* -------------------------------------------------------------------------- *
+ *                 OpenSim:  CompiledLeptonExpression.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CompiledLeptonExpression.h"
+
+#include <OpenSim/Common/Exception.h>
+#include <lepton/Operation.h>
+#include <lepton/ParsedExpression.h>
+#include <lepton/Parser.h>
+
+#include <algorithm>
+#include <array>
+#include <map>
+
+using namespace OpenSim;
+
+CompiledLeptonExpression::CompiledLeptonExpression(
+        const std::string& expression, std::vector<std::string> variableNames)
+        : m_program(Lepton::Parser::parse(expression)
+                            .optimize()
+                            .createProgram()),
+          m_variableNames(std::move(variableNames)) {
+    const int numOperations = m_program.getNumOperations();
+    m_variableIndices.resize(numOperations, -1);
+    for (int i = 0; i < numOperations; ++i) {
+        const Lepton::Operation& op = m_program.getOperation(i);
+        if (op.getId() != Lepton::Operation::VARIABLE) continue;
+        const auto it = std::find(m_variableNames.begin(),
+                m_variableNames.end(), op.getName());
+        OPENSIM_THROW_IF(it == m_variableNames.end(), Exception,
+                "Expression '{}' contains unknown variable '{}'. Allowed "
+                "variables: {}.",
+                expression, op.getName(), fmt::join(m_variableNames, ", "));
+        m_variableIndices[i] = (int)(it - m_variableNames.begin());
+    }
+}
+
+double CompiledLeptonExpression::evaluate(const double* values) const {
+    // This mirrors Lepton::ExpressionProgram::evaluate(), except that
+    // variables are read from 'values' by position. Expressions in models
+    // are small, so the stack usually fits in a fixed-size local array.
+    static const std::map<std::string, double> noVariables;
+    const int stackSize = m_program.getStackSize();
+    std::array<double, 32> localStack;
+    std::vector<double> heapStack;
+    double* stack = localStack.data();
+    if (stackSize + 1 > (int)localStack.size()) {
+        heapStack.resize(stackSize + 1);
+        stack = heapStack.data();
+    }
+    int stackPointer = stackSize;
+    const int numOperations = (int)m_variableIndices.size();
+    for (int i = 0; i < numOperations; ++i) {
+        const Lepton::Operation& op = m_program.getOperation(i);
+        double result;
+        if (m_variableIndices[i] >= 0) {
+            result = values[m_variableIndices[i]];
+        } else {
+            result = op.evaluate(&stack[stackPointer], noVariables);
+        }
+        stackPointer += op.getNumArguments() - 1;
+        stack[stackPointer] = result;
+    }
+    return stack[stackSize - 1];
+}
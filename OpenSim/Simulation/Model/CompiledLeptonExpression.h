@@ -0,0 +1,79 @@
+#ifndef OPENSIM_COMPILED_LEPTON_EXPRESSION_H_
+#define OPENSIM_COMPILED_LEPTON_EXPRESSION_H_
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  CompiledLeptonExpression.h                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2023 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+#include <lepton/ExpressionProgram.h>
+
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/** A Lepton expression that is compiled once for evaluation with a fixed,
+ordered list of variables. The expression is flattened into a sequence of
+operations (Lepton::ExpressionProgram), and each variable operation is bound
+to the position of its value in the list of variables. Unlike
+Lepton::ExpressionProgram::evaluate(), evaluation does not build or search a
+map of variable names.
+
+@code
+CompiledLeptonExpression force("-10*q-5*qdot", {"q", "qdot"});
+double f = force.evaluate({q, qdot});
+@endcode
+
+The expression need not use all of the variables. Evaluation uses a stack
+local to the call and does not modify the object, so an instance may be
+evaluated from multiple threads at the same time. */
+class OSIMSIMULATION_API CompiledLeptonExpression {
+public:
+    /// The default-constructed expression must not be evaluated.
+    CompiledLeptonExpression() = default;
+    /// @throws Exception if the expression contains a variable that is not
+    ///         in variableNames. Syntax errors throw Lepton::Exception.
+    CompiledLeptonExpression(const std::string& expression,
+            std::vector<std::string> variableNames);
+
+    const std::vector<std::string>& getVariableNames() const {
+        return m_variableNames;
+    }
+
+    /// Evaluate the expression. `values` contains one value for each
+    /// variable, in the order of getVariableNames().
+    double evaluate(const double* values) const;
+    double evaluate(std::initializer_list<double> values) const {
+        return evaluate(values.begin());
+    }
+
+private:
+    Lepton::ExpressionProgram m_program;
+    std::vector<std::string> m_variableNames;
+    // For each operation of m_program, the index of its value in
+    // m_variableNames if it is a variable, or -1 otherwise.
+    std::vector<int> m_variableIndices;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COMPILED_LEPTON_EXPRESSION_H_
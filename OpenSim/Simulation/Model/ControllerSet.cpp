@@ -60,6 +60,17 @@ void ControllerSet::storeControls( const SimTK::State& s, int step  )
     }
 }
 
+void ControllerSet::storeControls( double time, const SimTK::Vector& controls,
+                                   int step )
+{
+    int size = _actuatorSet->getSize();
+
+    if( size > 0 )
+    {
+        _controlStore->store( step, time, controls.size(), &controls[0] );
+    }
+}
+
 // write out the controls to disk
 void ControllerSet::printControlStorage( const string& fileName)  const
 {
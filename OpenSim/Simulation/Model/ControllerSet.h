@@ -57,6 +57,9 @@ public:
 
     void constructStorage();
     void storeControls( const SimTK::State& s, int step );
+    /** Store controls that were computed (or interpolated) for the given
+    time rather than the time of a state. */
+    void storeControls( double time, const SimTK::Vector& controls, int step );
     void printControlStorage( const std::string& fileName) const;
     TimeSeriesTable getControlTable() const;
     void setActuators(Set<Actuator>& actuators);
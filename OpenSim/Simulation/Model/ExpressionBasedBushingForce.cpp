@@ -24,14 +24,16 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
-#include <Lepton.h>
-
 #include "ExpressionBasedBushingForce.h"
 
 using namespace std;
 using namespace SimTK;
 using namespace OpenSim;
 
+const std::vector<std::string>
+ExpressionBasedBushingForce::DeflectionVariableNames{
+        "theta_x", "theta_y", "theta_z", "delta_x", "delta_y", "delta_z"};
+
 
 // string formatting helper utility
 
@@ -221,7 +223,8 @@ void ExpressionBasedBushingForce::setMxExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mx_expression(expression);
-    MxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    MxExpression =
+            CompiledLeptonExpression(expression, DeflectionVariableNames);
 }
 
 /** Set the expression for the My function and create it's lepton program */
@@ -231,7 +234,8 @@ void ExpressionBasedBushingForce::setMyExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_My_expression(expression);
-    MyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    MyExpression =
+            CompiledLeptonExpression(expression, DeflectionVariableNames);
 }
 
 /** Set the expression for the Mz function and create it's lepton program */
@@ -240,7 +244,8 @@ void ExpressionBasedBushingForce::setMzExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mz_expression(expression);
-    MzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    MzExpression =
+            CompiledLeptonExpression(expression, DeflectionVariableNames);
 }
 
 /** Set the expression for the Fx function and create it's lepton program */
@@ -249,7 +254,8 @@ void ExpressionBasedBushingForce::setFxExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fx_expression(expression);
-    FxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    FxExpression =
+            CompiledLeptonExpression(expression, DeflectionVariableNames);
 }
 
 /** Set the expression for the Fy function and create it's lepton program */
@@ -258,7 +264,8 @@ void ExpressionBasedBushingForce::setFyExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fy_expression(expression);
-    FyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    FyExpression =
+            CompiledLeptonExpression(expression, DeflectionVariableNames);
 }
 
 /** Set the expression for the Fz function and create it's lepton program */
@@ -267,7 +274,8 @@ void ExpressionBasedBushingForce::setFzExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fz_expression(expression);
-    FzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    FzExpression =
+            CompiledLeptonExpression(expression, DeflectionVariableNames);
 }
 //=============================================================================
 // COMPUTATION
@@ -282,21 +290,14 @@ SimTK::Vec6 ExpressionBasedBushingForce::
 
     Vec6 fk = Vec6(0.0);
 
-    std::map<std::string, double> deflectionVars;
-    deflectionVars["theta_x"] = dq[0];
-    deflectionVars["theta_y"] = dq[1];
-    deflectionVars["theta_z"] = dq[2];
-    deflectionVars["delta_x"] = dq[3];
-    deflectionVars["delta_y"] = dq[4];
-    deflectionVars["delta_z"] = dq[5];
-
-
-    fk[0] = MxProg.evaluate(deflectionVars);
-    fk[1] = MyProg.evaluate(deflectionVars);
-    fk[2] = MzProg.evaluate(deflectionVars);
-    fk[3] = FxProg.evaluate(deflectionVars);
-    fk[4] = FyProg.evaluate(deflectionVars);
-    fk[5] = FzProg.evaluate(deflectionVars);
+    // The deflections are in the order of DeflectionVariableNames.
+    const double* deflections = &dq[0];
+    fk[0] = MxExpression.evaluate(deflections);
+    fk[1] = MyExpression.evaluate(deflections);
+    fk[2] = MzExpression.evaluate(deflections);
+    fk[3] = FxExpression.evaluate(deflections);
+    fk[4] = FyExpression.evaluate(deflections);
+    fk[5] = FzExpression.evaluate(deflections);
 
     return -fk;
 }
@@ -27,6 +27,7 @@
 // INCLUDE
 #include "Force.h"
 #include <OpenSim/Simulation/Model/TwoFrameLinker.h>
+#include "CompiledLeptonExpression.h"
 
 namespace OpenSim {
 
@@ -272,8 +273,11 @@ private:
 
     SimTK::Mat66 _dampingMatrix{ 0.0 };
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram MxProg, MyProg, MzProg, FxProg, FyProg, FzProg;
+    // compiled expressions for efficiently evaluating the stiffness forces,
+    // with the deflections as variables (see calcStiffnessForce())
+    CompiledLeptonExpression MxExpression, MyExpression, MzExpression,
+            FxExpression, FyExpression, FzExpression;
+    static const std::vector<std::string> DeflectionVariableNames;
 
 //==============================================================================
 };  // END of class ExpressionBasedBushingForce
@@ -24,7 +24,7 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include "Force.h"
-#include <lepton/ExpressionProgram.h>
+#include "CompiledLeptonExpression.h"
 
 namespace OpenSim {
 
@@ -126,8 +126,8 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // compiled expression for efficiently evaluating the force magnitude
+    CompiledLeptonExpression _forceExpression;
 
     // Corresponding generalized coordinate to which the force
     // is applied.
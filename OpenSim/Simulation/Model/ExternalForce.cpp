@@ -326,21 +326,45 @@ void ExternalForce::extendConnectToModel(Model& model)
 // FORCE METHODS
 //-----------------------------------------------------------------------------
 //_____________________________________________________________________________
+namespace {
+// Evaluate the x, y, and z functions (if any) at the given time, using and
+// updating the given interval hints (one per function).
+Vec3 calcFunctionsAtTime(const ArrayPtrs<Function>& functions, double time,
+                         int* hints)
+{
+    Vec3 value(0);
+    if (functions.size() != 3) return value;
+    for (int i = 0; i < 3; ++i) {
+        if (functions[i]) value[i] = functions[i]->calcValue(time, hints[i]);
+    }
+    return value;
+}
+}
+
+void ExternalForce::extendAddToSystem(SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+    _functionHintsCV = addCacheVariable("function_hints",
+            std::array<int, 9>{}, SimTK::Stage::Time);
+}
 
 void ExternalForce::computeForce(const SimTK::State& state, 
                               SimTK::Vector_<SimTK::SpatialVec>& bodyForces, 
                               SimTK::Vector& generalizedForces) const
 {
     double time = state.getTime();
+    // Only the value of the hints is used, not the validity of the cache
+    // entry.
+    std::array<int, 9>& hints = updCacheVariableValue(state, _functionHintsCV);
 
     assert(_appliedToBody!=nullptr);
 
     if (_appliesForce) {
-        Vec3 force = getForceAtTime(time);
+        Vec3 force = calcFunctionsAtTime(_forceFunctions, time, &hints[0]);
         force = _forceExpressedInBody->expressVectorInGround(state, force);
         Vec3 point(0); // Default is body origin.
         if (_specifiesPoint) {
-            point = getPointAtTime(time);
+            point = calcFunctionsAtTime(_pointFunctions, time, &hints[3]);
             point = _pointExpressedInBody->
                 findStationLocationInAnotherFrame(state, point, *_appliedToBody);
         }
@@ -348,7 +372,7 @@ void ExternalForce::computeForce(const SimTK::State& state,
     }
 
     if (_appliesTorque) {
-        Vec3 torque = getTorqueAtTime(time);
+        Vec3 torque = calcFunctionsAtTime(_torqueFunctions, time, &hints[6]);
         torque = _forceExpressedInBody->expressVectorInGround(state, torque);
         applyTorque(state, *_appliedToBody, torque, bodyForces);
     }
@@ -359,47 +383,20 @@ void ExternalForce::computeForce(const SimTK::State& state,
  */
 Vec3 ExternalForce::getForceAtTime(double aTime) const  
 {
-    SimTK::Vector timeAsVector(1, aTime);
-    const Function* forceX=NULL;
-    const Function* forceY=NULL;
-    const Function* forceZ=NULL;
-    if (_forceFunctions.size()==3){
-        forceX=_forceFunctions[0];  forceY=_forceFunctions[1];  forceZ=_forceFunctions[2];
-    }
-    Vec3 force(forceX?forceX->calcValue(timeAsVector):0.0, 
-        forceY?forceY->calcValue(timeAsVector):0.0, 
-        forceZ?forceZ->calcValue(timeAsVector):0.0);
-    return force;
+    int hints[3] {};
+    return calcFunctionsAtTime(_forceFunctions, aTime, hints);
 }
 
 Vec3 ExternalForce::getPointAtTime(double aTime) const
 {
-    SimTK::Vector timeAsVector(1, aTime);
-    const Function* pointX=NULL;
-    const Function* pointY=NULL;
-    const Function* pointZ=NULL;
-    if (_pointFunctions.size()==3){
-        pointX=_pointFunctions[0];  pointY=_pointFunctions[1];  pointZ=_pointFunctions[2];
-    }
-    Vec3 point(pointX?pointX->calcValue(timeAsVector):0.0, 
-        pointY?pointY->calcValue(timeAsVector):0.0, 
-        pointZ?pointZ->calcValue(timeAsVector):0.0);
-    return point;
+    int hints[3] {};
+    return calcFunctionsAtTime(_pointFunctions, aTime, hints);
 }
 
 Vec3 ExternalForce::getTorqueAtTime(double aTime) const
 {
-    SimTK::Vector timeAsVector(1, aTime);
-    const Function* torqueX=NULL;
-    const Function* torqueY=NULL;
-    const Function* torqueZ=NULL;
-    if (_torqueFunctions.size()==3){
-        torqueX=_torqueFunctions[0];    torqueY=_torqueFunctions[1];    torqueZ=_torqueFunctions[2];
-    }
-    Vec3 torque(torqueX?torqueX->calcValue(timeAsVector):0.0, 
-        torqueY?torqueY->calcValue(timeAsVector):0.0, 
-        torqueZ?torqueZ->calcValue(timeAsVector):0.0);
-    return torque;
+    int hints[3] {};
+    return calcFunctionsAtTime(_torqueFunctions, aTime, hints);
 }
 
 
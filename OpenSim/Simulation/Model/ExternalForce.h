@@ -25,6 +25,8 @@
 // INCLUDE
 #include "Force.h"
 
+#include <array>
+
 namespace OpenSim {
 
 class Model;
@@ -218,6 +220,7 @@ protected:
 
     /**  ModelComponent interface */ 
     void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
 
     /**
      * Compute the force.
@@ -258,6 +261,11 @@ private:
     ArrayPtrs<Function> _forceFunctions;
     ArrayPtrs<Function> _torqueFunctions;
     ArrayPtrs<Function> _pointFunctions;
+    /** interval hints for evaluating the force (0-2), point (3-5), and
+        torque (6-8) functions at increasing times (see
+        Function::calcValue(double, int&)); kept in the State, so that
+        computeForce() can be called concurrently with different States */
+    mutable CacheVariable<std::array<int, 9>> _functionHintsCV;
 
     friend class ExternalLoads;
 //==============================================================================
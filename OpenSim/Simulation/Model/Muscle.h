@@ -27,6 +27,10 @@
 // INCLUDE
 #include "PathActuator.h"
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #ifdef SWIG
     #ifdef OSIMSIMULATION_API
         #undef OSIMSIMULATION_API
@@ -468,6 +472,83 @@ protected:
         be calculated. */
     double _muscleWidth;
 
+#ifndef SWIG
+public:
+ /**
+    InfoExtras holds the user-defined extras of the MuscleLengthInfo,
+    FiberVelocityInfo, MuscleDynamicsInfo, and MusclePotentialEnergyInfo
+    structs. It provides the subset of the SimTK::Vector interface used for
+    these extras (resize(), size(), and element access). Up to InlineCapacity
+    elements are stored inline, so that copying a SimTK::State does not
+    allocate memory for the extras of each muscle; larger sizes are stored
+    on the heap.
+    */
+    class InfoExtras {
+    public:
+        /** The number of extras stored without allocating memory. */
+        static constexpr int InlineCapacity = 8;
+
+        InfoExtras() { m_data.fill(SimTK::NaN); }
+        InfoExtras(int size, double value) : InfoExtras() {
+            resize(size);
+            std::fill(begin(), begin() + m_size, value);
+        }
+        InfoExtras& operator=(const SimTK::Vector& values) {
+            resize(values.size());
+            for (int i = 0; i < m_size; ++i) (*this)[i] = values[i];
+            return *this;
+        }
+
+        int size() const { return m_size; }
+        int nrow() const { return m_size; }
+        /** Change the number of extras. New elements are set to NaN. */
+        void resize(int size) {
+            SimTK_ERRCHK1_ALWAYS(size >= 0, "Muscle::InfoExtras::resize",
+                    "Expected a nonnegative size, but got %d.", size);
+            if (size > InlineCapacity) {
+                if (m_heap.empty())
+                    m_heap.assign(m_data.begin(), m_data.begin() + m_size);
+                m_heap.resize(size, SimTK::NaN);
+            } else if (!m_heap.empty()) {
+                // Shrinking from the heap back to the inline storage.
+                std::copy(m_heap.begin(), m_heap.begin() + size,
+                          m_data.begin());
+                std::vector<double>().swap(m_heap);
+            } else {
+                for (int i = m_size; i < size; ++i) m_data[i] = SimTK::NaN;
+            }
+            m_size = size;
+        }
+
+        double& operator[](int i) {
+            SimTK_INDEXCHECK(i, m_size, "Muscle::InfoExtras::operator[]");
+            return begin()[i];
+        }
+        const double& operator[](int i) const {
+            SimTK_INDEXCHECK(i, m_size, "Muscle::InfoExtras::operator[]");
+            return begin()[i];
+        }
+        double& operator()(int i) { return operator[](i); }
+        const double& operator()(int i) const { return operator[](i); }
+
+    private:
+        double* begin() {
+            return m_heap.empty() ? m_data.data() : m_heap.data();
+        }
+        const double* begin() const {
+            return m_heap.empty() ? m_data.data() : m_heap.data();
+        }
+
+        int m_size = 0;
+        std::array<double, InlineCapacity> m_data;
+        // Holds the elements instead of m_data if there are more than
+        // InlineCapacity elements; empty otherwise.
+        std::vector<double> m_heap;
+    };
+#endif
+
+protected:
+
  /**
     The MuscleLengthInfo struct contains information about the muscle that is
     strictly a function of the length of the fiber and the tendon, and the 
@@ -572,7 +653,7 @@ protected:
         double fiberPassiveForceLengthMultiplier;   //NA             NA
         double fiberActiveForceLengthMultiplier;  //NA             NA
         
-        SimTK::Vector userDefinedLengthExtras;//NA        NA
+        InfoExtras userDefinedLengthExtras;//NA        NA
 
         MuscleLengthInfo(): 
             fiberLength(SimTK::NaN), 
@@ -664,7 +745,7 @@ protected:
 
         double fiberForceVelocityMultiplier;     //force/force           NA
 
-        SimTK::Vector userDefinedVelocityExtras;//NA                  NA
+        InfoExtras userDefinedVelocityExtras;//NA                  NA
 
         FiberVelocityInfo(): 
             fiberVelocity(SimTK::NaN), 
@@ -787,7 +868,7 @@ protected:
         double tendonPower;             // force*velocity       W
         double musclePower;             // force*velocity       W
 
-        SimTK::Vector userDefinedDynamicsExtras; //NA          NA
+        InfoExtras userDefinedDynamicsExtras; //NA          NA
 
         MuscleDynamicsInfo(): 
             activation(SimTK::NaN), 
@@ -841,7 +922,7 @@ protected:
         double tendonPotentialEnergy;    //force*distance    J (Nm)     
         double musclePotentialEnergy;    //force*distance    J (Nm)
 
-        SimTK::Vector userDefinedPotentialEnergyExtras;//NA                  NA
+        InfoExtras userDefinedPotentialEnergyExtras;//NA                  NA
 
         MusclePotentialEnergyInfo(): 
             fiberPotentialEnergy(SimTK::NaN),
@@ -23,7 +23,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
-#include "StatesTrajectory.h"
+#include "CompactStatesTrajectory.h"
 #include "osimSimulationDLL.h"
 #include <regex>
 
@@ -271,8 +271,10 @@ TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
     model.addComponent(reporter);
     model.initSystem();
 
+    // Only the state variable values are stored for each time; the states
+    // are materialized one at a time in the loop below.
     const auto statesTraj =
-            StatesTrajectory::createFromStatesTable(model, statesTable);
+            CompactStatesTrajectory::createFromStatesTable(model, statesTable);
 
     const std::vector<std::string>& controlNames =
             controlsTable.getColumnLabels();
@@ -316,9 +318,10 @@ TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
     }
 
     // Loop through the states trajectory to create the report.
+    SimTK::State state = model.getWorkingState();
     for (int itime = 0; itime < (int)statesTraj.getSize(); ++itime) {
         // Get the current state.
-        auto state = statesTraj[itime];
+        statesTraj.copyToState(itime, state);
 
         // Enforce any SimTK::Motion's included in the model.
         model.getSystem().prescribe(state);
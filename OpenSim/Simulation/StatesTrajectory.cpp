@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "StatesTrajectory.h"
+#include "CompactStatesTrajectory.h"
 
 #include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Storage.h>
@@ -123,10 +124,15 @@ namespace {
     }
 }
 
-TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
-        const std::vector<std::string>& requestedStateVars) const {
+// The following two functions are shared by StatesTrajectory and
+// CompactStatesTrajectory.
+namespace {
+template <typename TrajectoryType>
+TimeSeriesTable exportTrajectoryToTable(const TrajectoryType& trajectory,
+        const Model& model,
+        const std::vector<std::string>& requestedStateVars) {
 
-    OPENSIM_THROW_IF(!isCompatibleWith(model),
+    OPENSIM_THROW_IF(!trajectory.isCompatibleWith(model),
                      StatesTrajectory::IncompatibleModel, model);
 
     // This code is based on DelimFileAdapter::extendRead().
@@ -140,8 +146,8 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
     size_t numDepColumns = stateVars.size();
 
     // Fill up the table with the data.
-    for (size_t itime = 0; itime < getSize(); ++itime) {
-        const auto& state = get(itime);
+    table.reserve(trajectory.getSize());
+    for (const auto& state : trajectory) {
         TimeSeriesTable::RowVector row(static_cast<int>(numDepColumns));
 
         // Get each state variable's value.
@@ -161,17 +167,8 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
     return table;
 }
 
-StatesTrajectory StatesTrajectory::createFromStatesStorage(
-        const Model& model,
-        const Storage& sto,
-        bool allowMissingColumns,
-        bool allowExtraColumns,
-        bool assemble) {
-    return createFromStatesTable(model, sto.exportToTable(),
-            allowMissingColumns, allowExtraColumns, assemble);
-}
-
-StatesTrajectory StatesTrajectory::createFromStatesTable(
+template <typename TrajectoryType>
+TrajectoryType createTrajectoryFromStatesTable(
         const Model& model,
         const TimeSeriesTable& table,
         bool allowMissingColumns,
@@ -182,7 +179,7 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
     // ==============================
 
     // This is what we'll return.
-    StatesTrajectory states;
+    TrajectoryType states;
 
     // Make a copy of the model so that we can get a corresponding state.
     Model localModel(model);
@@ -199,7 +196,8 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
     // Angular quantities must be expressed in radians.
     // TODO we could also manually convert the necessary coords/speeds to
     // radians.
-    OPENSIM_THROW_IF(TableUtilities::isInDegrees(table), DataIsInDegrees);
+    OPENSIM_THROW_IF(TableUtilities::isInDegrees(table),
+            StatesTrajectory::DataIsInDegrees);
 
     // If column labels aren't unique, it's unclear which column the user
     // wanted to use for the related state variable.
@@ -223,7 +221,7 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
         }
     }
     OPENSIM_THROW_IF(!allowMissingColumns && !missingColumnNames.empty(),
-            MissingColumns,
+            StatesTrajectory::MissingColumns,
             localModel.getName(), missingColumnNames);
 
     // Check if the Storage has columns that are not states in the Model.
@@ -239,8 +237,8 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
                     extraColumnNames.push_back(tableLabels[ic]);
                 }
             }
-            OPENSIM_THROW(ExtraColumns, localModel.getName(),
-                    extraColumnNames);
+            OPENSIM_THROW(StatesTrajectory::ExtraColumns,
+                    localModel.getName(), extraColumnNames);
         }
     }
 
@@ -248,7 +246,7 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
     // ===================
 
     // Reserve the memory we'll need to fit all the states.
-    states.m_states.reserve(table.getNumRows());
+    states.reserve(table.getNumRows());
 
     // Working memory for state. Initialize so that missing columns end up as
     // NaN.
@@ -280,6 +278,32 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
 
     return states;
 }
+} // namespace
+
+TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
+        const std::vector<std::string>& requestedStateVars) const {
+    return exportTrajectoryToTable(*this, model, requestedStateVars);
+}
+
+StatesTrajectory StatesTrajectory::createFromStatesStorage(
+        const Model& model,
+        const Storage& sto,
+        bool allowMissingColumns,
+        bool allowExtraColumns,
+        bool assemble) {
+    return createFromStatesTable(model, sto.exportToTable(),
+            allowMissingColumns, allowExtraColumns, assemble);
+}
+
+StatesTrajectory StatesTrajectory::createFromStatesTable(
+        const Model& model,
+        const TimeSeriesTable& table,
+        bool allowMissingColumns,
+        bool allowExtraColumns,
+        bool assemble) {
+    return createTrajectoryFromStatesTable<StatesTrajectory>(model, table,
+            allowMissingColumns, allowExtraColumns, assemble);
+}
 
 StatesTrajectory StatesTrajectory::createFromStatesStorage(
         const Model& model,
@@ -298,3 +322,20 @@ StatesTrajectory::IncompatibleModel::IncompatibleModel(
             "compatible with the StatesTrajectory.";
     addMessage(msg.str());
 }
+
+// These CompactStatesTrajectory functions are defined here to share their
+// implementation with StatesTrajectory.
+TimeSeriesTable CompactStatesTrajectory::exportToTable(const Model& model,
+        const std::vector<std::string>& requestedStateVars) const {
+    return exportTrajectoryToTable(*this, model, requestedStateVars);
+}
+
+CompactStatesTrajectory CompactStatesTrajectory::createFromStatesTable(
+        const Model& model,
+        const TimeSeriesTable& table,
+        bool allowMissingColumns,
+        bool allowExtraColumns,
+        bool assemble) {
+    return createTrajectoryFromStatesTable<CompactStatesTrajectory>(model,
+            table, allowMissingColumns, allowExtraColumns, assemble);
+}
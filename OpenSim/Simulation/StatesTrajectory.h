@@ -217,6 +217,10 @@ public:
      * passed in.
      */
     void append(const SimTK::State& state);
+    /** Allocate memory for at least the given number of states, e.g., before
+     * appending states from a simulation whose number of reported steps is
+     * known in advance. */
+    void reserve(size_t numStates) { m_states.reserve(numStates); }
     /// @}
 
     /// @name Checks for integrity
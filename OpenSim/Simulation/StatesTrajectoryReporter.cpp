@@ -23,17 +23,54 @@
 
 #include "StatesTrajectoryReporter.h"
 
+#include <OpenSim/Simulation/Model/Model.h>
+
 using namespace OpenSim;
 
 
 void StatesTrajectoryReporter::clear() {
+    closeOutputFile();
     m_states.clear();
+    m_compactStates.clear();
+}
+
+void StatesTrajectoryReporter::reserve(size_t numStates) {
+    m_numReservedStates = numStates;
+    if (m_useCompactStates) m_compactStates.reserve(numStates);
+    else m_states.reserve(numStates);
 }
 
 const StatesTrajectory& StatesTrajectoryReporter::getStates() const {
+    OPENSIM_THROW_IF_FRMOBJ(m_useCompactStates, Exception,
+            "The states are recorded in a CompactStatesTrajectory; use "
+            "getCompactStates() instead.");
     return m_states;
 }
 
+const CompactStatesTrajectory&
+StatesTrajectoryReporter::getCompactStates() const {
+    return m_compactStates;
+}
+
+void StatesTrajectoryReporter::setUseCompactStates(bool tf) {
+    m_useCompactStates = tf;
+    clear();
+}
+
+void StatesTrajectoryReporter::setOutputFileName(const std::string& fileName,
+        bool useBackgroundThread) {
+    closeOutputFile();
+    m_outputFileName = fileName;
+    m_useBackgroundThread = useBackgroundThread;
+}
+
+void StatesTrajectoryReporter::closeOutputFile() {
+    if (!m_outputWriter) return;
+    // Release the writer even if closing throws.
+    std::unique_ptr<TableFileWriter> writer(std::move(m_outputWriter));
+    writer->close();
+}
+
 /*
 TODO we have to discuss if the trajectory should be cleared.
 void StatesTrajectoryReporter::extendRealizeInstance(const SimTK::State& state) const {
@@ -43,5 +80,36 @@ void StatesTrajectoryReporter::extendRealizeInstance(const SimTK::State& state)
 */
 
 void StatesTrajectoryReporter::implementReport(const SimTK::State& state) const {
-    m_states.append(state);
+    if (!m_useCompactStates) {
+        m_states.append(state);
+    } else {
+        if (m_compactStates.getSize() == 0) {
+            // Also record the discrete variables of the Model, if this
+            // reporter is part of one. The discrete variables are allocated by
+            // now.
+            const auto* model = dynamic_cast<const Model*>(&getRoot());
+            m_compactStates = model ? CompactStatesTrajectory(*model)
+                                    : CompactStatesTrajectory();
+            m_compactStates.reserve(m_numReservedStates);
+        }
+        m_compactStates.append(state);
+    }
+
+    if (m_outputFileName.empty()) return;
+    const auto* model = dynamic_cast<const Model*>(&getRoot());
+    OPENSIM_THROW_IF_FRMOBJ(!model, Exception,
+            "Expected this reporter to be part of a Model to write the states "
+            "to file '" + std::string(m_outputFileName) + "'.");
+    if (!m_outputWriter) {
+        // Write all accumulated states, including this one.
+        TimeSeriesTable table = m_useCompactStates
+                ? m_compactStates.exportToTable(*model)
+                : m_states.exportToTable(*model);
+        table.addTableMetaData("inDegrees", std::string("no"));
+        m_outputWriter.reset(new TableFileWriter(m_outputFileName, table,
+                m_useBackgroundThread));
+        return;
+    }
+    m_outputWriter->appendRow(state.getTime(),
+            ~model->getStateVariableValues(state));
 }
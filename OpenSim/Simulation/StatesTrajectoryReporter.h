@@ -23,8 +23,9 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
-#include "StatesTrajectory.h"
+#include "CompactStatesTrajectory.h"
 #include <OpenSim/Common/Reporter.h>
+#include <OpenSim/Common/TableFileWriter.h>
 
 #include "osimSimulationDLL.h"
 
@@ -41,10 +42,45 @@ class OSIMSIMULATION_API StatesTrajectoryReporter : public AbstractReporter {
 OpenSim_DECLARE_CONCRETE_OBJECT(StatesTrajectoryReporter, AbstractReporter);
 
 public:
-    /** Access the accumulated states. */
-    const StatesTrajectory& getStates() const; 
+    /** Access the accumulated states.
+     * @throws Exception If the states are recorded in a
+     *      CompactStatesTrajectory (see setUseCompactStates()). */
+    const StatesTrajectory& getStates() const;
+    /** Access the accumulated states if they are recorded in a
+     * CompactStatesTrajectory (see setUseCompactStates()). */
+    const CompactStatesTrajectory& getCompactStates() const;
+    /** Record the states in a CompactStatesTrajectory, which stores only the
+     * time, the continuous state variables, and the discrete variables of
+     * each state, instead of a StatesTrajectory, which stores a full copy of
+     * each state. Use this for long simulations or large models. This
+     * setting is false by default; changing it clears the accumulated
+     * states. */
+    void setUseCompactStates(bool tf);
+    bool getUseCompactStates() const { return m_useCompactStates; }
     /** Clear the accumulated states. */ 
     void clear();
+    /** Allocate memory for the given number of states, if the number of
+     * states that will be reported is known in advance. */
+    void reserve(size_t numStates);
+
+    /** Also write the state variables of the reported states to a file
+     * while they are reported, so that they are not lost if the simulation
+     * does not finish. The file has the same columns as the table from
+     * StatesTrajectory::exportToTable() and can be read back with
+     * StatesTrajectory::createFromStatesTable(). It is written with a
+     * TableFileWriter (STO format, or CSV if the file name ends with ".csv"),
+     * optionally in a background thread. The file is created when the next
+     * state is reported and then holds all accumulated states. The file is
+     * complete once closeOutputFile() or clear() is called, or the reporter
+     * is destroyed; reporting after that overwrites the file. The reporter
+     * must be part of a Model. Pass an empty file name to stop writing to a
+     * file. The file name is not copied with the reporter. */
+    void setOutputFileName(const std::string& fileName,
+                           bool useBackgroundThread = false);
+    const std::string& getOutputFileName() const { return m_outputFileName; }
+    /** Write the remaining states to the output file, if any, and close
+     * it. */
+    void closeOutputFile();
 
 protected:
     // /** Clears the internal StatesTrajectory in preparation for a (new)
@@ -59,6 +95,15 @@ private:
     // Mutable because we append during reporting. This is OK to do since
     // reporting never occurs for trial states.
     mutable StatesTrajectory m_states;
+    mutable CompactStatesTrajectory m_compactStates;
+    bool m_useCompactStates = false;
+    // The number of states passed to reserve().
+    size_t m_numReservedStates = 0;
+
+    SimTK::ResetOnCopy<std::string> m_outputFileName;
+    bool m_useBackgroundThread = false;
+    mutable SimTK::ResetOnCopy<std::unique_ptr<TableFileWriter>>
+            m_outputWriter;
 };
 
 } // namespace
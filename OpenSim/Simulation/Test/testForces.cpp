@@ -282,6 +282,27 @@ void testExpressionBasedCoordinateForce() {
 
     ASSERT(*copyOfSpring == spring);
 
+    // The expression of a copied model must be evaluated with the copy's own
+    // variable values.
+    Model modelCopy(osimModel);
+    SimTK::State& copyState = modelCopy.initSystem();
+    copyState.setTime(osim_state.getTime());
+    copyState.updQ() = osim_state.getQ();
+    copyState.updU() = osim_state.getU();
+    modelCopy.realizeVelocity(copyState);
+    const auto& springInCopy =
+            modelCopy.getComponent<ExpressionBasedCoordinateForce>(
+                    spring.getAbsolutePathString());
+    ASSERT_EQUAL(spring.calcExpressionForce(osim_state),
+            springInCopy.calcExpressionForce(copyState), 1e-12);
+
+    // Variables other than q and qdot are not allowed.
+    Model modelWithInvalidExpression(osimModel);
+    auto* invalidSpring = new ExpressionBasedCoordinateForce("ball_h", "-10*x");
+    invalidSpring->setName("invalid_spring");
+    modelWithInvalidExpression.addForce(invalidSpring);
+    ASSERT_THROW(OpenSim::Exception, modelWithInvalidExpression.initSystem());
+
     osimModel.print("ExpressionBasedCoordinateForceModel.osim");
 
     osimModel.disownAllComponents();
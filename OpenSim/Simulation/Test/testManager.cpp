@@ -37,6 +37,12 @@ Manager Tests:
 4. testConstructors: Ensure different constructors work as intended.
 5. testIntegratorInterface: Ensure setting integrator options works as intended.
 6. testExceptions: Test that misuse actually triggers exceptions.
+7. testRecordingPolicies: Ensure the recording policies and the states buffer
+   record the expected states.
+8. testStatesOutputFile: Ensure the file written while integrating holds the
+   recorded states.
+9. testRecordingControls: Ensure the controls are stored at the same times as
+   the recorded states.
 
 //=============================================================================*/
 #include <OpenSim/Simulation/Model/Model.h>
@@ -46,7 +52,11 @@ Manager Tests:
 #include <OpenSim/Simulation/Manager/Manager.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 #include <OpenSim/Simulation/Control/PrescribedController.h>
+#include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
 #include <OpenSim/Common/Constant.h>
+#include <OpenSim/Common/LinearFunction.h>
+#include <cstdio>
 
 using namespace OpenSim;
 using namespace std;
@@ -56,6 +66,9 @@ void testExcitationUpdatesWithManager();
 void testConstructors();
 void testIntegratorInterface();
 void testExceptions();
+void testRecordingPolicies();
+void testStatesOutputFile();
+void testRecordingControls();
 
 int main()
 {
@@ -97,6 +110,24 @@ int main()
         failures.push_back("testExceptions");
     }
 
+    try { testRecordingPolicies(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testRecordingPolicies");
+    }
+
+    try { testStatesOutputFile(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testStatesOutputFile");
+    }
+
+    try { testRecordingControls(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testRecordingControls");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -478,3 +509,228 @@ void testExceptions()
     manager.setIntegratorAccuracy(1e-4);
     manager.setIntegratorMinimumStepSize(0.01);
 }
+
+void testRecordingPolicies()
+{
+    cout << "Running testRecordingPolicies" << endl;
+
+    using SimTK::Vec3;
+    const double g = 9.81;
+
+    // A falling ball, whose height is known analytically.
+    Model model;
+    model.setGravity(Vec3(0, -g, 0));
+    auto ball = new Body("ball", 1., Vec3(0), SimTK::Inertia::sphere(1.));
+    model.addBody(ball);
+    auto freeJoint = new FreeJoint("freeJoint", model.getGround(), *ball);
+    model.addJoint(freeJoint);
+    SimTK::State initState = model.initSystem();
+    const std::string heightLabel =
+            freeJoint->getCoordinate(FreeJoint::Coord::TranslationY)
+                    .getAbsolutePathString() + "/value";
+
+    const double finalTime = 1.0;
+    auto simulate = [&](Manager& manager) {
+        manager.setPerformAnalyses(false);
+        manager.initialize(initState);
+        manager.integrate(finalTime);
+        return manager.getStatesTable();
+    };
+
+    // Default: every integration step is recorded into the Storage.
+    Manager managerAll(model);
+    const TimeSeriesTable tableAll = simulate(managerAll);
+    const int numSteps = (int)tableAll.getNumRows();
+    SimTK_TEST(numSteps > 2);
+
+    // The states buffer records the same states as the Storage.
+    {
+        Manager manager(model);
+        manager.setUseStatesBuffer(true, 4);
+        const TimeSeriesTable table = simulate(manager);
+        SimTK_TEST(table.getNumRows() == tableAll.getNumRows());
+        SimTK_TEST(table.getColumnLabels() == tableAll.getColumnLabels());
+        SimTK_TEST(table.getIndependentColumn() ==
+                tableAll.getIndependentColumn());
+        for (int i = 0; i < numSteps; ++i) {
+            for (int j = 0; j < (int)table.getNumColumns(); ++j) {
+                SimTK_TEST(table.getMatrix()(i, j) ==
+                        tableAll.getMatrix()(i, j));
+            }
+        }
+        // The buffer is accessible without a copy.
+        const TimeSeriesTable& buffer = manager.getStatesBuffer();
+        SimTK_TEST(buffer.getIndependentColumn() ==
+                table.getIndependentColumn());
+        SimTK_TEST(buffer.getColumnLabels() == table.getColumnLabels());
+        SimTK_TEST(buffer.getMatrix().nrow() == numSteps);
+        SimTK_TEST(buffer.getTableMetaDataAsString("inDegrees") == "no");
+        // The Storage is created from the buffer on request.
+        SimTK_TEST(manager.getStateStorage().getSize() == numSteps);
+    }
+    SimTK_TEST_MUST_THROW_EXC(managerAll.getStatesBuffer(), Exception);
+
+    // Every other step, plus the initial and final states.
+    {
+        Manager manager(model);
+        manager.setRecordingPolicy(Manager::RecordingPolicy::EveryNthStep);
+        manager.setRecordingStepInterval(2);
+        const TimeSeriesTable table = simulate(manager);
+        SimTK_TEST((int)table.getNumRows() < numSteps);
+        SimTK_TEST(table.getIndependentColumn().front() == 0);
+        SimTK_TEST_EQ(table.getIndependentColumn().back(), finalTime);
+    }
+
+    // Fixed output interval, with and without the states buffer.
+    for (bool useStatesBuffer : {false, true}) {
+        Manager manager(model);
+        manager.setRecordingPolicy(Manager::RecordingPolicy::FixedInterval);
+        manager.setRecordingTimeInterval(0.1);
+        manager.setUseStatesBuffer(useStatesBuffer);
+        const TimeSeriesTable table = simulate(manager);
+        SimTK_TEST(table.getNumRows() == 11);
+        const auto& time = table.getIndependentColumn();
+        const auto& height = table.getDependentColumn(heightLabel);
+        for (int i = 0; i < (int)table.getNumRows(); ++i) {
+            SimTK_TEST_EQ(time[i], 0.1 * i);
+            // Linear interpolation between integration steps.
+            SimTK_TEST_EQ_TOL(height[i], -0.5 * g * time[i] * time[i], 1e-2);
+        }
+    }
+
+    // The fixed output times start at the initial state given to
+    // initialize() (not at the start of a previous run) and continue across
+    // calls to integrate().
+    for (bool useStatesBuffer : {false, true}) {
+        SimTK::State laterState = initState;
+        laterState.setTime(0.25);
+        Manager manager(model);
+        manager.setRecordingPolicy(Manager::RecordingPolicy::FixedInterval);
+        manager.setRecordingTimeInterval(0.25);
+        manager.setUseStatesBuffer(useStatesBuffer);
+        manager.setPerformAnalyses(false);
+        manager.initialize(laterState);
+        manager.integrate(0.5);
+        manager.integrate(finalTime);
+        const TimeSeriesTable table = manager.getStatesTable();
+        SimTK_TEST(table.getNumRows() == 4);
+        const auto& time = table.getIndependentColumn();
+        for (int i = 0; i < (int)table.getNumRows(); ++i) {
+            SimTK_TEST_EQ(time[i], 0.25 * (i + 1));
+        }
+    }
+
+    // No states are recorded.
+    {
+        Manager manager(model);
+        manager.setRecordingPolicy(Manager::RecordingPolicy::None);
+        manager.setPerformAnalyses(false);
+        manager.initialize(initState);
+        manager.integrate(finalTime);
+        SimTK_TEST(manager.getStateStorage().getSize() == 0);
+    }
+
+    // The FixedInterval policy needs an interval.
+    {
+        Manager manager(model);
+        manager.setRecordingPolicy(Manager::RecordingPolicy::FixedInterval);
+        manager.initialize(initState);
+        SimTK_TEST_MUST_THROW_EXC(manager.integrate(finalTime), Exception);
+        SimTK_TEST_MUST_THROW_EXC(manager.setRecordingTimeInterval(0),
+                Exception);
+        SimTK_TEST_MUST_THROW_EXC(manager.setRecordingStepInterval(0),
+                Exception);
+    }
+}
+
+void testStatesOutputFile()
+{
+    cout << "Running testStatesOutputFile" << endl;
+
+    using SimTK::Vec3;
+
+    // A falling ball.
+    Model model;
+    auto ball = new Body("ball", 1., Vec3(0), SimTK::Inertia::sphere(1.));
+    model.addBody(ball);
+    auto freeJoint = new FreeJoint("freeJoint", model.getGround(), *ball);
+    model.addJoint(freeJoint);
+    SimTK::State initState = model.initSystem();
+
+    // The file holds the same states as getStatesTable(), with and without
+    // the states buffer.
+    for (bool useStatesBuffer : {false, true}) {
+        const std::string fileName = "testManager_statesOutputFile.sto";
+        Manager manager(model);
+        manager.setUseStatesBuffer(useStatesBuffer);
+        manager.setPerformAnalyses(false);
+        manager.initialize(initState);
+        manager.integrate(0.5);
+        // The states recorded so far are written first.
+        manager.setStatesOutputFileName(fileName);
+        manager.integrate(1.0);
+        manager.closeStatesOutputFile();
+
+        const TimeSeriesTable expected = manager.getStatesTable();
+        const TimeSeriesTable actual(fileName);
+        SimTK_TEST(actual.getNumRows() == expected.getNumRows());
+        SimTK_TEST(actual.getColumnLabels() == expected.getColumnLabels());
+        for (int i = 0; i < (int)expected.getNumRows(); ++i) {
+            SimTK_TEST_EQ(actual.getIndependentColumn()[i],
+                    expected.getIndependentColumn()[i]);
+            for (int j = 0; j < (int)expected.getNumColumns(); ++j) {
+                SimTK_TEST_EQ(actual.getMatrix()(i, j),
+                        expected.getMatrix()(i, j));
+            }
+        }
+        std::remove(fileName.c_str());
+    }
+}
+
+void testRecordingControls()
+{
+    cout << "Running testRecordingControls" << endl;
+
+    using SimTK::Vec3;
+
+    // A block on a slider, driven by a control that is linear in time.
+    Model model;
+    auto block = new Body("block", 1., Vec3(0), SimTK::Inertia(1.));
+    model.addBody(block);
+    auto slider = new SliderJoint("slider", model.getGround(), *block);
+    model.addJoint(slider);
+    auto actuator = new CoordinateActuator(
+            slider->getCoordinate().getName());
+    actuator->setName("actuator");
+    model.addForce(actuator);
+    auto controller = new PrescribedController();
+    controller->addActuator(*actuator);
+    controller->prescribeControlForActuator("actuator",
+            new LinearFunction(2.0, 1.0));
+    model.addController(controller);
+    SimTK::State initState = model.initSystem();
+
+    // The controls are interpolated at the fixed output times, so they are
+    // stored at the times of the recorded states.
+    for (bool useStatesBuffer : {false, true}) {
+        Manager manager(model);
+        manager.setRecordingPolicy(Manager::RecordingPolicy::FixedInterval);
+        manager.setRecordingTimeInterval(0.1);
+        manager.setUseStatesBuffer(useStatesBuffer);
+        manager.setPerformAnalyses(false);
+        manager.initialize(initState);
+        manager.integrate(1.0);
+
+        const TimeSeriesTable states = manager.getStatesTable();
+        const TimeSeriesTable controls = model.getControlsTable();
+        SimTK_TEST(states.getNumRows() == 11);
+        SimTK_TEST(controls.getNumRows() == states.getNumRows());
+        const auto& control = controls.getDependentColumn("actuator");
+        for (int i = 0; i < (int)controls.getNumRows(); ++i) {
+            const double time = controls.getIndependentColumn()[i];
+            SimTK_TEST_EQ(time, states.getIndependentColumn()[i]);
+            // Linear interpolation of a linear control is exact.
+            SimTK_TEST_EQ(control[i], 2.0 * time + 1.0);
+        }
+    }
+}
@@ -29,6 +29,8 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/SimbodyEngine/SliderJoint.h>
 
+#include <cstdio>
+
 using namespace std;
 using namespace SimTK;
 using namespace OpenSim;
@@ -116,9 +118,63 @@ void testTableReporterLabels() {
     SimTK_TEST(headings[1] == "height");
 }
 
+void testTableReporterOutputFile() {
+    // Create a model consisting of a falling ball.
+    Model model;
+    model.setName("world");
+
+    auto* ball = new OpenSim::Body("ball", 1., Vec3(0), Inertia(0));
+    model.addBody(ball);
+
+    auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+        Vec3(0,0,Pi/2.), *ball, Vec3(0), Vec3(0,0,Pi/2.));
+    model.addJoint(slider);
+
+    // Also write the report to a file while simulating.
+    const std::string fileName = "testReporters_TableReporter.sto";
+    auto* reporter = new TableReporter();
+    reporter->set_report_time_interval(0.1);
+    reporter->addToReport(slider->getCoordinate().getOutput("value"),
+                          "height");
+    reporter->addToReport(slider->getCoordinate().getOutput("speed"),
+                          "speed");
+    reporter->setOutputFileName(fileName);
+    model.addComponent(reporter);
+
+    // Simulate.
+    State& state = model.initSystem();
+    Manager manager(model);
+    state.setTime(0.0);
+    manager.initialize(state);
+    manager.integrate(1.0);
+    reporter->closeOutputFile();
+
+    // The file holds the same rows as the table.
+    const auto& expected = reporter->getTable();
+    const TimeSeriesTable actual(fileName);
+    SimTK_TEST(expected.getNumRows() > 1);
+    SimTK_TEST(actual.getNumRows() == expected.getNumRows());
+    SimTK_TEST(actual.getColumnLabels() == expected.getColumnLabels());
+    for (int i = 0; i < (int)expected.getNumRows(); ++i) {
+        SimTK_TEST_EQ(actual.getIndependentColumn()[i],
+                      expected.getIndependentColumn()[i]);
+        for (int j = 0; j < (int)expected.getNumColumns(); ++j) {
+            SimTK_TEST_EQ(actual.getMatrix()(i, j),
+                          expected.getMatrix()(i, j));
+        }
+    }
+
+    // The file name is not copied with the reporter.
+    std::unique_ptr<TableReporter> copy(reporter->clone());
+    SimTK_TEST(copy->getOutputFileName().empty());
+
+    std::remove(fileName.c_str());
+}
+
 int main() {
     SimTK_START_TEST("testReporters");
         SimTK_SUBTEST(testConsoleReporterLabels);
         SimTK_SUBTEST(testTableReporterLabels);
+        SimTK_SUBTEST(testTableReporterOutputFile);
     SimTK_END_TEST();
 };
@@ -679,6 +679,63 @@ void testIntegrityChecks() {
     // and Z's both pass the check. 
 }
 
+void testStatesTrajectoryReporterOutputFile() {
+    // A falling ball.
+    Model model;
+    auto* ball = new OpenSim::Body("ball", 1, SimTK::Vec3(0),
+            SimTK::Inertia::sphere(1));
+    model.addBody(ball);
+    model.addJoint(new FreeJoint("freeJoint", model.getGround(), *ball));
+    auto* statesCol = new StatesTrajectoryReporter();
+    statesCol->set_report_time_interval(0.1);
+    model.addComponent(statesCol);
+
+    const std::string fileName =
+            "testStatesTrajectory_reporterOutputFile.sto";
+    {
+        SimTK::State state = model.initSystem();
+        Manager manager(model);
+        manager.setPerformAnalyses(false);
+        manager.setWriteToStorage(false);
+        manager.initialize(state);
+        manager.integrate(0.5);
+        // The next report also writes the states reported so far.
+        statesCol->setOutputFileName(fileName);
+        manager.integrate(1.0);
+        statesCol->closeOutputFile();
+    }
+
+    // The file holds the same states as the reporter.
+    const TimeSeriesTable expected =
+            statesCol->getStates().exportToTable(model);
+    const TimeSeriesTable actual(fileName);
+    SimTK_TEST(expected.getNumRows() > 6);
+    SimTK_TEST(actual.getNumRows() == expected.getNumRows());
+    SimTK_TEST(actual.getColumnLabels() == expected.getColumnLabels());
+    for (int i = 0; i < (int)expected.getNumRows(); ++i) {
+        SimTK_TEST_EQ(actual.getIndependentColumn()[i],
+                      expected.getIndependentColumn()[i]);
+        for (int j = 0; j < (int)expected.getNumColumns(); ++j) {
+            SimTK_TEST_EQ(actual.getMatrix()(i, j),
+                          expected.getMatrix()(i, j));
+        }
+    }
+    // The file can be used to create a trajectory.
+    const auto states =
+            StatesTrajectory::createFromStatesTable(model, actual);
+    SimTK_TEST(states.getSize() == statesCol->getStates().getSize());
+    remove(fileName.c_str());
+
+    // Writing the states requires the reporter to be part of a Model.
+    {
+        SimTK::State state = model.initSystem();
+        StatesTrajectoryReporter standalone;
+        standalone.setOutputFileName(fileName);
+        SimTK_TEST_MUST_THROW_EXC(standalone.report(state),
+                                  OpenSim::Exception);
+    }
+}
+
 void tableAndTrajectoryMatch(const Model& model,
                              const TimeSeriesTable& table,
                              const StatesTrajectory& states,
@@ -770,6 +827,118 @@ void testExport() {
             OpenSim::Exception);
 }
 
+void testCompactStatesTrajectory() {
+    Model model("gait2354_simbody.osim");
+    model.updCoordinateSet().get("pelvis_ty").setDefaultLocked(true);
+
+    auto* statesCol = new StatesTrajectoryReporter();
+    statesCol->setName("states_collector");
+    model.addComponent(statesCol);
+    auto* compactCol = new StatesTrajectoryReporter();
+    compactCol->setName("compact_states_collector");
+    compactCol->setUseCompactStates(true);
+    model.addComponent(compactCol);
+
+    // The reporters record the same states.
+    {
+        auto& state = model.initSystem();
+        SimTK::RungeKuttaMersonIntegrator integrator(model.getSystem());
+        SimTK::TimeStepper ts(model.getSystem(), integrator);
+        ts.initialize(state);
+        ts.setReportAllSignificantStates(true);
+        integrator.setReturnEveryInternalStep(true);
+        while (ts.getState().getTime() < 0.05) {
+            ts.stepTo(0.05);
+            model.getMultibodySystem().realize(ts.getState(),
+                    SimTK::Stage::Report);
+        }
+    }
+    SimTK_TEST_MUST_THROW_EXC(compactCol->getStates(), OpenSim::Exception);
+    const auto& states = statesCol->getStates();
+    const auto& compact = compactCol->getCompactStates();
+    SimTK_TEST(compact.getSize() == states.getSize());
+    SimTK_TEST(compact.getSize() > 2);
+    SimTK_TEST(compact.getNumY() == states[0].getNY());
+    SimTK_TEST(compact.isCompatibleWith(model));
+    size_t i = 0;
+    for (auto it = compact.begin(); it != compact.end(); ++it, ++i) {
+        SimTK_TEST(it.getIndex() == i);
+        SimTK_TEST(it->getTime() == states[i].getTime());
+        SimTK_TEST(compact.getTime(i) == states[i].getTime());
+        SimTK_TEST_EQ(it->getY(), states[i].getY());
+        model.realizePosition(*it);
+        SimTK_TEST_EQ(model.calcMassCenterPosition(*it),
+                model.calcMassCenterPosition(states[i]));
+    }
+    SimTK_TEST(i == states.getSize());
+    SimTK_TEST_EQ(compact.getState(1).getY(), states[1].getY());
+    SimTK_TEST_MUST_THROW_EXC(compact.getState(compact.getSize()),
+            IndexOutOfRange);
+
+    // Expanding into a StatesTrajectory and exporting to a table.
+    const auto expanded = compact.toStatesTrajectory();
+    SimTK_TEST(expanded.getSize() == states.getSize());
+    SimTK_TEST(expanded.hasIntegrity());
+    tableAndTrajectoryMatch(model, compact.exportToTable(model), states);
+
+    // Discrete variables are stored if a model is provided.
+    {
+        SimTK::State state = model.getWorkingState();
+        const auto& actu = model.getMuscles().get(0);
+        actu.overrideActuation(state, true);
+        model.getMultibodySystem().realizeModel(state);
+        CompactStatesTrajectory withDiscrete(model);
+        CompactStatesTrajectory withoutDiscrete;
+        for (int itime = 0; itime < 3; ++itime) {
+            state.setTime(0.1 * itime);
+            actu.setOverrideActuation(state, 10.0 * itime);
+            withDiscrete.append(state);
+            withoutDiscrete.append(state);
+        }
+        int itime = 0;
+        for (const auto& s : withDiscrete) {
+            SimTK_TEST(actu.getOverrideActuation(s) == 10.0 * itime);
+            ++itime;
+        }
+        SimTK_TEST(actu.getOverrideActuation(withoutDiscrete.getState(2)) ==
+                   0.0);
+
+        // Appending checks times and consistency.
+        state.setTime(0.1);
+        SimTK_TEST_MUST_THROW_EXC(withDiscrete.append(state),
+                SimTK::Exception::APIArgcheckFailed);
+        Model arm26("arm26.osim");
+        SimTK::State armState = arm26.initSystem();
+        armState.setTime(1.0);
+        SimTK_TEST_MUST_THROW_EXC(withDiscrete.append(armState),
+                StatesTrajectory::InconsistentState);
+        SimTK_TEST_MUST_THROW_EXC(withDiscrete.copyToState(0, armState),
+                OpenSim::Exception);
+
+        withDiscrete.clear();
+        SimTK_TEST(withDiscrete.getSize() == 0);
+        SimTK_TEST(withDiscrete.begin() == withDiscrete.end());
+    }
+}
+
+void testCompactStatesTrajectoryFromStatesTable() {
+    Model gait("gait2354_simbody.osim");
+    gait.initSystem();
+    TimeSeriesTable table(statesStoFname);
+    const auto states = StatesTrajectory::createFromStatesTable(gait, table);
+    const auto compact =
+            CompactStatesTrajectory::createFromStatesTable(gait, table);
+    SimTK_TEST(compact.getSize() == states.getSize());
+    tableAndTrajectoryMatch(gait, compact.exportToTable(gait), states);
+
+    SimTK::State state = gait.getWorkingState();
+    for (size_t itime = 0; itime < compact.getSize(); ++itime) {
+        compact.copyToState(itime, state);
+        SimTK_TEST(state.getTime() == states[itime].getTime());
+        SimTK_TEST_EQ(state.getY(), states[itime].getY());
+    }
+}
+
 int main() {
     SimTK_START_TEST("testStatesTrajectory");
         // actuators library is not loaded automatically (unless using clang).
@@ -782,6 +951,7 @@ int main() {
         remove(statesStoFname.c_str());
 
         SimTK_SUBTEST(testPopulateTrajectoryAndStatesTrajectoryReporter);
+        SimTK_SUBTEST(testStatesTrajectoryReporterOutputFile);
         SimTK_SUBTEST(testFrontBack);
         SimTK_SUBTEST(testBoundsCheck);
         SimTK_SUBTEST(testIntegrityChecks);
@@ -803,5 +973,8 @@ int main() {
         // Export to data table.
         SimTK_SUBTEST(testExport);
 
+        SimTK_SUBTEST(testCompactStatesTrajectory);
+        SimTK_SUBTEST(testCompactStatesTrajectoryFromStatesTable);
+
     SimTK_END_TEST();
 }
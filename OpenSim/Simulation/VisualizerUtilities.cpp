@@ -423,7 +423,7 @@ void VisualizerUtilities::showOrientationData(
     world.realizePosition(state);
     world.getVisualizer().show(state);
     auto& simbodyVisualizer = world.getVisualizer().getSimbodyVisualizer();
-    auto& dataMatrix = quatTable.getMatrix();
+    const auto& dataMatrix = quatTable.getMatrix();
     auto applyFrame = [&](int frameI) {
         state.setTime(times[frameI]);
         for (int iOrient = 0; iOrient < (int)numOrientations; ++iOrient) {
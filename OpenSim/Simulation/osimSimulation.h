@@ -123,6 +123,7 @@
 #include "Reference.h"
 #include "Solver.h"
 #include "StatesTrajectory.h"
+#include "CompactStatesTrajectory.h"
 #include "StatesTrajectoryReporter.h"
 #include "TableProcessor.h"
 #include "PositionMotion.h"
@@ -34,6 +34,7 @@
 #include <OpenSim/Analyses/ProbeReporter.h>
 #include <OpenSim/Simulation/Model/PrescribedForce.h>
 #include <OpenSim/Actuators/Thelen2003Muscle.h>
+#include <OpenSim/Actuators/MuscleEquilibriumSolver.h>
 
 using namespace OpenSim;
 using namespace std;
@@ -663,6 +664,10 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
     // model defaults.
     SimTK::Vector stateValues = aModel.getStateVariableValues(s);
 
+    // Consecutive frames are similar, so the muscle equilibrium solved for one
+    // frame is a good initial guess for the next.
+    MuscleEquilibriumSolver equilibriumSolver(aModel);
+
     for(int i=iInitial;i<=iFinal;i++) {
         // tPrev = t;
         aStatesStore.getTime(i,s.updTime()); // time
@@ -687,7 +692,7 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
                 // a non-physical pose. For example, a pose where the 
                 // muscle length is shorter than the tendon slack-length.
                 // the muscle will throw an Exception in this case.
-                aModel.equilibrateMuscles(s);
+                equilibriumSolver.solve(s);
             }
             catch (const std::exception& e) {
                 log_warn("AnalyzeTool::run() unable to equilibrate muscles at "
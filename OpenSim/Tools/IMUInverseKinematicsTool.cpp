@@ -178,12 +178,14 @@ void IMUInverseKinematicsTool::runInverseKinematicsWithOrientationsFromFile(
     int nos = ikSolver.getNumOrientationSensorsInUse();
     SimTK::Array_<double> orientationErrors(nos, 0.0);
 
+    ikReporter->reserve(times.size());
     if (get_report_errors()) { 
         SimTK::Array_<string> labels;
         for (int i = 0; i < nos; ++i) {
             labels.push_back(ikSolver.getOrientationSensorNameForIndex(i));
         }
         modelOrientationErrors->setColumnLabels(labels);
+        modelOrientationErrors->reserve(times.size());
         modelOrientationErrors->updTableMetaData().setValueForKey<string>(
                 "name", "OrientationErrors");
         ikSolver.computeCurrentOrientationErrors(orientationErrors);
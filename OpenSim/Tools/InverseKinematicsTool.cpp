@@ -34,6 +34,7 @@
 #include <OpenSim/Common/FunctionSet.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Common/Stopwatch.h>
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Common/XMLDocument.h>
@@ -44,6 +45,24 @@ using namespace OpenSim;
 using namespace std;
 using namespace SimTK;
 
+namespace {
+// Number of rows kept on either side of the time range when reading the
+// coordinate and marker files, so that the splines fit to the coordinates and
+// the marker frames nearest the start and final times match those obtained
+// from the entire file.
+const size_t numPaddingRows = 30;
+
+// Read the rows of a .sto/.mot file needed for the time range in blocks,
+// rather than loading the entire file.
+template <typename T>
+TimeSeriesTable_<T> readTimeRange(const std::string& fileName,
+        double startTime, double endTime) {
+    STOFileAdapter_<T> adapter;
+    typename STOFileAdapter_<T>::BlockReader reader(adapter, fileName);
+    return reader.readTimeRange(startTime, endTime, numPaddingRows);
+}
+} // namespace
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -408,11 +427,33 @@ void InverseKinematicsTool::populateReferences(MarkersReference& markersReferenc
     // Load the coordinate data
     // bool haveCoordinateFile = false;
     if (get_coordinate_file() != "" && get_coordinate_file() != "Unassigned") {
-        Storage coordinateValues(get_coordinate_file());
-        // Convert degrees to radian (TODO: this needs to have a check that the storage is, in fact, in degrees!)
-        _model->getSimbodyEngine().convertDegreesToRadians(coordinateValues);
-        // haveCoordinateFile = true;
-        coordFunctions = new GCVSplineSet(5, &coordinateValues);
+        const auto coordFileExt =
+                FileAdapter::findExtension(get_coordinate_file());
+        if (coordFileExt == "sto" || coordFileExt == "mot") {
+            TimeSeriesTable coordinateValues = readTimeRange<double>(
+                    get_coordinate_file(), get_time_range(0),
+                    get_time_range(1));
+            OPENSIM_THROW_IF_FRMOBJ(coordinateValues.getNumRows() == 0,
+                    Exception,
+                    "Coordinate file '{}' has no data within the time range "
+                    "[{}, {}].",
+                    get_coordinate_file(), get_time_range(0),
+                    get_time_range(1));
+            // As for the Storage below, the coordinates are assumed to be in
+            // degrees.
+            if (coordinateValues.hasTableMetaDataKey("inDegrees"))
+                coordinateValues.removeTableMetaDataKey("inDegrees");
+            coordinateValues.addTableMetaData("inDegrees", std::string("yes"));
+            _model->getSimbodyEngine().convertDegreesToRadians(
+                    coordinateValues);
+            coordFunctions = new GCVSplineSet(coordinateValues);
+        } else {
+            Storage coordinateValues(get_coordinate_file());
+            // Convert degrees to radian (TODO: this needs to have a check that the storage is, in fact, in degrees!)
+            _model->getSimbodyEngine().convertDegreesToRadians(coordinateValues);
+            // haveCoordinateFile = true;
+            coordFunctions = new GCVSplineSet(5, &coordinateValues);
+        }
     }
 
     Set<MarkerWeight> markerWeights;
@@ -460,8 +501,22 @@ void InverseKinematicsTool::populateReferences(MarkersReference& markersReferenc
 
     //Read in the marker data file and set the weights for associated markers.
     //Markers in the model and the marker file but not in the markerWeights are
-    //ignored
-    markersReference.initializeFromMarkersFile(get_marker_file(), markerWeights);
+    //ignored. TRC files cannot be read in blocks, so they are read in full.
+    if (FileAdapter::findExtension(get_marker_file()) == "sto") {
+        TimeSeriesTableVec3 markerTable;
+        try {
+            markerTable = readTimeRange<double>(get_marker_file(),
+                    get_time_range(0), get_time_range(1)).pack<SimTK::Vec3>();
+        } catch (const DataTypeMismatch&) {
+            markerTable = readTimeRange<SimTK::Vec3>(get_marker_file(),
+                    get_time_range(0), get_time_range(1));
+        }
+        markersReference = MarkersReference(markerTable, markerWeights);
+        markersReference.set_marker_file(get_marker_file());
+    } else {
+        markersReference.initializeFromMarkersFile(
+                get_marker_file(), markerWeights);
+    }
 }
 
 
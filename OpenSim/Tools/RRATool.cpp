@@ -809,7 +809,7 @@ bool RRATool::run()
 
     // Set output file names so that files are flushed regularly in case we fail
     IO::makeDir(getResultsDir());   // Create directory for output in case it doesn't exist
-    manager.getStateStorage().setOutputFileName(getResultsDir() + "/" + getName() + "_states.sto");
+    manager.getStateStorage().setOutputFileName(getResultsDir() + "/" + getName() + "_states.sto", false, 1);
     try {
         manager.initialize(s);
         manager.integrate(finalTime);